@@ -0,0 +1,109 @@
+/**
+ * @file simd_kernel_benchmark.cpp
+ * @brief XML 扫描 SIMD 内核基准测试：分别以标量、SSE2、AVX2 运行并输出 GB/s
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/core/performance_optimizations.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace tinakit::core;
+
+namespace {
+
+/**
+ * @brief 构造与真实工作表相近的 XML：数字、内联字符串和少量中文
+ */
+std::string make_sheet_xml(std::size_t target_size) {
+    std::string xml = "<sheetData>";
+    xml.reserve(target_size + 256);
+    std::size_t row = 1;
+    while (xml.size() < target_size) {
+        const std::string r = std::to_string(row);
+        xml += "<row r=\"" + r + "\">";
+        xml += "<c r=\"A" + r + "\"><v>" + r + "</v></c>";
+        xml += "<c r=\"B" + r + "\" t=\"inlineStr\"><is><t>Customer name " + r + "</t></is></c>";
+        xml += "<c r=\"C" + r + "\" s=\"2\"><v>" + std::to_string(row * 0.25) + "</v></c>";
+        xml += "<c r=\"D" + r + "\" t=\"inlineStr\"><is><t>\xE5\x8C\x97\xE4\xBA\xAC</t></is></c>";
+        xml += "</row>";
+        ++row;
+    }
+    xml += "</sheetData>";
+    return xml;
+}
+
+template <typename Fn>
+double measure_gbps(std::size_t bytes, int iterations, Fn&& fn) {
+    // 预热一次，避免首轮缺页影响结果
+    fn();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(bytes) * iterations / elapsed.count() / 1e9;
+}
+
+// 防止编译器优化掉结果
+volatile std::size_t g_sink = 0;
+
+} // namespace
+
+int main() {
+    constexpr std::size_t kSize = 64 * 1024 * 1024;
+    constexpr int kIterations = 10;
+    const std::string xml = make_sheet_xml(kSize);
+    const std::string_view view(xml);
+
+    std::cout << "=== TinaKit SIMD 内核基准测试 ===" << std::endl;
+    std::cout << "数据大小: " << xml.size() / (1024 * 1024) << " MiB, 检测到的级别: "
+              << simd::level_name(simd::detected_level()) << "\n" << std::endl;
+
+    std::cout << std::left << std::setw(10) << "级别"
+              << std::right << std::setw(16) << "find '<'"
+              << std::setw(16) << "find <>&\""
+              << std::setw(16) << "find '&'"
+              << std::setw(16) << "UTF-8" << "   (GB/s)" << std::endl;
+
+    for (auto level : {simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2}) {
+        if (simd::set_level(level) != level) {
+            continue;
+        }
+
+        // 逐个标签定位：模拟扫描器的真实访问模式
+        const double tags = measure_gbps(xml.size(), kIterations, [&] {
+            std::size_t count = 0;
+            for (std::size_t pos = simd::find_any(view, "<"); pos != std::string_view::npos;
+                 pos = simd::find_any(view, "<", pos + 1)) {
+                ++count;
+            }
+            g_sink = count;
+        });
+        const double specials = measure_gbps(xml.size(), kIterations, [&] {
+            std::size_t count = 0;
+            for (std::size_t pos = simd::find_any(view, "<>&\""); pos != std::string_view::npos;
+                 pos = simd::find_any(view, "<>&\"", pos + 1)) {
+                ++count;
+            }
+            g_sink = count;
+        });
+        // 几乎不出现的字符：衡量纯吞吐
+        const double sparse = measure_gbps(xml.size(), kIterations, [&] {
+            g_sink = simd::find_any(view, "&");
+        });
+        const double utf8 = measure_gbps(xml.size(), kIterations, [&] {
+            g_sink = simd::find_invalid_utf8(view);
+        });
+
+        std::cout << std::left << std::setw(10) << simd::level_name(level) << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(16) << tags << std::setw(16) << specials
+                  << std::setw(16) << sparse << std::setw(16) << utf8 << std::endl;
+    }
+
+    simd::set_level(simd::detected_level());
+    return 0;
+}
@@ -245,7 +245,7 @@ namespace detail {
     };
 
 
-    auto schedule_on(Executor& executor) noexcept
+    inline auto schedule_on(Executor& executor) noexcept
     {
         struct Awaiter
         {
@@ -738,14 +738,188 @@ namespace detail {
         template <typename T>
         using task_value_t = typename task_value_type<T>::type;
 
-        template <typename Tuple, std::size_t... Is>
-        auto when_all_impl(Tuple&& tasks, std::index_sequence<Is...>) ->
-            Task<std::tuple<task_result_t<task_value_t<std::decay_t<decltype(std::get<Is>(tasks))>>>...>>
+        /**
+         * @brief 在 final_suspend 中发出完成通知的内部协程。
+         *
+         * 通知发出时协程帧已经挂起，等待方被唤醒后可以立即销毁它，
+         * 即使协程在另一个线程上结束也不会出现帧仍在执行时被销毁的竞争。
+         */
+        class CompletionTask
+        {
+        public:
+            using Notify = std::coroutine_handle<> (*)(void* context) noexcept;
+
+            struct promise_type
+            {
+                Notify notify_ = nullptr;
+                void* context_ = nullptr;
+
+                CompletionTask get_return_object() noexcept
+                {
+                    return CompletionTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+
+                auto final_suspend() const noexcept
+                {
+                    struct Awaiter
+                    {
+                        bool await_ready() const noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+                        {
+                            auto& promise = h.promise();
+                            return promise.notify_(promise.context_);
+                        }
+
+                        void await_resume() const noexcept
+                        {
+                        }
+                    };
+                    return Awaiter{};
+                }
+
+                void return_void() noexcept
+                {
+                }
+
+                // 协程体自行捕获所有异常
+                void unhandled_exception() noexcept { std::terminate(); }
+            };
+
+            CompletionTask(CompletionTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr))
+            {
+            }
+
+            CompletionTask(const CompletionTask&) = delete;
+            CompletionTask& operator=(const CompletionTask&) = delete;
+            CompletionTask& operator=(CompletionTask&&) = delete;
+
+            ~CompletionTask()
+            {
+                if (handle_) handle_.destroy();
+            }
+
+            void start(Notify notify, void* context) noexcept
+            {
+                handle_.promise().notify_ = notify;
+                handle_.promise().context_ = context;
+                handle_.resume();
+            }
+
+        private:
+            explicit CompletionTask(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle)
+            {
+            }
+
+            std::coroutine_handle<promise_type> handle_;
+        };
+
+        /**
+         * @brief when_all 的完成计数器：所有子任务和等待方都到达后唤醒等待方。
+         */
+        class WhenAllCounter
+        {
+        public:
+            explicit WhenAllCounter(std::size_t count) noexcept : remaining_(count + 1)
+            {
+            }
+
+            // 返回 false 表示子任务已全部完成，无需挂起
+            bool try_await(std::coroutine_handle<> awaiting) noexcept
+            {
+                awaiting_ = awaiting;
+                return remaining_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+            }
+
+            static std::coroutine_handle<> notify(void* context) noexcept
+            {
+                auto* self = static_cast<WhenAllCounter*>(context);
+                if (self->remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    return self->awaiting_;
+                }
+                return std::noop_coroutine();
+            }
+
+            auto operator co_await() noexcept
+            {
+                struct Awaiter
+                {
+                    WhenAllCounter& counter_;
+                    bool await_ready() const noexcept { return false; }
+
+                    bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+                    {
+                        return counter_.try_await(awaiting);
+                    }
+
+                    void await_resume() const noexcept
+                    {
+                    }
+                };
+                return Awaiter{*this};
+            }
+
+        private:
+            std::atomic<std::size_t> remaining_;
+            std::coroutine_handle<> awaiting_ = nullptr;
+        };
+
+        template <typename T>
+        CompletionTask make_when_all_child(Task<T>& task, std::optional<task_result_t<T>>& result,
+                                           std::exception_ptr& error)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await task;
+                    result.emplace();
+                }
+                else
+                {
+                    result.emplace(co_await task);
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+
+        template <typename... Ts, std::size_t... Is>
+        Task<std::tuple<task_result_t<Ts>...>> when_all_impl(std::tuple<Task<Ts>...> tasks, std::index_sequence<Is...>)
         {
-            co_return std::make_tuple((co_await std::get<Is>(std::forward<Tuple>(tasks)))...);
+            std::tuple<std::optional<task_result_t<Ts>>...> results;
+            std::exception_ptr errors[sizeof...(Ts)];
+            WhenAllCounter counter(sizeof...(Ts));
+
+            CompletionTask children[] = {
+                make_when_all_child(std::get<Is>(tasks), std::get<Is>(results), errors[Is])...
+            };
+            for (auto& child : children)
+            {
+                child.start(&WhenAllCounter::notify, &counter);
+            }
+            co_await counter;
+
+            // 所有子任务都结束后，按参数顺序报告第一个异常
+            for (auto& error : errors)
+            {
+                if (error) std::rethrow_exception(error);
+            }
+            co_return std::tuple<task_result_t<Ts>...>(std::move(*std::get<Is>(results))...);
         }
     }
 
+    /**
+     * @brief 并发等待多个任务。
+     *
+     * 所有任务同时启动：任务内部通过 schedule_on() 切换到线程池时，它们会并行执行。
+     * 等待全部结束后按参数顺序返回结果；若有任务抛出异常，重新抛出参数顺序中的第一个。
+     */
     template <typename... Tasks>
     auto when_all(Tasks&&... tasks)
     {
@@ -755,12 +929,57 @@ namespace detail {
         );
     }
 
+    /**
+     * @brief 并发等待一组同类型任务，结果按输入顺序排列。
+     */
+    template <typename T>
+    Task<std::vector<detail::task_result_t<T>>> when_all(std::vector<Task<T>> tasks)
+    {
+        std::vector<std::optional<detail::task_result_t<T>>> results(tasks.size());
+        std::vector<std::exception_ptr> errors(tasks.size());
+        detail::WhenAllCounter counter(tasks.size());
+
+        std::vector<detail::CompletionTask> children;
+        children.reserve(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+        {
+            children.push_back(detail::make_when_all_child(tasks[i], results[i], errors[i]));
+        }
+        for (auto& child : children)
+        {
+            child.start(&detail::WhenAllCounter::notify, &counter);
+        }
+        co_await counter;
+
+        for (auto& error : errors)
+        {
+            if (error) std::rethrow_exception(error);
+        }
+        std::vector<detail::task_result_t<T>> values;
+        values.reserve(results.size());
+        for (auto& result : results)
+        {
+            values.push_back(std::move(*result));
+        }
+        co_return values;
+    }
+
+    namespace detail
+    {
+        inline std::coroutine_handle<> release_semaphore(void* context) noexcept
+        {
+            static_cast<std::binary_semaphore*>(context)->release();
+            return std::noop_coroutine();
+        }
+    }
+
     // sync_wait 的 void 特化版本
     inline void sync_wait(Task<void>&& task)
     {
         std::binary_semaphore sem{0};
+        std::exception_ptr error;
 
-        auto final_task_runner = [](Task<void> t, auto& s) -> Task<void>
+        auto runner = [](Task<void> t, std::exception_ptr& e) -> detail::CompletionTask
         {
             try
             {
@@ -768,21 +987,15 @@ namespace detail {
             }
             catch (...)
             {
-                s.release();
-                throw;
+                e = std::current_exception();
             }
-            s.release();
-        };
+        }(std::move(task), error);
 
-        // 从Task中提取协程句柄，但保持Task的生命周期
-        auto task_with_signal = final_task_runner(std::move(task), sem);
-        auto awaiter = task_with_signal.operator co_await();
-        auto handle = awaiter.await_suspend(std::noop_coroutine());
-
-        handle.resume();
+        // 任务可能在其他线程结束，信号在协程帧挂起后才发出
+        runner.start(&detail::release_semaphore, &sem);
         sem.acquire();
 
-        awaiter.await_resume();
+        if (error) std::rethrow_exception(error);
     }
 
     // sync_wait 的非 void 版本
@@ -792,31 +1005,25 @@ namespace detail {
         static_assert(!std::is_void_v<T>, "Use sync_wait(Task<void>&&) for void tasks");
 
         std::binary_semaphore sem{0};
+        std::optional<T> result;
+        std::exception_ptr error;
 
-        auto final_task_runner = [](Task<T> t, auto& s) -> Task<std::optional<T>>
+        auto runner = [](Task<T> t, std::optional<T>& r, std::exception_ptr& e) -> detail::CompletionTask
         {
-            std::optional<T> result;
             try
             {
-                result = co_await std::move(t);
+                r.emplace(co_await std::move(t));
             }
             catch (...)
             {
-                s.release();
-                throw;
+                e = std::current_exception();
             }
-            s.release();
-            co_return result;
-        };
-
-        // 从Task中提取协程句柄，但保持Task的生命周期
-        auto task_with_signal = final_task_runner(std::move(task), sem);
-        auto awaiter = task_with_signal.operator co_await();
-        auto handle = awaiter.await_suspend(std::noop_coroutine());
+        }(std::move(task), result, error);
 
-        handle.resume();
+        runner.start(&detail::release_semaphore, &sem);
         sem.acquire();
 
-        return *awaiter.await_resume();
+        if (error) std::rethrow_exception(error);
+        return std::move(*result);
     }
 } // namespace tinakit::async
@@ -13,6 +13,7 @@
 #include <memory>
 #include <atomic>
 #include <shared_mutex>
+#include <mutex>
 #include <string>
 #include <variant>
 #include <chrono>
@@ -5,13 +5,130 @@
 #pragma once
 
 #include "tinakit/core/async.hpp"
+#include "tinakit/core/io_backend.hpp"
+#include "tinakit/core/write_profile.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cstddef>
+#include <memory>
+#include <span>
 
 namespace tinakit::core
 {
-    async::Task<void> write_file_binary(const std::string& path, const std::vector<std::byte>& data);
+    /**
+     * @brief 通过 IoBackend 异步写入整个文件（按块同时提交），等待期间不占用调用线程
+     * @throws IOException 文件无法创建或写入
+     */
+    async::Task<void> write_file_binary(const std::string& path, std::span<const std::byte> data);
 
+    /**
+     * @brief 通过 IoBackend 异步读取整个文件，完成后在 I/O 执行器上恢复
+     * @throws IOException 文件无法打开或读取
+     */
     async::Task<std::vector<std::byte>> read_file_binary(const std::string& path);
+
+    /**
+     * @brief 只读的源数据：内存中的字节缓冲区，或文件的只读内存映射
+     *
+     * 映射模式下文件内容只有在被访问时才由操作系统调入，未读取的条目不占用常驻内存。
+     * 以 shared_ptr 共享，最后一个持有者释放时解除映射。
+     */
+    class SourceBuffer
+    {
+    public:
+        /**
+         * @brief 持有内存中的字节
+         */
+        static std::shared_ptr<const SourceBuffer> from_bytes(std::vector<std::byte> bytes);
+
+        /**
+         * @brief 以只读方式映射整个文件
+         * @throws IOException 文件无法打开或映射
+         */
+        static std::shared_ptr<const SourceBuffer> map_file(const std::string& path);
+
+        ~SourceBuffer();
+
+        SourceBuffer(const SourceBuffer&) = delete;
+        SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+        [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+
+        /**
+         * @brief 是否为文件映射
+         */
+        [[nodiscard]] bool mapped() const noexcept { return mapping_ != nullptr; }
+
+    private:
+        SourceBuffer() = default;
+
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::vector<std::byte> owned_;
+        void* mapping_ = nullptr;   // 映射基址（Windows 上为视图地址）
+    };
+
+    /**
+     * @brief 可随机写入的输出文件，内容先写入同目录的临时文件，commit() 时替换目标文件
+     *
+     * 顺序写入合并为 1 MiB 的块后通过 IoBackend 在后台写出，调用方（通常是压缩）不等待磁盘；
+     * 回填已写出的区域前会等待在途写入完成。未提交就析构时删除临时文件，目标文件保持不变。
+     */
+    class OutputFile
+    {
+    public:
+        /**
+         * @brief 创建临时文件，policy.preallocate 非零时预先分配空间
+         * @throws IOException 临时文件无法创建
+         */
+        OutputFile(const std::string& path, const FileWritePolicy& policy = {});
+        ~OutputFile();
+
+        OutputFile(const OutputFile&) = delete;
+        OutputFile& operator=(const OutputFile&) = delete;
+
+        /**
+         * @brief 在当前位置写入并前移
+         * @throws IOException 之前在后台提交的写入失败
+         */
+        void write(std::span<const std::byte> data);
+
+        /**
+         * @brief 移动写入位置，可以超过已写入的末尾
+         */
+        void seek(std::uint64_t position) noexcept { position_ = position; }
+
+        [[nodiscard]] std::uint64_t position() const noexcept { return position_; }
+
+        /**
+         * @brief 已写入内容的末尾
+         */
+        [[nodiscard]] std::uint64_t size() const noexcept { return size_; }
+
+        [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+        /**
+         * @brief 截去预分配而未使用的空间，按策略刷新到磁盘，然后替换目标文件
+         * @throws IOException 刷新或替换失败（此时临时文件已删除）
+         */
+        void commit();
+
+    private:
+        struct WriteBehind;
+
+        void flush_staging();
+        void close() noexcept;
+
+        std::string path_;
+        std::string temp_path_;
+        FileWritePolicy policy_;
+        NativeFile file_;
+        bool open_ = true;
+        std::uint64_t position_ = 0;
+        std::uint64_t size_ = 0;
+        std::unique_ptr<WriteBehind> write_behind_;
+    };
 }
@@ -0,0 +1,128 @@
+/**
+ * @file io_backend.hpp
+ * @brief 异步文件 I/O 后端：Linux 上使用 io_uring，其他情况回退到专用的阻塞 I/O 线程
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/async.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tinakit::core
+{
+#ifdef _WIN32
+    using NativeFile = void*;   ///< Windows 文件句柄（HANDLE）
+#else
+    using NativeFile = int;     ///< POSIX 文件描述符
+#endif
+
+    /**
+     * @brief I/O 后端的实现方式
+     */
+    enum class IoBackendKind
+    {
+        ThreadPool, ///< 在专用线程上执行阻塞的定位读写（pread/pwrite 或带偏移的 ReadFile/WriteFile）
+        IoUring     ///< 提交到 io_uring，由完成线程收割结果，不占用阻塞线程
+    };
+
+    /**
+     * @brief 一次定位读写请求
+     *
+     * 请求在完成前必须保持有效；on_complete 在 I/O 线程上调用，不能阻塞。
+     */
+    struct IoRequest
+    {
+        NativeFile file{};
+        std::byte* data = nullptr;
+        std::size_t size = 0;
+        std::uint64_t offset = 0;
+        bool write = false;
+        std::int64_t result = 0;    ///< 传输的字节数，失败时为负的错误码
+        void (*on_complete)(IoRequest& request) noexcept = nullptr;
+        void* context = nullptr;
+    };
+
+    /**
+     * @brief 异步文件读写的提交端
+     *
+     * 通过 submit_io() 等待的协程在 executor() 上恢复；调用方之后若要执行大量计算，
+     * 应当再 schedule_on 到自己的执行器。
+     */
+    class IoBackend
+    {
+    public:
+        virtual ~IoBackend() = default;
+
+        IoBackend(const IoBackend&) = delete;
+        IoBackend& operator=(const IoBackend&) = delete;
+
+        /**
+         * @brief 进程共享的后端，首次使用时创建
+         *
+         * 编译时定义了 TINAKIT_HAS_IO_URING 且内核允许创建 io_uring 时使用 IoUring，否则使用 ThreadPool。
+         */
+        static IoBackend& instance();
+
+        /**
+         * @brief 创建指定类型的后端；IoUring 不可用时抛出 IOException
+         */
+        static std::unique_ptr<IoBackend> create(IoBackendKind kind);
+
+        [[nodiscard]] virtual IoBackendKind kind() const noexcept = 0;
+
+        /**
+         * @brief 提交请求，完成后调用 request.on_complete
+         */
+        virtual void submit(IoRequest& request) = 0;
+
+        /**
+         * @brief 恢复 I/O 完成后的协程的执行器
+         */
+        [[nodiscard]] async::Executor& executor() noexcept { return executor_; }
+
+    protected:
+        explicit IoBackend(std::size_t threads) : executor_(threads) {}
+
+    private:
+        async::ThreadPoolExecutor executor_;
+    };
+
+    /**
+     * @brief 提交请求并挂起当前协程，完成后在 backend.executor() 上恢复，返回 IoRequest::result
+     */
+    inline auto submit_io(IoBackend& backend, IoRequest& request) noexcept
+    {
+        struct Awaiter
+        {
+            IoBackend& backend_;
+            IoRequest& request_;
+            std::coroutine_handle<> handle_{};
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                // 等待方挂起期间 Awaiter 位于协程帧中，完成回调可以通过 context 找到它
+                handle_ = handle;
+                request_.context = this;
+                request_.on_complete = [](IoRequest& completed) noexcept
+                {
+                    auto* self = static_cast<Awaiter*>(completed.context);
+                    self->backend_.executor().execute(self->handle_);
+                };
+                backend_.submit(request_);
+            }
+
+            std::int64_t await_resume() const noexcept
+            {
+                return request_.result;
+            }
+        };
+        return Awaiter{backend, request};
+    }
+}
@@ -9,13 +9,20 @@
 #include <memory>
 #include <filesystem>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <set>
+#include <optional>
 #include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <istream>
 #include <ostream>
 
 #include "tinakit/core/async.hpp"
+#include "tinakit/core/parallel_deflate.hpp"
+#include "tinakit/core/write_profile.hpp"
 
 struct mz_zip_reader_s;
 struct mz_zip_writer_s;
@@ -24,6 +31,68 @@ struct mz_stream_s;
 
 namespace tinakit::core
 {
+    class SourceBuffer;
+    class OutputFile;
+
+    /**
+     * @brief open_from_file() 读取源文件的方式
+     */
+    enum class SourceMode
+    {
+        MemoryMap,  ///< 只读映射文件，只有被读取的条目才会调入内存
+        Read        ///< 把整个文件读入内存
+    };
+
+    /**
+     * @brief 源归档中一个条目的目录信息
+     */
+    struct ArchiveEntry
+    {
+        std::int64_t directory_offset = 0;      ///< 条目在中央目录中的位置，用于直接定位
+        std::int64_t header_offset = 0;         ///< 本地文件头在归档中的偏移
+        std::uint64_t compressed_size = 0;
+        std::uint64_t uncompressed_size = 0;
+        std::uint32_t crc = 0;                  ///< 未压缩数据的 CRC-32
+        std::uint16_t compression_method = 0;   ///< 0 为存储，8 为 deflate
+    };
+
+    /// 条目名称到目录信息的索引
+    using ArchiveEntryIndex = std::unordered_map<std::string, ArchiveEntry>;
+
+    /**
+     * @brief 拉取式的条目解压读取器
+     *
+     * 每次 next_chunk() 只解压一块（大小在打开时指定），内存占用与条目大小无关。
+     * 读取器持有独立的 zip 句柄和源缓冲区的共享所有权，可以在其他线程上使用，
+     * 归档器保存或销毁后仍然有效。
+     */
+    class EntryReader
+    {
+    public:
+        EntryReader(EntryReader&&) noexcept;
+        EntryReader& operator=(EntryReader&&) noexcept;
+        ~EntryReader();
+
+        /**
+         * @brief 解压下一块内容
+         * @return 指向内部缓冲区的视图，下一次调用前有效；读完时返回空视图
+         * @throws TinaKitException 解压失败，或读完后 CRC 校验失败
+         */
+        std::string_view next_chunk();
+
+        /**
+         * @brief 条目的未压缩大小
+         */
+        [[nodiscard]] std::uint64_t size() const noexcept;
+
+    private:
+        friend class OpenXmlArchiver;
+        class Impl;
+        explicit EntryReader(std::unique_ptr<Impl> impl);
+
+        std::unique_ptr<Impl> impl_;
+    };
+
     /**
      * @brief Manages reading from and writing to OpenXML archives, encapsulating minizip-ng.
      *
@@ -53,13 +122,42 @@ namespace tinakit::core
         OpenXmlArchiver(OpenXmlArchiver&&) = default;
         OpenXmlArchiver& operator=(OpenXmlArchiver&&) = default;
 
-        static async::Task<OpenXmlArchiver> open_from_file(const std::string& path);
+        static async::Task<OpenXmlArchiver> open_from_file(const std::string& path,
+                                                           SourceMode mode = SourceMode::MemoryMap);
         static OpenXmlArchiver open_from_memory(std::vector<std::byte> buffer);
         static OpenXmlArchiver create_in_memory_writer();
 
+        /**
+         * @brief 创建直接写入文件的归档，条目写完即落盘，整个归档不会在内存中组装
+         *
+         * 内容先写入 path 旁的临时文件，save_to_file(path) 时替换目标文件。
+         */
+        static OpenXmlArchiver create_file_writer(const std::string& path, FileWritePolicy policy = {});
+
+        /**
+         * @brief 创建写入 stream 的归档，stream 必须支持 seekp/tellp（例如 std::ofstream）
+         *
+         * 调用 finish() 写入中央目录，stream 在此之前必须保持有效。
+         */
+        static OpenXmlArchiver create_stream_writer(std::ostream& stream);
+
         [[nodiscard]] async::Task<std::vector<std::string>> list_files() const;
         [[nodiscard]] async::Task<bool> has_file(const std::string& filename) const;
         
+        /**
+         * @brief 源归档的条目索引
+         *
+         * 打开归档时扫描一次中央目录构建，之后的查找和读取都直接按索引定位。
+         * 只描述源归档中的条目，不包含尚未保存的添加和删除。
+         */
+        [[nodiscard]] const ArchiveEntryIndex& entry_index() const noexcept { return entry_index_; }
+
+        /**
+         * @brief 查找源归档中的条目，可用于按大小预先分配缓冲区
+         * @return 条目不存在或已被删除时返回 nullptr
+         */
+        [[nodiscard]] const ArchiveEntry* find_entry(const std::string& filename) const;
+
         [[nodiscard]] async::Task<std::vector<std::byte>> read_file(const std::string& filename);
         async::Task<void> add_file(const std::string& filename, std::vector<std::byte> content);
         [[nodiscard]] async::Task<void> remove_file(const std::string& filename);
@@ -68,8 +166,88 @@ namespace tinakit::core
         async::Task<void> add_file_stream(const std::string& filename, std::istream& stream, size_t estimated_size = 0);
         async::Task<void> read_file_stream(const std::string& filename, std::ostream& stream);
 
+        /**
+         * @brief 以拉取方式打开条目的解压输入流
+         *
+         * 返回的流每次只解压一个缓冲块，内存占用与条目大小无关。流持有独立的读取器
+         * 和源缓冲区的共享所有权，因此可以与本归档器的其他读取操作交替进行，
+         * 归档器保存或销毁后仍然有效。
+         *
+         * @param filename 条目名称
+         * @param buffer_size 解压缓冲块大小（字节）
+         */
+        [[nodiscard]] async::Task<std::unique_ptr<std::istream>> open_entry_stream(
+            const std::string& filename, std::size_t buffer_size = 64 * 1024) const;
+
+        /**
+         * @brief 打开条目的拉取式读取器，由调用者逐块取出解压后的内容
+         *
+         * 与 open_entry_stream() 相同，但不经过 std::istream，适合直接处理连续内存块的扫描器。
+         *
+         * @param filename 条目名称
+         * @param chunk_size 每次 next_chunk() 最多返回的字节数
+         */
+        [[nodiscard]] async::Task<EntryReader> open_entry_reader(
+            const std::string& filename, std::size_t chunk_size = 64 * 1024) const;
+
+        /**
+         * @brief 直接在写入器中开始一个条目，之后的内容边写边压缩
+         *
+         * 同一时间只能有一个打开的条目；条目结束前不能保存归档。
+         * 已存在的同名条目会在保存时被跳过。
+         */
+        async::Task<void> begin_entry(const std::string& filename);
+
+        /**
+         * @brief 向 begin_entry() 打开的条目追加内容
+         */
+        async::Task<void> write_entry(std::span<const std::byte> data);
+
+        /**
+         * @brief 结束当前条目
+         */
+        async::Task<void> end_entry();
+
+        /**
+         * @brief 设置写入时的压缩线程数
+         *
+         * threads 大于 1 时，保存时的待写入条目和 begin_entry() 打开的条目都按 block_size
+         * 切分为独立压缩的块，在 threads 个线程上并行压缩后按顺序写入（流式条目每积累
+         * threads 个块压缩一次）。0 表示使用硬件并发数，1 恢复串行压缩。
+         * 只能在没有打开的条目时调用。
+         */
+        void set_deflate_threads(std::size_t threads, std::size_t block_size = DEFAULT_DEFLATE_BLOCK_SIZE);
+
+        /**
+         * @brief 设置新写入条目的压缩配置
+         *
+         * 对 add_file() 的条目在保存时生效，对 begin_entry() 的条目在打开时生效；
+         * 从原归档复制的条目保持原有压缩方式。
+         */
+        void set_write_profile(WriteProfile profile);
+
+        [[nodiscard]] const WriteProfile& write_profile() const noexcept { return write_profile_; }
+
+        /**
+         * @brief 让之后的写入直接落到 path，由 save_to_file(path) 完成替换
+         *
+         * 用于读取已有归档后再保存：原有条目和新条目在写出时直接写入文件，不在内存中组装整个归档。
+         * 已经有条目通过 begin_entry() 写入内存时无法切换，返回 false，保存仍在内存中完成。
+         */
+        bool set_output_file(const std::string& path, FileWritePolicy policy = {});
+
+        /**
+         * @brief 是否直接写入文件或流
+         */
+        [[nodiscard]] bool writes_through() const noexcept { return output_file_ || output_stream_; }
+
         async::Task<void> save_to_file(const std::string& path);
         async::Task<std::vector<std::byte>> save_to_memory();
+
+        /**
+         * @brief 完成 create_stream_writer() 创建的归档：写入剩余条目和中央目录并刷新流
+         */
+        async::Task<void> finish();
     
     private:
 
@@ -95,19 +273,82 @@ namespace tinakit::core
 
         // Private helper to manage state transitions
         async::Task<void> transition_to_writer_mode_if_needed();
+        void open_writer(const char* context);
+        async::Task<void> finish_writer(const char* context);
+        void open_source_reader(const char* context);
+        const ArchiveEntry& require_entry(const std::string& filename, const char* context) const;
+        async::Task<void> flush_raw_entry(bool final);
         void close_handles();
 
         unique_zip_reader_ptr reader_handle_;
+        // Stream over source_buffer_ read by reader_handle_; must outlive the reader
+        unique_stream_ptr reader_stream_;
         unique_zip_writer_ptr writer_handle_;
         
         // The memory stream handle is kept separately because it's needed after the writer is closed
         unique_stream_ptr memory_stream_handle_;
 
+        // Write-through target: the writer streams into output_file_ or output_stream_ through sink_stream_
+        std::optional<std::pair<std::string, FileWritePolicy>> output_target_;
+        std::shared_ptr<OutputFile> output_file_;
+        std::ostream* output_stream_ = nullptr;
+        unique_stream_ptr sink_stream_;
+
+        // Central directory of the source archive, built once when the reader is opened
+        ArchiveEntryIndex entry_index_;
+
         std::set<std::string> current_files_;
         std::set<std::string> files_to_remove_;
         std::map<std::string,std::vector<std::byte>> pending_new_files_;
 
-        // Buffer for archives opened from memory,to support read->write transitions
-        std::vector<std::byte> source_buffer_;
+        // Entries already compressed into the writer via begin_entry()
+        std::set<std::string> written_files_;
+        std::optional<std::string> open_entry_;
+
+        // Compression level per entry name
+        WriteProfile write_profile_;
+
+        // Parallel deflate: entries are compressed on deflate_pool_ and written raw
+        std::unique_ptr<async::ThreadPoolExecutor> deflate_pool_;
+        std::size_t deflate_threads_ = 1;
+        std::size_t deflate_block_size_ = DEFAULT_DEFLATE_BLOCK_SIZE;
+
+        // Uncompressed tail and running checksum of the raw entry opened by begin_entry()
+        std::vector<std::byte> raw_pending_;
+        DeflatedData raw_written_;
+        int raw_level_ = DEFAULT_DEFLATE_LEVEL;
+        bool raw_entry_ = false;
+
+        // Source bytes (in memory or memory-mapped), also read by the read->write transition.
+        // Shared so that entry streams can outlive a save that replaces it.
+        std::shared_ptr<const SourceBuffer> source_buffer_;
+    };
+
+    /**
+     * @brief 把写入内容按块压缩进归档条目的输出流
+     *
+     * 构造时调用 begin_entry()，缓冲区写满时调用 write_entry()，close() 时结束条目。
+     * 内存占用只有一个缓冲块，适合序列化很大的 XML 部件。
+     *
+     * @note 析构时若尚未 close() 会尝试结束条目并忽略错误，需要错误报告时请显式调用 close()
+     */
+    class EntryOutputStream : public std::ostream
+    {
+    public:
+        EntryOutputStream(OpenXmlArchiver& archiver, const std::string& filename,
+                          std::size_t buffer_size = 64 * 1024);
+        ~EntryOutputStream() override;
+
+        EntryOutputStream(const EntryOutputStream&) = delete;
+        EntryOutputStream& operator=(const EntryOutputStream&) = delete;
+
+        /**
+         * @brief 刷新剩余内容并结束条目
+         */
+        void close();
+
+    private:
+        class Buffer;
+        std::unique_ptr<Buffer> buffer_;
     };
 }
@@ -0,0 +1,57 @@
+/**
+ * @file parallel_deflate.hpp
+ * @brief 分块独立压缩的 deflate 编码器（pigz 风格），用于并行写入 zip 条目
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/async.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace tinakit::core
+{
+    /// 默认压缩级别（zlib 的 Z_DEFAULT_COMPRESSION）
+    inline constexpr int DEFAULT_DEFLATE_LEVEL = -1;
+
+    /// 并行压缩时每个独立块的默认大小
+    inline constexpr std::size_t DEFAULT_DEFLATE_BLOCK_SIZE = 1024 * 1024;
+
+    /**
+     * @brief 原始 deflate 数据（无 zlib/gzip 头）及 zip 条目需要的校验信息
+     */
+    struct DeflatedData
+    {
+        std::vector<std::byte> bytes;
+        std::uint32_t crc = 0;                  ///< 未压缩数据的 CRC-32
+        std::uint64_t uncompressed_size = 0;
+
+        /**
+         * @brief 把后续块拼接到末尾并合并 CRC
+         */
+        void append(const DeflatedData& block);
+    };
+
+    /**
+     * @brief 把 input 压缩为一个独立的原始 deflate 块
+     *
+     * final 为 false 时以全刷新结束而不写入结束标记，输出按字节对齐且不依赖之前的数据，
+     * 因此可以与后续块直接拼接成一个合法的 deflate 流。
+     */
+    DeflatedData deflate_block(std::span<const std::byte> input, int level, bool final);
+
+    /**
+     * @brief 把 input 切分为 block_size 大小的块，在 executor 上并行压缩后按顺序拼接
+     *
+     * 每个块没有前一块的字典，压缩率略低于整体压缩（块大小为 1 MiB 时通常不到 1%）。
+     * @param final 为 false 时最后一块也不写入结束标记，调用方之后还要继续拼接
+     */
+    async::Task<DeflatedData> deflate_parallel(async::Executor& executor, std::span<const std::byte> input,
+                                               int level = DEFAULT_DEFLATE_LEVEL,
+                                               std::size_t block_size = DEFAULT_DEFLATE_BLOCK_SIZE,
+                                               bool final = true);
+}
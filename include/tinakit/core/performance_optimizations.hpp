@@ -19,6 +19,10 @@
 #include <optional>
 #include <algorithm>
 #include <cstring>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
 
 namespace tinakit::core {
 
@@ -57,52 +61,58 @@ struct FastPositionHash {
 };
 
 /**
- * @brief 高性能字符串池，减少字符串复制
+ * @brief 可在线程间共享的字符串驻留池
+ *
+ * 按哈希值分为 SHARD_COUNT 个分片，每个分片有自己的锁、分配区和以 string_view 为键的索引：
+ * - 查找直接使用传入的视图，不构造临时 std::string
+ * - 不同线程驻留的字符串通常落在不同分片，不会都排在同一把锁上
+ * - 字符串数据保存在分片的分配区中，驻留后不再移动
+ *
+ * ID 的低 SHARD_BITS 位是分片号，其余位是分片内序号。ID 和 get_string() 返回的视图在 clear()
+ * 之前一直有效；get_string() 不加锁，可以与 intern() 并发。
  */
 class StringPool {
 public:
     using StringId = std::uint32_t;
     static constexpr StringId INVALID_ID = 0;
+    static constexpr std::size_t SHARD_BITS = 4;
+    static constexpr std::size_t SHARD_COUNT = std::size_t{1} << SHARD_BITS;
 
-    StringId intern(std::string_view str) {
-        if (str.empty()) return INVALID_ID;
+    StringPool();
+    ~StringPool();
 
-        // 先转换为string以避免string_view失效问题
-        std::string str_copy(str);
-        auto it = string_to_id_.find(str_copy);
-        if (it != string_to_id_.end()) {
-            return it->second;
-        }
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
 
-        StringId id = static_cast<StringId>(strings_.size() + 1);
-        strings_.emplace_back(std::move(str_copy));
-        // 使用存储在vector中的字符串作为key
-        string_to_id_[strings_.back()] = id;
-        return id;
-    }
+    /**
+     * @brief 驻留字符串，相同内容总是得到相同的 ID（空字符串返回 INVALID_ID）
+     */
+    StringId intern(std::string_view str);
 
-    std::string_view get_string(StringId id) const noexcept {
-        if (id == INVALID_ID || id > strings_.size()) {
-            return {};
-        }
-        return strings_[id - 1];
-    }
+    /**
+     * @brief 获取 ID 对应的字符串，ID 无效时返回空视图
+     */
+    std::string_view get_string(StringId id) const noexcept;
 
-    void clear() {
-        strings_.clear();
-        string_to_id_.clear();
-    }
+    /**
+     * @brief 清空字符串池（不能与其他调用并发，之前的 ID 和视图全部失效）
+     */
+    void clear();
 
-    void reserve(std::size_t size) {
-        strings_.reserve(size);
-        string_to_id_.reserve(size);
-    }
+    /**
+     * @brief 按预期的字符串数量预分配索引
+     */
+    void reserve(std::size_t size);
 
-    std::size_t size() const noexcept { return strings_.size(); }
+    /**
+     * @brief 已驻留的字符串数量
+     */
+    std::size_t size() const noexcept;
 
 private:
-    std::vector<std::string> strings_;
-    std::unordered_map<std::string, StringId> string_to_id_;
+    struct Shard;
+
+    std::array<std::unique_ptr<Shard>, SHARD_COUNT> shards_;
 };
 
 /**
@@ -172,6 +182,49 @@ private:
     }
 };
 
+/**
+ * @brief 单次解析使用的单调分配区
+ *
+ * 解析过程中的临时数据（属性值、元素文本等）从这里分配：分配只移动指针，不逐个释放，
+ * release() 一次性归还全部内存。前 INLINE_SIZE 字节位于对象内部，单个元素的临时数据
+ * 通常不会访问堆。
+ */
+class ParseArena {
+public:
+    static constexpr std::size_t INLINE_SIZE = 4096;
+
+    ParseArena() : resource_(buffer_.data(), buffer_.size()) {}
+
+    ParseArena(const ParseArena&) = delete;
+    ParseArena& operator=(const ParseArena&) = delete;
+
+    /**
+     * @brief 分配区的内存资源，可用于 std::pmr 容器
+     */
+    std::pmr::memory_resource* resource() noexcept { return &resource_; }
+
+    /**
+     * @brief 把字符串拷贝到分配区，返回的视图在 release() 之前有效
+     */
+    std::string_view copy(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        auto* data = static_cast<char*>(resource_.allocate(text.size(), 1));
+        std::memcpy(data, text.data(), text.size());
+        return {data, text.size()};
+    }
+
+    /**
+     * @brief 归还全部内存，之前分配的数据全部失效
+     */
+    void release() noexcept { resource_.release(); }
+
+private:
+    alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> buffer_;
+    std::pmr::monotonic_buffer_resource resource_;
+};
+
 /**
  * @brief 高性能缓存，使用LRU策略
  */
@@ -298,6 +351,51 @@ namespace simd {
     void copy_doubles(const double* src, double* dst, std::size_t count);
     void add_doubles(const double* a, const double* b, double* result, std::size_t count);
     bool compare_strings_fast(const char* a, const char* b, std::size_t len);
+
+    /**
+     * @brief 文本扫描内核使用的指令集级别
+     */
+    enum class Level : std::uint8_t {
+        Scalar,     ///< 逐字节实现
+        SSE2,       ///< 每次 16 字节
+        AVX2        ///< 每次 32 字节
+    };
+
+    /**
+     * @brief CPU 支持的最高级别（首次调用时检测）
+     */
+    Level detected_level() noexcept;
+
+    /**
+     * @brief 当前生效的级别
+     */
+    Level active_level() noexcept;
+
+    /**
+     * @brief 指定使用的级别，超过 CPU 支持时降到可用的最高级别（用于基准测试和对比测试）
+     * @return 实际生效的级别
+     */
+    Level set_level(Level level) noexcept;
+
+    const char* level_name(Level level) noexcept;
+
+    /**
+     * @brief 从 pos 开始查找第一个属于 needles 的字节
+     *
+     * needles 不超过 4 个字符时走向量路径，典型用法是查找 '<'、'>'、'"'、'&'。
+     * @return 与 std::string_view::find_first_of 相同，未找到时返回 npos
+     */
+    std::size_t find_any(std::string_view text, std::string_view needles, std::size_t pos = 0) noexcept;
+
+    /**
+     * @brief 查找第一个非法 UTF-8 字节的偏移（拒绝过长编码、代理项和超出 U+10FFFF 的码点）
+     * @return 合法时返回 npos
+     */
+    std::size_t find_invalid_utf8(std::string_view text) noexcept;
+
+    inline bool validate_utf8(std::string_view text) noexcept {
+        return find_invalid_utf8(text) == std::string_view::npos;
+    }
 }
 
 /**
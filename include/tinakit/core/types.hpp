@@ -35,6 +35,7 @@
 #include <filesystem>
 #include <iostream>
 #include "color.hpp"
+#include "write_profile.hpp"
 
 namespace tinakit {
 
@@ -51,10 +52,13 @@ struct Config {
     }
 
     bool enable_async = true;           ///< Enable async processing
-    std::size_t thread_pool_size = 4;   ///< Thread pool size
+    std::size_t thread_pool_size = 4;   ///< Threads used by Workbook::load/save(path, config); 1 = serial, 0 = hardware concurrency
     std::size_t max_memory_usage = 1024 * 1024 * 1024;  ///< Maximum memory usage (bytes)
     bool enable_formula_calculation = true;  ///< Enable formula calculation
     std::string temp_directory = "";    ///< Temporary directory path
+    core::WriteProfile write_profile;   ///< Compression per archive entry used by Workbook::save(path, config)
+    core::FileWritePolicy file_write_policy;  ///< Preallocation and fsync of the output file used by Workbook::save(path, config)
+    core::SharedStringPolicy shared_string_policy;  ///< Shared vs inline strings used by Workbook::save(path, config)
 };
 
 } // namespace tinakit
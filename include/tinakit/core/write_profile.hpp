@@ -0,0 +1,100 @@
+/**
+ * @file write_profile.hpp
+ * @brief 归档写入配置：按条目名称模式选择压缩级别、输出文件的落盘策略和字符串的存储方式
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tinakit::core
+{
+    /**
+     * @brief 条目的压缩方式
+     */
+    enum class CompressionProfile
+    {
+        Fastest,    ///< deflate 级别 1（zlib-ng 的 deflate_quick），吞吐优先
+        Balanced,   ///< deflate 默认级别（6），与之前的行为一致
+        Smallest,   ///< deflate 级别 9，体积优先
+        Store       ///< 不压缩，适合图片等已经压缩过的媒体文件
+    };
+
+    /**
+     * @brief 返回 profile 对应的 deflate 级别（Store 为 0）
+     */
+    int deflate_level(CompressionProfile profile) noexcept;
+
+    /**
+     * @brief 按条目名称选择压缩方式的规则表
+     *
+     * 规则按添加顺序匹配，第一个匹配的规则生效，都不匹配时使用 default_profile。
+     * 模式中 '*' 匹配任意长度的字符（包括 '/'），'?' 匹配单个字符，其余字符按原样比较。
+     *
+     * @code
+     * core::WriteProfile profile;
+     * profile.default_profile = core::CompressionProfile::Balanced;
+     * profile.add("xl/worksheets/sheet?.xml", core::CompressionProfile::Fastest)
+     *        .add("xl/media/image?.png", core::CompressionProfile::Store);
+     * @endcode
+     */
+    struct WriteProfile
+    {
+        CompressionProfile default_profile = CompressionProfile::Balanced;
+        std::vector<std::pair<std::string, CompressionProfile>> rules;
+
+        /**
+         * @brief 所有条目使用同一种压缩方式
+         */
+        static WriteProfile uniform(CompressionProfile profile);
+
+        /**
+         * @brief 追加一条规则
+         * @return 自身，便于链式调用
+         */
+        WriteProfile& add(std::string pattern, CompressionProfile profile);
+
+        /**
+         * @brief 返回条目应使用的压缩方式
+         */
+        CompressionProfile profile_for(std::string_view entry_name) const;
+    };
+
+    /**
+     * @brief 通配符匹配（'*' 和 '?'）
+     */
+    bool match_entry_pattern(std::string_view pattern, std::string_view name) noexcept;
+
+    /**
+     * @brief 直接写入文件的归档的落盘策略
+     */
+    struct FileWritePolicy
+    {
+        /// 预先为输出文件分配的字节数（0 为不预分配），减少追加写入时的碎片和元数据更新
+        std::uint64_t preallocate = 0;
+        /// 替换目标文件前把数据刷新到磁盘，保存完成后断电也不会留下不完整的文件
+        bool sync = false;
+    };
+
+    /**
+     * @brief 保存时字符串单元格写入共享字符串表还是内联的策略
+     *
+     * 共享字符串每次引用只需写入索引，但表中的每一项本身也有开销：只出现一次的字符串内联更小，
+     * 读取时也少一次查表。保存前统计每个字符串在整个工作簿中的出现次数，次数达到 min_repeats
+     * 的写入共享字符串表。从共享字符串表加载且未修改的单元格总是沿用原来的索引。
+     * - 0：不统计，新字符串全部内联，保存最快
+     * - 1：所有字符串都共享（与 Excel 相同）
+     * - 2：只共享重复出现的字符串（默认，文件最小）
+     */
+    struct SharedStringPolicy
+    {
+        std::size_t min_repeats = 2;
+    };
+}
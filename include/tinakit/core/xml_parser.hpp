@@ -7,8 +7,10 @@
 #include <istream>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <map>
 #include <functional>
 #include <libstudxml/parser.hxx>
@@ -94,6 +96,17 @@ namespace tinakit::core
          */
         XmlParser(std::istream& stream, const std::string& document_name);
 
+        /**
+         * @brief Construct an XmlParser over an in-memory buffer without copying it.
+         *
+         * The buffer is checked with the SIMD UTF-8 validator up front, so malformed
+         * input is rejected before any handler runs. The buffer must outlive the parser.
+         * @param buffer The XML document.
+         * @param document_name A name for the document, used in error messages.
+         * @throws ParseException if the buffer is not valid UTF-8.
+         */
+        XmlParser(std::string_view buffer, const std::string& document_name);
+
         ~XmlParser();
 
         XmlParser(const XmlParser&) = delete;
@@ -121,16 +134,39 @@ namespace tinakit::core
 
         /**
          * @brief Parse multiple element types in a single pass for better performance
+         *
+         * The parse arena is released after each handler returns, so views obtained
+         * through text_view() / attribute_view() are only valid inside the handler.
          * @param element_handlers Map of element names to their handlers
          */
         void parse_multiple_elements(const std::map<std::string, std::function<void(iterator&)>>& element_handlers);
 
         /**
          * @brief Parse multiple element types with namespace support in a single pass
+         *
+         * Handlers are looked up without building a key per element; the parse arena
+         * is released after each handler returns.
          * @param element_handlers Map of (namespace, element_name) pairs to their handlers
          */
         void parse_multiple_elements_ns(const std::map<std::pair<std::string, std::string>, std::function<void(iterator&)>>& element_handlers);
 
+        /**
+         * @brief The per-parse arena for transient allocations (std::pmr containers, text views)
+         *
+         * Memory is bump-allocated and only returned by release_arena(), by reset(),
+         * after each handler of the parse_multiple_elements / for_each_element family,
+         * or when the parser is destroyed.
+         */
+        std::pmr::memory_resource* arena() noexcept;
+
+        /**
+         * @brief Release everything allocated from the parse arena
+         *
+         * Invalidates all views returned by text_view() and attribute_view(). Callers
+         * that drive the iterator themselves should call this between records (e.g. rows).
+         */
+        void release_arena() noexcept;
+
         /**
          * @brief Get the last parsing error (if any)
          * @return Optional error information
@@ -144,7 +180,7 @@ namespace tinakit::core
         void set_error_recovery(bool enable);
         
         /**
-         * @brief 便利方法：解析整个 XML 元素及其子元素
+         * @brief 便利方法：解析整个 XML 元素及其子元素（每次回调返回后释放解析分配区）
          * @param element_name 要查找的元素名称
          * @param callback 处理元素的回调函数
          */
@@ -152,7 +188,7 @@ namespace tinakit::core
                             std::function<void(iterator&)> callback);
 
         /**
-         * @brief 便利方法：解析整个 XML 元素及其子元素（支持命名空间）
+         * @brief 便利方法：解析整个 XML 元素及其子元素（支持命名空间，每次回调返回后释放解析分配区）
          * @param namespace_uri 命名空间URI
          * @param element_name 要查找的元素名称
          * @param callback 处理元素的回调函数
@@ -206,8 +242,14 @@ namespace tinakit::core
             // 获取当前元素的文本内容（自动处理CDATA和字符实体）
             [[nodiscard]] std::string text_content();
 
+            // 与 text_content() 相同，但文本拷贝到解析分配区，不分配 std::string；
+            // 视图在解析分配区释放前有效
+            [[nodiscard]] std::string_view text_view();
+
             [[nodiscard]] std::optional<std::string> attribute(const std::string& qname) const;
             [[nodiscard]] std::optional<std::string> attribute(const xml::qname& qname) const;
+            // 属性值拷贝到解析分配区；视图在解析分配区释放前有效
+            [[nodiscard]] std::optional<std::string_view> attribute_view(const std::string& qname) const;
             [[nodiscard]] bool has_attribute(const std::string& qname) const;
             [[nodiscard]] bool has_attribute(const xml::qname& qname) const;
             
@@ -76,6 +76,14 @@ public:
         return ns;
     }
 
+    /**
+     * @brief XML 保留命名空间（xml:space 等属性）
+     */
+    static const std::string& xml() {
+        static const std::string ns = "http://www.w3.org/XML/1998/namespace";
+        return ns;
+    }
+
     // ========================================
     // Excel 绘图和图表命名空间
     // ========================================
@@ -203,6 +211,7 @@ namespace openxml_ns {
     inline const std::string& drawing = OpenXmlNamespaces::drawing();
     inline const std::string& chart = OpenXmlNamespaces::chart();
     inline const std::string& pkg_rel = OpenXmlNamespaces::package_relationships();
+    inline const std::string& xml = OpenXmlNamespaces::xml();
 
     // 常用前缀
     inline const std::string& r_prefix = OpenXmlNamespaces::relationships_prefix();
@@ -0,0 +1,102 @@
+/**
+ * @file row_stream.hpp
+ * @brief 只进式流式行读取器
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/excel/cell.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace tinakit::internal {
+class workbook_impl;
+} // namespace tinakit::internal
+
+namespace tinakit::excel {
+
+/**
+ * @struct StreamedCell
+ * @brief 流式读取得到的单元格
+ */
+struct StreamedCell {
+    std::size_t column = 0;               ///< 列号（1-based）
+    Cell::CellValue value;                ///< 单元格值（共享字符串已解析为文本）
+    std::uint32_t style_id = 0;           ///< 样式ID
+    std::optional<std::string> formula;   ///< 公式（不含前导 '='）
+};
+
+/**
+ * @class RowStream
+ * @brief 只进式工作表行读取器
+ *
+ * 直接从归档中按块解压工作表部件并逐行解析，不把单元格写入工作表的单元格存储，
+ * 内存占用与工作表大小无关。每次 next() 都复用同一个行缓冲区，
+ * 因此 cells() 返回的视图只在下一次调用 next() 之前有效。
+ *
+ * 读取的是归档中的工作表部件，不反映尚未保存的修改；新建且从未保存的工作表没有任何行。
+ *
+ * @example
+ * ```cpp
+ * auto workbook = Workbook::load("large.xlsx");
+ * auto rows = workbook.get_worksheet("Data").stream_rows();
+ * while (rows.next()) {
+ *     for (const auto& cell : rows.cells()) {
+ *         consume(rows.row_index(), cell.column, cell.value);
+ *     }
+ * }
+ * ```
+ */
+class RowStream {
+public:
+    /**
+     * @brief 构造函数
+     * @param workbook_impl 工作簿实现的共享指针
+     * @param sheet_name 工作表名称
+     * @param buffer_size 解压缓冲块大小（字节）
+     * @throws WorksheetNotFoundException 工作表不存在时
+     */
+    RowStream(std::shared_ptr<internal::workbook_impl> workbook_impl,
+              const std::string& sheet_name,
+              std::size_t buffer_size = 64 * 1024);
+
+    ~RowStream();
+
+    RowStream(const RowStream&) = delete;
+    RowStream& operator=(const RowStream&) = delete;
+    RowStream(RowStream&& other) noexcept;
+    RowStream& operator=(RowStream&& other) noexcept;
+
+    /**
+     * @brief 前进到下一行
+     * @return 已到达 sheetData 末尾时返回 false
+     */
+    bool next();
+
+    /**
+     * @brief 当前行号（1-based）
+     */
+    std::size_t row_index() const noexcept;
+
+    /**
+     * @brief 当前行中出现在 XML 里的单元格（按列递增）
+     */
+    std::span<const StreamedCell> cells() const noexcept;
+
+    /**
+     * @brief 已读取的行数
+     */
+    std::size_t rows_read() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tinakit::excel
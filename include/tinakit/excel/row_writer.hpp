@@ -0,0 +1,102 @@
+/**
+ * @file row_writer.hpp
+ * @brief 只追加式流式行写入器
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/excel/cell.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace tinakit::internal {
+class workbook_impl;
+} // namespace tinakit::internal
+
+namespace tinakit::excel {
+
+/**
+ * @class RowWriter
+ * @brief 只追加式工作表行写入器
+ *
+ * 由 Workbook::create_streaming_worksheet() 创建。每次 append_row() 都把一行序列化后
+ * 直接压缩进归档中的工作表条目，既不写入单元格存储，也不在内存中保留整张工作表的 XML，
+ * 峰值内存只与单行大小和压缩窗口有关。
+ *
+ * 使用限制：
+ * 1. 行只能按顺序追加，写入后无法修改
+ * 2. 字符串一律写为内联字符串，不进入共享字符串表
+ * 3. 在 close() 之前不能保存工作簿，也不能再创建其他流式工作表
+ * 4. 流式工作表之前的工作表不能再删除，否则部件编号会失配
+ *
+ * @example
+ * ```cpp
+ * auto workbook = Workbook::create();
+ * auto writer = workbook.create_streaming_worksheet("Report");
+ * writer.append_row({"ID", "Name", "Amount"});
+ * while (cursor.next()) {
+ *     writer.append_row({cursor.id(), cursor.name(), cursor.amount()});
+ * }
+ * writer.close();
+ * workbook.save("report.xlsx");
+ * ```
+ */
+class RowWriter {
+public:
+    /**
+     * @brief 构造函数
+     * @param workbook_impl 工作簿实现的共享指针
+     * @param sheet_name 新工作表名称
+     * @param buffer_size 压缩前的缓冲块大小（字节）
+     * @throws DuplicateWorksheetNameException 工作表名称已存在
+     */
+    RowWriter(std::shared_ptr<internal::workbook_impl> workbook_impl,
+              const std::string& sheet_name,
+              std::size_t buffer_size = 64 * 1024);
+
+    /**
+     * @brief 析构函数，未关闭时自动关闭（忽略错误）
+     */
+    ~RowWriter();
+
+    RowWriter(const RowWriter&) = delete;
+    RowWriter& operator=(const RowWriter&) = delete;
+    RowWriter(RowWriter&& other) noexcept;
+    RowWriter& operator=(RowWriter&& other) noexcept;
+
+    /**
+     * @brief 追加一行，第 i 个值写入第 i + 1 列
+     * @param values 单元格值，std::monostate 表示跳过该列
+     * @param style_id 整行单元格使用的样式ID
+     * @throws InvalidCellAddressException 已写满 1048576 行或值超过 16384 列（不写入该行）
+     */
+    void append_row(std::span<const Cell::CellValue> values, std::uint32_t style_id = 0);
+    void append_row(std::initializer_list<Cell::CellValue> values, std::uint32_t style_id = 0);
+
+    /**
+     * @brief 已写入的行数
+     */
+    std::size_t rows_written() const noexcept;
+
+    /**
+     * @brief 是否仍可写入
+     */
+    bool is_open() const noexcept;
+
+    /**
+     * @brief 结束工作表并关闭归档条目
+     */
+    void close();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tinakit::excel
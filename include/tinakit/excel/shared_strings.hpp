@@ -8,11 +8,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <cstdint>
+#include <limits>
 #include <optional>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace tinakit::excel {
 
@@ -22,9 +27,23 @@ namespace tinakit::excel {
  * 
  * 管理 Excel 文件中的共享字符串表。Excel 使用共享字符串来减少文件大小，
  * 相同的字符串只存储一次，单元格通过索引引用。
+ *
+ * 从文件加载时只扫描一遍 XML，记录每个 <si> 的位置，字符串在首次通过 get_string()
+ * 访问时才解码，可以在多个线程上同时读取。字符串到索引的反向映射只在需要查找或添加
+ * 字符串（编辑或保存）时才建立，建立时解码全部字符串并释放 XML 原文。
+ *
+ * 含格式串（<r>）或注音（<rPh>）的富文本字符串在保存时原样写回，get_string() 只给出其纯文本；
+ * 富文本字符串不参与按文本查找，添加相同文本的字符串会得到新的纯文本项。
  */
 class SharedStrings {
 public:
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief 写入 <t> 时是否需要 xml:space="preserve"（首尾有空白），共享和内联字符串都按此判断
+     */
+    static bool needs_space_preserve(std::string_view text) noexcept;
+
     /**
      * @brief 构造函数
      */
@@ -34,29 +53,39 @@ public:
      * @brief 析构函数
      */
     ~SharedStrings() = default;
+
+    SharedStrings(const SharedStrings&) = delete;
+    SharedStrings& operator=(const SharedStrings&) = delete;
     
     /**
-     * @brief 添加字符串到共享字符串表
+     * @brief 添加字符串到共享字符串表（首次调用时建立反向映射）
      * @param str 要添加的字符串
      * @return 字符串在共享字符串表中的索引
      */
     std::uint32_t add_string(const std::string& str);
     
     /**
-     * @brief 获取字符串的索引
+     * @brief 获取字符串的索引（首次调用时建立反向映射，不能与其他调用并发）
      * @param str 要查找的字符串
      * @return 字符串索引，如果不存在则返回 std::nullopt
      */
     std::optional<std::uint32_t> get_index(const std::string& str) const;
     
     /**
-     * @brief 根据索引获取字符串
+     * @brief 根据索引获取字符串，首次访问时解码
      * @param index 字符串索引
      * @return 对应的字符串
      * @throws std::out_of_range 如果索引超出范围
+     * @throws ParseException 如果延迟解码的 <si> 内容格式错误
      */
     const std::string& get_string(std::uint32_t index) const;
     
+    /**
+     * @brief 字符串是否已解码（新增的和通用解析器加载的字符串总是已解码）
+     * @param index 字符串索引，超出范围时返回 false
+     */
+    bool is_decoded(std::uint32_t index) const noexcept;
+
     /**
      * @brief 获取共享字符串数量
      * @return 共享字符串数量
@@ -65,7 +94,7 @@ public:
     
     /**
      * @brief 获取唯一字符串数量
-     * @return 唯一字符串数量（与 count() 相同）
+     * @return 唯一字符串数量（与 count() 相同，即 sst 的 uniqueCount）
      */
     std::size_t unique_count() const noexcept { return strings_.size(); }
     
@@ -74,17 +103,30 @@ public:
      */
     void clear();
     
+    /**
+     * @brief 压缩共享字符串表：删除未被引用的字符串，合并文本相同的纯文本字符串
+     *
+     * 所有字符串都被引用时不做任何处理（不解码也不计算哈希）。
+     * @param referenced 每个索引是否被单元格引用，超出长度的索引视为未被引用
+     * @return 旧索引到新索引的映射（未被引用的为 INVALID_INDEX），表未变化时返回 std::nullopt
+     */
+    std::optional<std::vector<std::uint32_t>> compact(const std::vector<bool>& referenced);
+
     /**
      * @brief 生成共享字符串 XML
+     * @param reference_count 单元格对共享字符串的引用总数（sst 的 count），未知时省略该属性
      * @return 共享字符串 XML 内容
      */
-    std::string generate_xml() const;
+    std::string generate_xml(std::optional<std::size_t> reference_count = std::nullopt) const;
     
     /**
      * @brief 从 XML 数据加载共享字符串
+     *
+     * 只确定每个 <si> 的位置，不解码文本；共享字符串表持有 XML 原文直到全部字符串被解码。
+     * 扫描器不支持的语法（<si> 内的 CDATA 等）和 UTF-16 文档回退到通用解析器立即解码。
      * @param xml_data XML 数据
      */
-    void load_from_xml(const std::string& xml_data);
+    void load_from_xml(std::string xml_data);
     
     /**
      * @brief 预分配空间
@@ -92,30 +134,22 @@ public:
      */
     void reserve(std::size_t size);
 
-    /**
-     * @brief 判断字符串是否应该使用共享字符串
-     * @param str 要判断的字符串
-     * @return true 如果应该使用共享字符串
-     */
-    static bool should_use_shared_string(const std::string& str);
-
-    /**
-     * @brief 记录字符串使用频率（用于智能决策）
-     * @param str 字符串
-     */
-    void record_string_usage(const std::string& str);
+private:
+    void load_with_parser(const std::string& xml_data);
+    void decode(std::uint32_t index) const;
+    void build_index() const;
+    void release_source();
 
-    /**
-     * @brief 获取字符串使用频率
-     * @param str 字符串
-     * @return 使用频率
-     */
-    std::size_t get_usage_count(const std::string& str) const;
+    // 延迟解码：前 items_.size() 个字符串在 decoded_ 置位前为空，由 decode() 填充
+    std::string source_;                            ///< sharedStrings.xml 原文
+    std::vector<std::string_view> items_;           ///< 每个 <si> 的内容，引用 source_
+    std::unique_ptr<std::atomic<bool>[]> decoded_;  ///< items_ 中的字符串是否已解码
+    mutable std::array<std::mutex, 16> decode_mutexes_;  ///< 按索引分片的解码锁
 
-private:
-    std::vector<std::string> strings_;              ///< 字符串列表（按索引存储）
-    std::unordered_map<std::string, std::uint32_t> string_to_index_;  ///< 字符串到索引的映射
-    std::unordered_map<std::string, std::size_t> usage_count_;        ///< 字符串使用频率统计
+    mutable std::vector<std::string> strings_;      ///< 字符串列表（按索引存储）
+    mutable std::unordered_map<std::uint32_t, std::string> rich_text_;  ///< 富文本字符串的 <si> 原始内容（按索引）
+    mutable std::unordered_map<std::string, std::uint32_t> string_to_index_;  ///< 纯文本字符串到索引的映射
+    mutable bool index_built_ = false;              ///< string_to_index_ 是否已建立
 };
 
 } // namespace tinakit::excel 
\ No newline at end of file
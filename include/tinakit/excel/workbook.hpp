@@ -21,6 +21,9 @@ namespace tinakit::excel {
 class Worksheet;
 class Range;
 class Cell;
+class RowWriter;
+class WorkbookStream;
+struct LoadManyOptions;
 
 } // namespace tinakit::excel
 
@@ -98,19 +101,64 @@ public:
      */
     static Workbook load(const std::filesystem::path& file_path);
 
+    /**
+     * @brief 按配置加载 Excel 文件
+     *
+     * config.enable_async 为 true 且 config.thread_pool_size 不为 1 时使用并行打开模式：
+     * 在 thread_pool_size 个线程上同时解压并解析样式、共享字符串和所有工作表
+     * （0 表示使用硬件并发数），再按工作表顺序合并，结果与串行加载一致。
+     * 否则与 load(file_path) 相同，工作表在首次访问时按需加载。
+     * @param file_path 文件路径
+     * @param config 加载配置
+     */
+    static Workbook load(const std::filesystem::path& file_path, const Config& config);
+
     /**
      * @brief 异步加载 Excel 文件
+     *
+     * 文件通过 core::IoBackend（Linux 上为 io_uring）读入内存，等待磁盘期间不占用调用线程，
+     * 随后在 I/O 执行器上解析工作簿结构；等待方也在该执行器上恢复。
      * @param file_path 文件路径
      * @return 返回 Workbook 的 Task
+     * @throws IOException 文件无法读取
      */
     static async::Task<Workbook> load_async(const std::filesystem::path& file_path);
 
+    /**
+     * @brief 并发加载多个 Excel 文件
+     *
+     * 文件在内部线程池上读取和解析，结果按完成顺序（或 options.preserve_order 时按 paths 顺序）
+     * 通过返回的结果流逐个取得；同时打开的归档数、待取结果数和内存占用（options.config.max_memory_usage）
+     * 都有上限，调用方取得结果的速度跟不上时会暂停加载后续文件。
+     * 需要包含 tinakit/excel/workbook_stream.hpp。
+     * @param paths 文件路径
+     * @param options 并发和内存限制
+     * @return 结果流，单个文件的错误记录在对应结果中
+     */
+    static WorkbookStream load_many(std::vector<std::filesystem::path> paths, const LoadManyOptions& options);
+
+    /**
+     * @brief 使用默认选项并发加载多个 Excel 文件
+     */
+    static WorkbookStream load_many(std::vector<std::filesystem::path> paths);
+
     /**
      * @brief 创建新的工作簿
      * @return 新的 Workbook 句柄
      */
     static Workbook create();
 
+    /**
+     * @brief 创建新的工作簿并指定保存路径
+     *
+     * 之后通过 create_streaming_worksheet() 写入的行直接压缩到 file_path 旁的临时文件，
+     * save() 时写入其余部件并替换目标文件，整个归档不会在内存中组装。
+     * 创建过流式工作表后只能保存到 file_path。
+     * @param file_path 保存路径
+     * @return 新的 Workbook 句柄
+     */
+    static Workbook create(const std::filesystem::path& file_path);
+
     // ========================================
     // 工作表访问
     // ========================================
@@ -163,6 +211,17 @@ public:
      */
     Worksheet create_worksheet(const std::string& name);
 
+    /**
+     * @brief 创建以流式方式写入的新工作表
+     *
+     * 行数据直接压缩进归档，不经过单元格存储，适合生成超大报表。
+     * 由 create(file_path) 创建的工作簿直接写入输出文件；其他工作簿的归档在内存中组装，保存时写出。
+     * @param name 工作表名称
+     * @return 行写入器，写完后需调用 close() 再保存工作簿
+     * @throws DuplicateWorksheetNameException 工作表名称已存在
+     */
+    RowWriter create_streaming_worksheet(const std::string& name);
+
     /**
      * @brief 删除工作表
      * @param name 工作表名称
@@ -220,8 +279,26 @@ public:
      */
     void save(const std::filesystem::path& file_path = {});
 
+    /**
+     * @brief 按配置保存工作簿
+     *
+     * config.enable_async 为 true 且 config.thread_pool_size 不为 1 时使用并行压缩：
+     * 每个条目切分为 1 MiB 的独立块，在 thread_pool_size 个线程上同时压缩
+     * （0 表示使用硬件并发数）。各条目的压缩级别由 config.write_profile 决定，
+     * 例如工作表使用 Fastest、媒体文件使用 Store。config.file_write_policy 控制输出文件的
+     * 预分配和保存完成前是否刷新到磁盘。config.shared_string_policy 决定字符串出现多少次才写入
+     * 共享字符串表（默认只共享重复的字符串）。
+     * @param file_path 保存路径（为空时使用原路径）
+     * @param config 保存配置
+     * @throws IOException 保存失败
+     */
+    void save(const std::filesystem::path& file_path, const Config& config);
+
     /**
      * @brief 异步保存工作簿
+     *
+     * 保存在专用于阻塞保存的线程池上进行（不占用 I/O 执行器，并发保存不会互相阻塞 I/O 完成），
+     * 等待方也在该线程池上恢复；完成前不要在其他线程使用此工作簿。
      * @param file_path 保存路径（可选，默认使用原路径）
      * @return 保存任务
      */
@@ -261,6 +338,8 @@ public:
     std::shared_ptr<internal::workbook_impl> impl() const;
 
 private:
+    friend class WorkbookStream;
+
     // 内部构造函数（供静态工厂方法使用）
     explicit Workbook(std::shared_ptr<internal::workbook_impl> impl);
 
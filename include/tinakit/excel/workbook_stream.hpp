@@ -0,0 +1,126 @@
+/**
+ * @file workbook_stream.hpp
+ * @brief 批量并发加载工作簿的结果流
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/types.hpp"
+#include "tinakit/excel/workbook.hpp"
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace tinakit::excel {
+
+/**
+ * @struct LoadManyOptions
+ * @brief Workbook::load_many() 的选项
+ */
+struct LoadManyOptions {
+    /**
+     * @brief 线程和内存配置
+     *
+     * thread_pool_size 为解析线程数（0 表示硬件并发数，enable_async 为 false 时只用 1 个线程）；
+     * max_memory_usage 为所有已加载工作簿共享的内存预算。
+     */
+    Config config;
+
+    /// 同时读取和解析的归档数上限（0 表示与解析线程数相同）
+    std::size_t max_open_archives = 0;
+
+    /// 已完成但尚未被 next() 取走的结果数上限（0 表示与 max_open_archives 相同）
+    std::size_t max_ready_results = 0;
+
+    /// 为 true 时按 paths 的顺序返回结果，否则按完成顺序返回
+    bool preserve_order = false;
+};
+
+/**
+ * @struct LoadResult
+ * @brief 单个文件的加载结果
+ */
+struct LoadResult {
+    std::size_t index = 0;              ///< 文件在 paths 中的下标
+    std::filesystem::path path;         ///< 文件路径
+    std::optional<Workbook> workbook;   ///< 加载成功时的工作簿
+    std::exception_ptr error;           ///< 加载失败时的异常
+
+    /**
+     * @brief 是否加载成功
+     */
+    bool ok() const noexcept { return workbook.has_value(); }
+
+    /**
+     * @brief 返回工作簿，加载失败时重新抛出加载时的异常
+     */
+    Workbook& value();
+};
+
+/**
+ * @class WorkbookStream
+ * @brief Workbook::load_many() 返回的结果流
+ *
+ * 文件在内部线程池上并发读取和解析，某个文件加载完成后即可通过 next() 取得，
+ * 不必等待后面的文件。以下条件都满足时才会开始加载下一个文件：
+ * - 正在加载的文件数小于 max_open_archives；
+ * - 尚未取走的结果数小于 max_ready_results；
+ * - 内存预算足够。每个文件按其大小计入预算（归档内容在工作簿存活期间常驻内存），
+ *   直到对应的 Workbook 及其所有副本都被销毁才归还。
+ *
+ * 调用方保留所有工作簿时，预算耗尽后只有在没有文件正在加载、也没有待取结果时
+ * 才会继续加载下一个文件，因此 next() 不会永久阻塞，但总内存可能超过预算。
+ * 单个文件加载失败不会中断整个流，错误记录在对应的 LoadResult 中。
+ *
+ * 销毁结果流会跳过尚未开始的文件，并等待正在加载的文件结束。
+ *
+ * @example
+ * ```cpp
+ * auto results = Workbook::load_many(paths, LoadManyOptions{});
+ * while (auto result = results.next()) {
+ *     if (!result->ok()) {
+ *         report(result->path, result->error);
+ *         continue;
+ *     }
+ *     process(result->value());
+ * }
+ * ```
+ */
+class WorkbookStream {
+public:
+    /**
+     * @brief 构造函数，立即开始加载
+     * @param paths 文件路径
+     * @param options 加载选项
+     */
+    WorkbookStream(std::vector<std::filesystem::path> paths, const LoadManyOptions& options);
+
+    ~WorkbookStream();
+
+    WorkbookStream(const WorkbookStream&) = delete;
+    WorkbookStream& operator=(const WorkbookStream&) = delete;
+    WorkbookStream(WorkbookStream&& other) noexcept;
+    WorkbookStream& operator=(WorkbookStream&& other) noexcept;
+
+    /**
+     * @brief 取出下一个结果，必要时阻塞等待
+     * @return 所有文件都已返回时为 std::nullopt
+     */
+    std::optional<LoadResult> next();
+
+    /**
+     * @brief 文件总数
+     */
+    std::size_t size() const noexcept;
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+} // namespace tinakit::excel
@@ -14,6 +14,7 @@
 #include "row.hpp"
 #include "column.hpp"
 #include "range.hpp"
+#include "row_stream.hpp"
 #include <filesystem>
 #include <vector>
 #include <string>
@@ -198,6 +199,14 @@ public:
      * @return 行范围对象
      */
     RowRange rows();
+
+    /**
+     * @brief 以只进流方式读取归档中的工作表行
+     * @param buffer_size 解压缓冲块大小（字节）
+     * @return 行读取器，不会加载工作表的单元格数据
+     * @note 适合一次性扫描超大工作表，读取的是归档中已保存的内容
+     */
+    RowStream stream_rows(std::size_t buffer_size = 64 * 1024) const;
     
     /**
      * @brief 获取工作表范围（支持样式操作）
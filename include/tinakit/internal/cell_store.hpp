@@ -0,0 +1,327 @@
+/**
+ * @file cell_store.hpp
+ * @brief 行块列式单元格存储
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/types.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include "compact_cell.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace tinakit::internal {
+
+/**
+ * @class CellStore
+ * @brief 按行块组织的列式单元格存储
+ *
+ * 行被划分为固定大小的行块（BLOCK_ROWS 行），行块内按列号有序保存列块。
+ * 每个列块把 CompactCell 的各字段拆开存放：
+ * - 数字和整数存放在 double 数组中，布尔值存放在位图中
+ * - 字符串 ID、共享字符串表索引、公式表 ID 和错误码共用一个 32 位数组
+ * - 单元格是否存在由位图表示
+ *
+ * 各类型数组按需分配，纯数字列不会为字符串 ID 付出内存。分配以列块为单位：每个列块固定占用
+ * 约 350 字节（类型数组和两个位图），每种类型数组再占 BLOCK_ROWS 个槽位（double 数组 2 KiB，
+ * 32 位数组 1 KiB）。行块内填满的列平均每个单元格约 6～15 字节，稀疏的列每个单元格可能占用数 KiB。
+ * 查找只需一次下标定位行块、一次二分定位列块，不再逐节点追指针。
+ * 读取时优先使用 cell() 和 for_each_cell()，它们只返回 CompactCell，不解析字符串。
+ */
+class CellStore {
+public:
+    static constexpr std::size_t BLOCK_SHIFT = 8;
+    static constexpr std::size_t BLOCK_ROWS = std::size_t{1} << BLOCK_SHIFT;
+
+    /**
+     * @brief 构造函数
+     * @param strings 字符串池（字符串值和公式共用）
+     * @param formulas 公式表，为空时使用存储自带的公式表
+     * @param shared_strings 共享字符串表，为空时不保存共享字符串索引，字符串一律驻留到字符串池
+     */
+    explicit CellStore(core::StringPool& strings, FormulaArena* formulas = nullptr,
+                       const excel::SharedStrings* shared_strings = nullptr);
+
+    ~CellStore();
+
+    CellStore(const CellStore&) = delete;
+    CellStore& operator=(const CellStore&) = delete;
+    CellStore(CellStore&&) noexcept;
+    CellStore& operator=(CellStore&&) = delete;
+
+    // ========================================
+    // 单元格访问
+    // ========================================
+
+    /**
+     * @brief 获取紧凑单元格
+     * @return 单元格不存在时返回 std::nullopt
+     */
+    std::optional<CompactCell> cell(const core::Coordinate& pos) const;
+
+    /**
+     * @brief 把紧凑单元格解析为视图
+     */
+    CellView resolve(const CompactCell& cell) const {
+        return resolve_cell(cell, strings_, *formulas_, shared_strings_);
+    }
+
+    /**
+     * @brief 获取单元格数据（会拷贝字符串）
+     * @return 单元格不存在时返回 std::nullopt
+     */
+    std::optional<cell_data> get(const core::Coordinate& pos) const;
+
+    /**
+     * @brief 获取单元格视图
+     * @return 单元格不存在时返回 std::nullopt
+     */
+    std::optional<CellView> view(const core::Coordinate& pos) const;
+
+    /**
+     * @brief 检查单元格是否存在
+     */
+    bool contains(const core::Coordinate& pos) const;
+
+    /**
+     * @brief 写入单元格数据（覆盖已有数据）
+     * @throws InvalidCellAddressException 如果坐标超出 Excel 的行列上限
+     */
+    void set(const core::Coordinate& pos, const cell_data& data);
+
+    /**
+     * @brief 按视图写入单元格（不经过 cell_data）
+     *
+     * 带 shared_index 的非公式字符串只保存共享字符串表索引，其余字符串直接驻留到字符串池。
+     * @throws InvalidCellAddressException 如果坐标超出 Excel 的行列上限
+     */
+    void set(const core::Coordinate& pos, const CellView& view);
+
+    /**
+     * @brief 删除单元格
+     * @return 单元格原本存在时返回 true
+     */
+    bool erase(const core::Coordinate& pos);
+
+    /**
+     * @brief 清空所有单元格并释放行块
+     */
+    void clear();
+
+    /**
+     * @brief 单元格数量
+     */
+    std::size_t size() const noexcept { return cell_count_; }
+
+    /**
+     * @brief 是否为空
+     */
+    bool empty() const noexcept { return cell_count_ == 0; }
+
+    /**
+     * @brief 估算存储占用的字节数（不含字符串池）
+     */
+    std::size_t memory_usage() const noexcept;
+
+    /**
+     * @brief 获取所有单元格的包围范围
+     * @return 存储为空时返回 std::nullopt
+     */
+    std::optional<core::range_address> bounds() const;
+
+    // ========================================
+    // 遍历
+    // ========================================
+
+    /**
+     * @brief 按行优先顺序遍历所有单元格
+     * @param fn 回调 fn(const core::Coordinate&, const CompactCell&)
+     */
+    template <typename Fn>
+    void for_each_cell(Fn&& fn) const;
+
+    /**
+     * @brief 按行优先顺序遍历所有单元格
+     * @param fn 回调 fn(const core::Coordinate&, const CellView&)
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn) const;
+
+    /**
+     * @brief 按行优先顺序遍历范围内的单元格
+     * @param range 范围地址
+     * @param fn 回调 fn(const core::Coordinate&, const CellView&)
+     */
+    template <typename Fn>
+    void for_each_in_range(const core::range_address& range, Fn&& fn) const;
+
+    // ========================================
+    // 行列移动
+    // ========================================
+
+    /**
+     * @brief 在 row 处插入 count 行，row 及之后的单元格下移
+     * @throws InvalidCellAddressException 如果单元格会被移出 Excel 的行数上限（此时不做任何修改）
+     */
+    void insert_rows(std::size_t row, std::size_t count);
+
+    /**
+     * @brief 删除 [row, row + count) 行，之后的单元格上移
+     */
+    void delete_rows(std::size_t row, std::size_t count);
+
+    /**
+     * @brief 在 column 处插入 count 列，column 及之后的单元格右移
+     * @throws InvalidCellAddressException 如果单元格会被移出 Excel 的列数上限（此时不做任何修改）
+     */
+    void insert_columns(std::size_t column, std::size_t count);
+
+    /**
+     * @brief 删除 [column, column + count) 列，之后的单元格左移
+     */
+    void delete_columns(std::size_t column, std::size_t count);
+
+    // ========================================
+    // 共享字符串
+    // ========================================
+
+    /**
+     * @brief 标记被单元格引用的共享字符串索引，索引超出 referenced 长度时自动扩展
+     */
+    void mark_shared_strings(std::vector<bool>& referenced) const;
+
+    /**
+     * @brief 按映射表（旧索引到新索引）重新编号所有共享字符串单元格，只遍历一遍存储
+     */
+    void remap_shared_strings(const std::vector<std::uint32_t>& mapping);
+
+private:
+    /**
+     * @brief 行块中单列的数据
+     */
+    struct ColumnChunk {
+        std::size_t column = 0;
+        std::bitset<BLOCK_ROWS> present;
+        std::bitset<BLOCK_ROWS> booleans;
+        std::array<CellKind, BLOCK_ROWS> kinds{};
+        std::unique_ptr<double[]> numbers;
+        std::unique_ptr<std::uint32_t[]> ids;         ///< 字符串 ID、共享字符串表索引、公式表 ID 或错误码
+        std::unique_ptr<std::uint32_t[]> style_ids;
+
+        explicit ColumnChunk(std::size_t col) : column(col) {}
+    };
+
+    /**
+     * @brief 固定行数的行块
+     */
+    struct RowBlock {
+        std::vector<ColumnChunk> columns;                 ///< 按列号有序
+        std::array<std::uint32_t, BLOCK_ROWS> row_counts{}; ///< 每行的单元格数
+        std::size_t cell_count = 0;
+    };
+
+    static std::size_t block_index(std::size_t row) noexcept { return row >> BLOCK_SHIFT; }
+    static std::size_t row_offset(std::size_t row) noexcept { return row & (BLOCK_ROWS - 1); }
+
+    const ColumnChunk* find_chunk(const RowBlock& block, std::size_t column) const;
+    ColumnChunk& get_or_create_chunk(RowBlock& block, std::size_t column);
+
+    template <typename Fn>
+    void visit(std::size_t first_row, std::size_t last_row, std::size_t first_column, std::size_t last_column,
+               Fn&& fn) const;
+
+    CompactCell make_cell(const cell_data& data);
+    CompactCell make_cell(const CellView& view);
+    static CompactCell read_cell(const ColumnChunk& chunk, std::size_t offset);
+    void write_cell(const core::Coordinate& pos, const CompactCell& cell);
+
+    /**
+     * @brief 归还 [first_column, last_column] 列中所有公式单元格的公式表项
+     */
+    void release_formulas(std::size_t first_column, std::size_t last_column);
+
+    /**
+     * @brief 取出所有单元格并清空存储（用于行移动，公式表项随单元格一起转移）
+     */
+    std::vector<std::pair<core::Coordinate, CompactCell>> drain();
+
+    core::StringPool& strings_;
+    std::unique_ptr<FormulaArena> owned_formulas_;
+    FormulaArena* formulas_;
+    const excel::SharedStrings* shared_strings_;
+    std::vector<std::unique_ptr<RowBlock>> blocks_;
+    std::size_t cell_count_ = 0;
+};
+
+// ========================================
+// 模板实现
+// ========================================
+
+template <typename Fn>
+void CellStore::visit(std::size_t first_row, std::size_t last_row, std::size_t first_column, std::size_t last_column,
+                      Fn&& fn) const {
+    if (first_row > last_row || first_column > last_column) {
+        return;
+    }
+    const std::size_t first_block = block_index(first_row);
+    const std::size_t last_block = block_index(last_row);
+    for (std::size_t b = first_block; b < blocks_.size() && b <= last_block; ++b) {
+        const auto* block = blocks_[b].get();
+        if (!block || block->cell_count == 0) {
+            continue;
+        }
+        const std::size_t block_first_row = b << BLOCK_SHIFT;
+        const std::size_t begin = first_row > block_first_row ? row_offset(first_row) : 0;
+        const std::size_t end = last_row < block_first_row + BLOCK_ROWS ? row_offset(last_row) + 1 : BLOCK_ROWS;
+
+        auto first_chunk = std::lower_bound(block->columns.begin(), block->columns.end(), first_column,
+            [](const ColumnChunk& chunk, std::size_t column) { return chunk.column < column; });
+
+        for (std::size_t offset = begin; offset < end; ++offset) {
+            if (block->row_counts[offset] == 0) {
+                continue;
+            }
+            for (auto it = first_chunk; it != block->columns.end() && it->column <= last_column; ++it) {
+                if (it->present.test(offset)) {
+                    fn(core::Coordinate(block_first_row | offset, it->column), *it, offset);
+                }
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void CellStore::for_each_cell(Fn&& fn) const {
+    visit(0, std::numeric_limits<std::size_t>::max(), 0, std::numeric_limits<std::size_t>::max(),
+          [&fn](const core::Coordinate& pos, const ColumnChunk& chunk, std::size_t offset) {
+              fn(pos, read_cell(chunk, offset));
+          });
+}
+
+template <typename Fn>
+void CellStore::for_each(Fn&& fn) const {
+    visit(0, std::numeric_limits<std::size_t>::max(), 0, std::numeric_limits<std::size_t>::max(),
+          [this, &fn](const core::Coordinate& pos, const ColumnChunk& chunk, std::size_t offset) {
+              fn(pos, resolve(read_cell(chunk, offset)));
+          });
+}
+
+template <typename Fn>
+void CellStore::for_each_in_range(const core::range_address& range, Fn&& fn) const {
+    visit(range.start.row, range.end.row, range.start.column, range.end.column,
+          [this, &fn](const core::Coordinate& pos, const ColumnChunk& chunk, std::size_t offset) {
+              fn(pos, resolve(read_cell(chunk, offset)));
+          });
+}
+
+} // namespace tinakit::internal
@@ -0,0 +1,175 @@
+/**
+ * @file compact_cell.hpp
+ * @brief 单元格值的内部表示：16 字节的紧凑单元格、工作簿级公式表和解析后的视图
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/performance_optimizations.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace tinakit::excel {
+class SharedStrings;
+}
+
+namespace tinakit::internal {
+
+/**
+ * @brief 单元格数据结构（写入时使用的值类型，读取走 CompactCell）
+ */
+struct cell_data {
+    using CellValue = std::variant<std::monostate, std::string, double, int, bool>;
+
+    CellValue value;
+    std::optional<std::string> formula;
+    std::uint32_t style_id = 0;
+
+    cell_data() = default;
+    cell_data(const CellValue& val) : value(val) {}
+};
+
+/**
+ * @enum CellKind
+ * @brief 存储层中的单元格值类型
+ */
+enum class CellKind : std::uint8_t {
+    Empty,      ///< 无值（仅有样式）
+    Number,     ///< 浮点数
+    Integer,    ///< 整数
+    Boolean,    ///< 布尔值
+    String,     ///< 字符串（字符串池 ID）
+    Error,      ///< 错误值（CellError）
+    Formula,    ///< 公式（FormulaArena ID），缓存结果保存在公式表中
+    SharedString ///< 来自共享字符串表的字符串（共享字符串表索引），保存时原样写回索引
+};
+
+/**
+ * @enum CellError
+ * @brief Excel 错误值
+ */
+enum class CellError : std::uint8_t {
+    Null,           ///< #NULL!
+    Div0,           ///< #DIV/0!
+    Value,          ///< #VALUE!
+    Ref,            ///< #REF!
+    Name,           ///< #NAME?
+    Num,            ///< #NUM!
+    NA,             ///< #N/A
+    GettingData     ///< #GETTING_DATA
+};
+
+/**
+ * @brief 错误值的文本形式（如 "#DIV/0!"）
+ */
+std::string_view cell_error_text(CellError error) noexcept;
+
+/**
+ * @brief 解析错误值文本，不是已知错误值时返回 std::nullopt
+ */
+std::optional<CellError> parse_cell_error(std::string_view text) noexcept;
+
+/**
+ * @brief 单元格值的 8 字节负载，含义由 CellKind 决定
+ */
+union CellPayload {
+    double number;          ///< Number、Integer
+    bool boolean;           ///< Boolean
+    std::uint32_t id;       ///< String 的字符串池 ID，SharedString 的共享字符串表索引，Formula 的公式表 ID
+    CellError error;        ///< Error
+};
+
+/**
+ * @struct CompactCell
+ * @brief 16 字节的单元格：类型标记、样式 ID 和负载
+ *
+ * 不持有任何字符串，拷贝和返回都不分配内存；字符串和公式通过 ID 引用工作簿级的
+ * 字符串池、共享字符串表和公式表，需要文本时用 resolve_cell() 得到 CellView。
+ */
+struct CompactCell {
+    CellKind kind = CellKind::Empty;
+    std::uint32_t style_id = 0;
+    CellPayload payload{};
+
+    bool has_formula() const noexcept { return kind == CellKind::Formula; }
+};
+
+static_assert(sizeof(CompactCell) == 16, "CompactCell must stay 16 bytes");
+
+/**
+ * @class FormulaArena
+ * @brief 工作簿级公式表
+ *
+ * 每个公式单元格占用一项，保存驻留在字符串池中的公式文本和最近一次的计算结果。
+ * 单元格被覆盖或删除时由单元格存储归还表项，空闲表项会被复用。
+ */
+class FormulaArena {
+public:
+    using FormulaId = std::uint32_t;
+
+    struct Entry {
+        core::StringPool::StringId text = core::StringPool::INVALID_ID;   ///< 公式文本（不含前导 '='）
+        CellKind result_kind = CellKind::Empty;                          ///< 缓存结果的类型（不会是 Formula）
+        CellPayload result{};                                            ///< 缓存结果
+    };
+
+    /**
+     * @brief 分配一项
+     */
+    FormulaId add(core::StringPool::StringId text, CellKind result_kind, CellPayload result);
+
+    /**
+     * @brief 归还一项
+     */
+    void release(FormulaId id);
+
+    const Entry& get(FormulaId id) const { return entries_[id]; }
+
+    /**
+     * @brief 正在使用的表项数
+     */
+    std::size_t size() const noexcept { return entries_.size() - free_.size(); }
+
+private:
+    std::vector<Entry> entries_;
+    std::vector<FormulaId> free_;
+};
+
+/**
+ * @struct CellView
+ * @brief 单元格的只读视图，字符串和公式直接引用字符串池，不做拷贝
+ *
+ * kind 不会是 CellKind::Formula：公式单元格的视图给出缓存结果，公式文本在 formula 中。
+ * kind 也不会是 CellKind::SharedString：共享字符串单元格的视图是 String，文本引用共享字符串表，
+ * 索引保存在 shared_index 中；向共享字符串表添加字符串后文本视图可能失效。
+ */
+struct CellView {
+    CellKind kind = CellKind::Empty;
+    double number = 0.0;
+    bool boolean = false;
+    CellError error = CellError::NA;
+    std::string_view text;
+    std::optional<std::string_view> formula;
+    std::optional<std::uint32_t> shared_index;  ///< 字符串来自共享字符串表时的索引
+    std::uint32_t style_id = 0;
+
+    /**
+     * @brief 转换为 cell_data（会拷贝字符串，错误值转换为其文本）
+     */
+    cell_data to_cell_data() const;
+};
+
+/**
+ * @brief 把紧凑单元格解析为视图
+ * @param shared_strings 共享字符串表，为空时共享字符串单元格解析为空字符串
+ */
+CellView resolve_cell(const CompactCell& cell, const core::StringPool& strings, const FormulaArena& formulas,
+                      const excel::SharedStrings* shared_strings = nullptr);
+
+} // namespace tinakit::internal
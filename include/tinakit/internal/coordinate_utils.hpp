@@ -8,6 +8,7 @@
 #pragma once
 
 #include "tinakit/core/types.hpp"
+#include <array>
 #include <string>
 #include <string_view>
 
@@ -27,6 +28,11 @@ namespace tinakit::internal::utils {
  */
 class CoordinateUtils {
 public:
+    /// Excel 工作表的最大行数
+    static constexpr std::size_t MAX_ROWS = 1048576;
+    /// Excel 工作表的最大列数（XFD）
+    static constexpr std::size_t MAX_COLUMNS = 16384;
+
     // ========================================
     // 单个坐标转换
     // ========================================
@@ -56,6 +62,20 @@ public:
      * - {100, 27} -> "AA100"
      */
     static std::string coordinate_to_string(const core::Coordinate& coord);
+
+    /// format_coordinate() 所需的缓冲区（最长的列字母加最长的行号）
+    using CoordinateBuffer = std::array<char, 48>;
+
+    /**
+     * @brief 将行列号写成"A1"风格的引用，不分配内存
+     * @param row 行号（从1开始）
+     * @param column 列号（从1开始）
+     * @param buffer 输出缓冲区
+     * @return 指向 buffer 的视图
+     *
+     * 供序列化等热路径使用，不做有效性检查，调用方保证行列都大于0。
+     */
+    static std::string_view format_coordinate(std::size_t row, std::size_t column, CoordinateBuffer& buffer) noexcept;
     
     // ========================================
     // 范围地址转换
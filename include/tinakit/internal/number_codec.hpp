@@ -0,0 +1,72 @@
+/**
+ * @file number_codec.hpp
+ * @brief 单元格数字的文本编解码：最短往返格式化和不抛异常的解析
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace tinakit::internal::utils {
+
+/**
+ * @brief 数字编解码工具类
+ *
+ * 基于 std::to_chars / std::from_chars，不依赖区域设置、不分配内存、不抛出异常。
+ * 格式化结果是能精确还原原值的最短表示，解析要求整个文本都是数字。
+ */
+class NumberCodec {
+public:
+    /// 格式化所需的缓冲区（最短往返的 double 最多 24 个字符）
+    using NumberBuffer = std::array<char, 32>;
+
+    /**
+     * @brief 以最短往返表示格式化浮点数
+     * @return 指向 buffer 的视图
+     *
+     * 转换示例：
+     * - 1.0 -> "1"
+     * - 0.1 -> "0.1"
+     * - 1e21 -> "1e+21"
+     *
+     * 非有限值会输出 "nan"、"inf"，不是合法的单元格数字；单元格存储和流式写入器把它们写为 #NUM! 错误。
+     */
+    static std::string_view format_number(double value, NumberBuffer& buffer) noexcept;
+
+    /**
+     * @brief 格式化浮点数并返回字符串
+     */
+    static std::string format_number(double value);
+
+    /**
+     * @brief 格式化整数
+     * @return 指向 buffer 的视图
+     */
+    template<typename Integer>
+    static std::string_view format_integer(Integer value, NumberBuffer& buffer) noexcept {
+        static_assert(std::is_integral_v<Integer>, "format_integer requires an integral type");
+        auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        return std::string_view(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
+    }
+
+    /**
+     * @brief 解析十进制整数
+     * @return 整个文本是 int 范围内的整数时返回其值，否则返回 std::nullopt
+     */
+    static std::optional<int> parse_integer(std::string_view text) noexcept;
+
+    /**
+     * @brief 解析数字（支持小数和指数形式，如 "1.5"、"1e5"）
+     * @return 整个文本是有限的数字时返回其值，否则（包括 "inf"、"nan"）返回 std::nullopt
+     */
+    static std::optional<double> parse_number(std::string_view text) noexcept;
+};
+
+} // namespace tinakit::internal::utils
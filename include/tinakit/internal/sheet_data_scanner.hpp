@@ -0,0 +1,158 @@
+/**
+ * @file sheet_data_scanner.hpp
+ * @brief sheetData 专用的零拷贝扫描器
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tinakit::internal {
+
+/**
+ * @struct ScannedCell
+ * @brief 扫描得到的单元格，所有视图在下一次 next() 之前有效
+ */
+struct ScannedCell {
+    std::size_t row = 0;            ///< 行号（1-based）
+    std::size_t column = 0;         ///< 列号（1-based）
+    std::uint32_t style_id = 0;     ///< s 属性
+    std::string_view type;          ///< t 属性（未指定时为空）
+    std::string_view text;          ///< <v> 或内联字符串的文本（已解码实体）
+    std::string_view formula;       ///< <f> 的文本（已解码实体）
+    bool has_formula = false;       ///< 是否存在 <f> 元素
+};
+
+/**
+ * @class SheetDataScanner
+ * @brief 只识别 sheetData 语法（row / c / v / f / is）的手写扫描器
+ *
+ * 直接在连续缓冲区上按标签扫描，名称和属性都以 string_view 返回，
+ * 只有含实体或内联富文本的字符串才会写入内部复用的缓冲区，不会逐单元格分配内存。
+ * 元素名忽略命名空间前缀；未知元素整体跳过。
+ *
+ * 遇到 CDATA、注释、处理指令或无法识别的实体时停止并置 failed()，
+ * 调用者应回退到通用的 XmlParser。
+ *
+ * 增量模式下内容通过 feed() 逐块提供：单元格跨越块边界时 next() 返回 false 且
+ * needs_input() 为 true，补充内容后从该单元格开头重新扫描，只缓存未扫描完的尾部。
+ */
+class SheetDataScanner {
+public:
+    /**
+     * @param xml sheetData 的内容（若干 <row> 元素），遇到 </sheetData> 时停止
+     */
+    explicit SheetDataScanner(std::string_view xml) noexcept : xml_(xml) {}
+
+    /**
+     * @brief 创建增量模式的扫描器，内容通过 feed() 提供
+     */
+    SheetDataScanner() noexcept : streaming_(true) {}
+
+    /**
+     * @brief 追加一块内容（仅增量模式）
+     *
+     * 已扫描的内容被丢弃，之前 next() 返回的视图随之失效。
+     */
+    void feed(std::string_view chunk);
+
+    /**
+     * @brief 声明不会再有更多内容，此后不完整的元素按语法错误处理
+     */
+    void finish_input() noexcept { input_done_ = true; }
+
+    /**
+     * @brief next() 返回 false 是否只是因为缓冲的内容不足
+     */
+    bool needs_input() const noexcept { return streaming_ && !input_done_ && !failed_ && !ended_; }
+
+    /**
+     * @brief 是否已遇到 </sheetData>
+     */
+    bool ended() const noexcept { return ended_; }
+
+    /**
+     * @brief 缓冲区中尚未扫描的内容；遇到 </sheetData> 后从该结束标签开始
+     */
+    std::string_view remaining() const noexcept { return xml_.substr(pos_); }
+
+    /**
+     * @brief 读取下一个单元格
+     * @return 没有更多单元格或扫描失败时返回 false
+     */
+    bool next(ScannedCell& cell);
+
+    /**
+     * @brief 是否因不支持的语法而中止
+     */
+    bool failed() const noexcept { return failed_; }
+
+private:
+    enum class TagKind { Start, End, Empty };
+
+    struct Tag {
+        TagKind kind = TagKind::Start;
+        std::string_view name;        ///< 本地名（去掉前缀）
+        std::string_view attributes;  ///< 元素名之后到 '>' 之前的内容
+    };
+
+    bool read_tag(Tag& tag);
+    bool skip_element();
+    bool read_text(std::string_view element, std::string_view& raw);
+    bool read_cell(const Tag& tag, ScannedCell& cell);
+    bool read_inline_string(ScannedCell& cell);
+    bool fail() noexcept;
+    bool need_input() noexcept;
+
+    std::string_view xml_;
+    std::size_t pos_ = 0;
+    std::size_t row_ = 0;
+    std::size_t column_ = 0;
+    bool failed_ = false;
+    bool ended_ = false;
+
+    // 增量模式
+    bool streaming_ = false;
+    bool input_done_ = false;
+    bool truncated_ = false;        ///< 本次扫描遇到了缓冲区末尾
+    std::string window_;            ///< 未扫描完的内容
+
+    // 需要解码时使用的复用缓冲区
+    std::string text_buffer_;
+    std::string formula_buffer_;
+};
+
+/**
+ * @brief 解码 XML 文本中的实体引用并规范化换行
+ * @param raw 原始文本
+ * @param buffer 需要改写时使用的缓冲区
+ * @param out 结果（无需改写时直接引用 raw）
+ * @return 含无法识别的实体时返回 false
+ */
+bool decode_xml_text(std::string_view raw, std::string& buffer, std::string_view& out);
+
+/**
+ * @brief 扫描 sharedStrings.xml，找出每个 <si> 元素的内容，不解码文本
+ * @param xml 整个 sharedStrings.xml
+ * @param items 输出：每个 <si> 开始标签和结束标签之间的原文（引用 xml），空元素为空视图
+ * @return 遇到 <si> 内的 CDATA、注释或结构错误时返回 false，调用者应回退到通用的 XmlParser
+ */
+bool scan_shared_string_items(std::string_view xml, std::vector<std::string_view>& items);
+
+/**
+ * @brief 把富文本内容（<si> 或 <is> 的子元素）解码为纯文本
+ *
+ * 依次拼接 <t> 和 <r><t> 的文本并解码实体，跳过 rPr、rPh 等不属于单元格文本的元素。
+ * @param content 元素内容
+ * @param out 结果
+ * @return 内容不符合该语法或含无法识别的实体时返回 false
+ */
+bool decode_rich_text(std::string_view content, std::string& out);
+
+} // namespace tinakit::internal
@@ -0,0 +1,105 @@
+/**
+ * @file sheet_row_index.hpp
+ * @brief 工作表 XML 行块索引
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace tinakit::internal {
+
+/**
+ * @class SheetRowIndex
+ * @brief 工作表 XML 中 sheetData 的行块字节索引
+ *
+ * 通过一次只查找 `<row` 标签的轻量扫描，记录每个行块（与 CellStore 的行块对齐）
+ * 在 XML 中对应的字节区间。之后只需解析调用者实际访问到的行块，
+ * 读取 A1 不再需要解析整张工作表。
+ *
+ * 遇到无法安全切分的内容（行号倒序、注释、CDATA 等）时 build() 返回 std::nullopt，
+ * 调用者应回退到整表解析。
+ */
+class SheetRowIndex {
+public:
+    /**
+     * @brief 一个行块在 XML 中的字节区间
+     */
+    struct Span {
+        std::size_t block = 0;      ///< 行块编号（行号 >> block_shift）
+        std::size_t first_row = 0;  ///< 区间内第一行的行号
+        std::size_t last_row = 0;   ///< 区间内最后一行的行号
+        std::size_t begin = 0;      ///< 第一个 <row 的字节偏移
+        std::size_t end = 0;        ///< 区间结束偏移（不含）
+        bool loaded = false;        ///< 是否已解析
+    };
+
+    /**
+     * @brief 扫描工作表 XML 构建索引
+     * @param xml 完整的工作表 XML
+     * @param block_shift 行块大小的位移（行块大小为 1 << block_shift）
+     * @return 无法安全切分时返回 std::nullopt
+     */
+    static std::optional<SheetRowIndex> build(std::string_view xml, std::size_t block_shift);
+
+    /**
+     * @brief 定位 sheetData 的开始标签
+     * @param xml 工作表 XML，可以只是开头的一部分（边解压边查找）
+     * @param prefix 输出：sheetData 的命名空间前缀（含 ':'，没有前缀时为空）
+     * @param self_closing 输出：是否为 <sheetData/>
+     * @return 开始标签之后的偏移；xml 中还没有完整的开始标签时返回 std::nullopt
+     */
+    static std::optional<std::size_t> find_sheet_data(std::string_view xml, std::string_view& prefix,
+                                                      bool& self_closing);
+
+    /**
+     * @brief sheetData 内容起始偏移（开始标签之后）
+     */
+    std::size_t sheet_data_begin() const noexcept { return sheet_data_begin_; }
+
+    /**
+     * @brief sheetData 内容结束偏移（结束标签所在位置）
+     */
+    std::size_t sheet_data_end() const noexcept { return sheet_data_end_; }
+
+    /**
+     * @brief 根元素的开始标签（含命名空间声明），用于包装行块片段
+     */
+    std::string_view root_open_tag(std::string_view xml) const noexcept {
+        return xml.substr(root_tag_begin_, root_tag_end_ - root_tag_begin_);
+    }
+
+    /**
+     * @brief 根元素的限定名（如 "worksheet" 或 "x:worksheet"）
+     */
+    std::string_view root_name(std::string_view xml) const noexcept {
+        return xml.substr(root_name_begin_, root_name_end_ - root_name_begin_);
+    }
+
+    /**
+     * @brief 所有行块区间（按行号递增）
+     */
+    std::vector<Span>& spans() noexcept { return spans_; }
+    const std::vector<Span>& spans() const noexcept { return spans_; }
+
+    /**
+     * @brief 是否所有行块都已解析
+     */
+    bool fully_loaded() const noexcept;
+
+private:
+    std::size_t root_tag_begin_ = 0;
+    std::size_t root_tag_end_ = 0;
+    std::size_t root_name_begin_ = 0;
+    std::size_t root_name_end_ = 0;
+    std::size_t sheet_data_begin_ = 0;
+    std::size_t sheet_data_end_ = 0;
+    std::vector<Span> spans_;
+};
+
+} // namespace tinakit::internal
@@ -0,0 +1,43 @@
+/**
+ * @file string_storage_plan.hpp
+ * @brief 保存时按出现次数选择共享字符串或内联字符串
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#pragma once
+
+#include "tinakit/core/write_profile.hpp"
+#include "cell_store.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+namespace tinakit::internal {
+
+/**
+ * @class StringStoragePlan
+ * @brief 一次保存中字符串单元格的存储决策
+ *
+ * 保存前对每个要重新生成的工作表调用 count()，统计字符串池 ID 在整个工作簿中的出现次数；
+ * 序列化时用 share() 判断字符串写入共享字符串表还是内联。公式的缓存结果不参与统计。
+ */
+class StringStoragePlan {
+public:
+    explicit StringStoragePlan(const core::SharedStringPolicy& policy = {}) : min_repeats_(policy.min_repeats) {}
+
+    /**
+     * @brief 统计存储中字符串单元格的出现次数（策略不需要计数时直接返回）
+     */
+    void count(const CellStore& cells);
+
+    /**
+     * @brief 字符串是否写入共享字符串表
+     */
+    bool share(core::StringPool::StringId id) const;
+
+private:
+    std::size_t min_repeats_;
+    std::unordered_map<core::StringPool::StringId, std::uint32_t> repeats_;
+};
+
+} // namespace tinakit::internal
@@ -14,6 +14,7 @@
 #include "tinakit/excel/types.hpp"
 #include "tinakit/excel/shared_strings.hpp"
 #include "tinakit/excel/style_manager.hpp"
+#include "compact_cell.hpp"
 #include <memory>
 #include <string>
 #include <map>
@@ -33,20 +34,8 @@ namespace tinakit::internal {
 
 // 前向声明
 class worksheet_impl;
-
-/**
- * @brief 单元格数据结构
- */
-struct cell_data {
-    using CellValue = std::variant<std::monostate, std::string, double, int, bool>;
-    
-    CellValue value;
-    std::optional<std::string> formula;
-    std::uint32_t style_id = 0;
-    
-    cell_data() = default;
-    cell_data(const CellValue& val) : value(val) {}
-};
+struct PreparedSheet;
+enum class LoadState;
 
 /**
  * @class workbook_impl
@@ -72,8 +61,19 @@ public:
     /**
      * @brief 构造函数（用于加载现有文件）
      * @param file_path 文件路径
+     * @param load_threads 加载线程数：1 为按需加载；0 或大于 1 时在线程池上并发解析
+     *        样式、共享字符串和所有工作表（0 表示使用硬件并发数）
      */
-    explicit workbook_impl(const std::filesystem::path& file_path);
+    explicit workbook_impl(const std::filesystem::path& file_path, std::size_t load_threads = 1);
+
+    /**
+     * @brief 构造函数（用已经打开的归档加载，例如异步读入的文件）
+     * @param file_path 文件路径，之后保存时使用
+     * @param archiver 已打开的归档
+     * @param load_threads 同上
+     */
+    workbook_impl(const std::filesystem::path& file_path, std::shared_ptr<core::OpenXmlArchiver> archiver,
+                  std::size_t load_threads = 1);
     
     /**
      * @brief 析构函数
@@ -139,6 +139,51 @@ public:
      * @brief 确保默认结构已创建
      */
     void ensure_has_worksheet();
+
+    /**
+     * @brief 获取工作表在归档中的部件路径（如 "xl/worksheets/sheet1.xml"）
+     * @return 工作表不是从文件加载的，或关系文件中没有对应条目时返回 std::nullopt
+     */
+    std::optional<std::string> worksheet_part_path(const std::string& sheet_name) const;
+
+    /**
+     * @brief 在归档中定位工作表部件
+     *
+     * 优先使用关系文件记录的路径；只有关系文件不可用时才按工作表位置推断。
+     * @return 归档中不存在对应部件时返回 std::nullopt
+     */
+    std::optional<std::string> locate_worksheet_part(const std::string& sheet_name) const;
+
+    /**
+     * @brief 保存时工作表写入的部件路径（按工作表顺序编号）
+     */
+    std::string worksheet_save_path(const std::string& sheet_name) const;
+
+    /**
+     * @brief 保存时能否直接沿用归档中的原始工作表部件
+     *
+     * 工作表未修改且保存路径与原始部件路径相同时，归档器按压缩后的原始字节复制该部件，
+     * 无需加载、序列化和重新压缩。
+     */
+    bool can_copy_worksheet_part(const std::string& sheet_name) const;
+
+    /**
+     * @brief 创建一个内容由流式写入器直接写入归档的工作表
+     *
+     * 新工作簿设置了保存路径时，归档直接写入该路径旁的临时文件，不在内存中组装；
+     * 否则（包括已加载的工作簿）先写入内存中的归档，保存时整体写出。
+     * @param name 工作表名称
+     * @param buffer_size 压缩前的缓冲块大小（字节）
+     * @return 已打开的工作表部件输出流；打开失败时不会注册工作表
+     * @throws DuplicateWorksheetNameException 工作表名称已存在
+     */
+    std::unique_ptr<core::EntryOutputStream> begin_streaming_worksheet(const std::string& name,
+                                                                       std::size_t buffer_size);
+
+    /**
+     * @brief 获取工作表的加载状态（不会触发加载）
+     */
+    LoadState worksheet_load_state(const std::string& sheet_name) const;
     
     // ========================================
     // 单元格数据访问（核心API）
@@ -164,6 +209,17 @@ public:
      */
     std::optional<cell_data> get_cell_data(const core::Coordinate& pos);
 
+    /**
+     * @brief 获取紧凑单元格（不拷贝字符串）
+     * @return 单元格不存在时返回 std::nullopt
+     */
+    std::optional<CompactCell> get_cell(std::uint32_t sheet_id, const core::Coordinate& pos);
+
+    /**
+     * @brief 把本工作簿中的紧凑单元格解析为视图，视图中的文本在字符串池中，随工作簿存活
+     */
+    CellView resolve_cell(const CompactCell& cell) const;
+
     /**
      * @brief 获取工作表的使用范围
      */
@@ -320,10 +376,11 @@ public:
      * @brief 获取性能统计信息
      */
     struct PerformanceStats {
-        std::size_t string_pool_size;
+        std::size_t string_pool_size;   ///< 本工作簿字符串池中的字符串数
         std::size_t cell_cache_hits;
         std::size_t cell_cache_misses;
         double cache_hit_ratio;
+        std::size_t cell_store_bytes;   ///< 已加载工作表单元格存储占用的字节数
     };
     PerformanceStats get_performance_stats() const;
     
@@ -348,6 +405,16 @@ public:
      */
     std::shared_ptr<excel::SharedStrings> get_shared_strings() const { return shared_strings_; }
 
+    /**
+     * @brief 获取工作簿级字符串池（单元格字符串和公式共用）
+     */
+    core::StringPool& string_pool() { return *string_pool_; }
+
+    /**
+     * @brief 获取工作簿级公式表
+     */
+    FormulaArena& formula_arena() { return *formula_arena_; }
+
     // ========================================
     // 公式计算
     // ========================================
@@ -396,19 +463,35 @@ public:
     
     /**
      * @brief 保存到文件
-     */
-    void save(const std::filesystem::path& file_path);
+     * @param deflate_threads 压缩线程数，1 为串行压缩，0 表示硬件并发数
+     * @param profile 各条目的压缩方式
+     * @param file_policy 输出文件的预分配和刷新策略
+     * @param string_policy 字符串写入共享字符串表还是内联
+     */
+    void save(const std::filesystem::path& file_path, std::size_t deflate_threads = 1,
+              const core::WriteProfile& profile = {}, const core::FileWritePolicy& file_policy = {},
+              const core::SharedStringPolicy& string_policy = {});
     
     /**
      * @brief 保存到当前文件
+     * @param deflate_threads 压缩线程数，1 为串行压缩，0 表示硬件并发数
+     * @param profile 各条目的压缩方式
+     * @param file_policy 输出文件的预分配和刷新策略
+     * @param string_policy 字符串写入共享字符串表还是内联
      */
-    void save();
+    void save(std::size_t deflate_threads = 1, const core::WriteProfile& profile = {},
+              const core::FileWritePolicy& file_policy = {}, const core::SharedStringPolicy& string_policy = {});
     
     /**
      * @brief 获取文件路径
      */
     const std::filesystem::path& file_path() const;
 
+    /**
+     * @brief 设置新工作簿的保存路径，之后的流式工作表直接写入该文件
+     */
+    void set_file_path(const std::filesystem::path& file_path);
+
     /**
      * @brief 获取归档器（供 worksheet_impl 使用）
      */
@@ -419,7 +502,9 @@ public:
     // ========================================
     
     /**
-     * @brief 确保工作表已加载
+     * @brief 确保工作表已完全加载
+     *
+     * 单元格级别的访问不需要调用此方法，worksheet_impl 会按行块按需加载。
      */
     void ensure_worksheet_loaded(const std::string& sheet_name);
     
@@ -439,12 +524,12 @@ private:
     std::shared_ptr<excel::StyleManager> style_manager_;
     std::shared_ptr<excel::SharedStrings> shared_strings_;
 
-    // 公式引擎
-    std::unique_ptr<excel::FormulaEngine> formula_engine_;
-
     // 性能优化组件
     std::unique_ptr<core::StringPool> string_pool_;
-    std::unique_ptr<core::MemoryPool<cell_data>> cell_data_pool_;
+    std::unique_ptr<FormulaArena> formula_arena_;
+
+    // 公式引擎（构造时依赖上面的组件，必须声明在其后）
+    std::unique_ptr<excel::FormulaEngine> formula_engine_;
     
     // 工作表实现映射
     std::map<std::string, std::unique_ptr<worksheet_impl>> worksheets_;
@@ -457,27 +542,45 @@ private:
     std::map<std::uint32_t, std::string> sheet_id_to_name_;
     std::uint32_t next_sheet_id_ = 1;
 
+    // 工作表部件路径（来自 workbook.xml 的 r:id 和 workbook.xml.rels）
+    std::map<std::string, std::string> sheet_name_to_rel_id_;
+    std::map<std::string, std::string> sheet_part_paths_;
+
     // 活动工作表名称
     std::string active_sheet_name_;
 
+    // 归档中共享字符串部件的字符串数量，未变化时保存直接沿用原始部件
+    std::optional<std::size_t> archived_shared_string_count_;
+
     // 修改标志
     bool is_dirty_ = false;
     
     // 内部方法
-    void load_from_file();
+    void load_from_file(std::size_t load_threads);
     void create_default_structure();
     void parse_workbook_xml();
     void parse_workbook_rels();
     void load_styles_xml();
     void load_shared_strings_xml();
-    void save_to_archiver();
+    void load_styles_part(bool present);
+    void load_shared_strings_part(bool present);
+    void load_parts_parallel(std::size_t thread_count);
+    std::string read_part_text(const std::string& part_path) const;
+    async::Task<void> prepare_worksheet(async::Executor& executor, std::string part_path,
+                                        PreparedSheet& prepared, std::size_t max_chunks);
+    void save_to_archiver(std::size_t deflate_threads, const core::WriteProfile& profile,
+                          const core::FileWritePolicy& file_policy, const core::SharedStringPolicy& string_policy);
     void generate_content_types();
     void generate_main_rels();
     void generate_workbook_xml();
     void generate_workbook_rels();
     void generate_styles_xml();
-    void generate_shared_strings_xml();
+    void generate_shared_strings_xml(bool table_changed, std::optional<std::size_t> reference_count);
+    bool compact_shared_strings();
     
+    // 注册工作表实现（不创建句柄，可在构造期间调用）
+    worksheet_impl& add_worksheet(const std::string& name, LoadState initial_state);
+
     // 获取或创建工作表实现（私有版本）
     worksheet_impl& get_worksheet_impl(const std::string& sheet_name);
 };
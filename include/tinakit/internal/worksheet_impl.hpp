@@ -10,17 +10,26 @@
 #include "tinakit/core/types.hpp"
 #include "tinakit/core/xml_parser.hpp"
 #include "workbook_impl.hpp"
+#include "cell_store.hpp"
+#include "sheet_row_index.hpp"
+#include "string_storage_plan.hpp"
+#include <deque>
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <memory>
 #include <optional>
 
 namespace tinakit::core {
 class OpenXmlArchiver;
+class EntryReader;
 } // namespace tinakit::core
 
 namespace tinakit::internal {
 
+struct ScannedCell;
+
 /**
  * @enum LoadState
  * @brief 工作表加载状态
@@ -31,6 +40,34 @@ enum class LoadState {
     FullyLoaded     ///< 完全加载
 };
 
+/**
+ * @struct PreparedSheet
+ * @brief 在工作线程上预解析的工作表，不引用任何工作簿状态
+ *
+ * sheetData 在行块边界上切分为若干分块，各分块可以在不同线程上扫描。
+ * 数值在扫描时完成转换；字符串尚未驻留到字符串池、共享字符串索引尚未解析，
+ * 由 worksheet_impl::adopt() 在调用线程上按分块顺序写入单元格存储。
+ */
+struct PreparedSheet {
+    struct Cell {
+        core::Coordinate pos;
+        CellView view;                  ///< 文本视图引用 xml 或所在分块的 decoded
+        bool shared_string = false;     ///< view.text 为共享字符串索引
+    };
+
+    struct Chunk {
+        std::vector<Cell> cells;
+        std::deque<std::string> decoded;    ///< 解码后的文本（含实体或富文本）
+        bool failed = false;
+    };
+
+    bool available = false;             ///< 是否成功读取了工作表部件
+    bool scanned = false;               ///< 所有分块都已由快速路径扫描
+    std::string xml;
+    std::optional<SheetRowIndex> row_index;
+    std::vector<Chunk> chunks;          ///< 按行顺序排列
+};
+
 /**
  * @class worksheet_impl
  * @brief 工作表的内部实现类
@@ -49,8 +86,10 @@ public:
      * @brief 构造函数
      * @param name 工作表名称
      * @param workbook_impl 父工作簿实现的引用
+     * @param initial_state 初始加载状态（新建的工作表无需从归档加载）
      */
-    worksheet_impl(const std::string& name, workbook_impl& workbook);
+    worksheet_impl(const std::string& name, workbook_impl& workbook,
+                   LoadState initial_state = LoadState::FullyLoaded);
     
     /**
      * @brief 析构函数
@@ -96,11 +135,22 @@ public:
      * @brief 获取加载状态
      */
     LoadState load_state() const;
+
+    /**
+     * @brief 获取单元格存储占用的字节数（估算值）
+     */
+    std::size_t memory_usage() const;
     
     // ========================================
     // 单元格数据访问
     // ========================================
     
+    /**
+     * @brief 获取紧凑单元格（按需加载所在行块，不拷贝字符串）
+     * @return 单元格不存在时返回 std::nullopt
+     */
+    std::optional<CompactCell> get_cell(const core::Coordinate& pos) const;
+
     /**
      * @brief 获取单元格数据
      */
@@ -147,12 +197,15 @@ public:
     // ========================================
     
     /**
-     * @brief 确保指定位置的数据已加载
+     * @brief 确保指定位置所在的行块已加载
+     *
+     * 首次访问时只建立行块索引并解析 sheetData 以外的内容（合并单元格、条件格式），
+     * 之后仅解析被访问到的行块，状态为 LoadState::PartialLoaded。
      */
     void ensure_loaded(const core::Coordinate& pos);
     
     /**
-     * @brief 确保指定范围的数据已加载
+     * @brief 确保指定范围覆盖的行块已加载
      */
     void ensure_range_loaded(const core::range_address& range);
     
@@ -160,6 +213,35 @@ public:
      * @brief 强制加载所有数据
      */
     void load_all();
+
+    /**
+     * @brief 预解析工作表 XML（不访问工作表或工作簿状态）
+     *
+     * sheetData 不小于 min_chunk_bytes 的两倍时按字节均分为至多 max_chunks 个分块，
+     * 各分块切换到 executor 上并行扫描。
+     * @param executor 扫描分块使用的执行器
+     * @param xml 工作表部件内容
+     * @param prepared 输出，其中的视图引用 prepared.xml，因此直接写入调用方的对象
+     * @param max_chunks 最大分块数
+     * @param min_chunk_bytes 每个分块的最小字节数
+     */
+    static async::Task<void> prepare(async::Executor& executor, std::string xml, PreparedSheet& prepared,
+                                     std::size_t max_chunks, std::size_t min_chunk_bytes = 1024 * 1024);
+
+    /**
+     * @brief 按单元格类型把 <v> 文本转换为存储视图
+     * @param shared_strings 共享字符串表，为空时类型 s 保留原始文本；否则只记录索引，
+     *        view.formula 已设置时才解码文本作为缓存结果
+     */
+    static void convert_cell_value(std::string_view type, std::string_view text,
+                                   const excel::SharedStrings* shared_strings, CellView& view);
+
+    /**
+     * @brief 采用预解析结果完成加载（仅对尚未加载的工作表生效）
+     *
+     * 快速路径无法处理的工作表回退到通用解析器，但不会重新解压。
+     */
+    void adopt(PreparedSheet& prepared);
     
     /**
      * @brief 卸载数据以释放内存
@@ -263,10 +345,38 @@ public:
      */
     void clear_dirty();
 
+    /**
+     * @brief 统计本工作表字符串单元格的出现次数（保存前调用）
+     */
+    void count_strings(StringStoragePlan& plan);
+
     /**
      * @brief 保存到归档器
+     * @param plan 字符串写入共享字符串表还是内联
+     * @return 写入的共享字符串引用数
+     */
+    std::size_t save_to_archiver(core::OpenXmlArchiver& archiver, const StringStoragePlan& plan);
+
+    /**
+     * @brief 标记本工作表引用的共享字符串索引
      */
-    void save_to_archiver(core::OpenXmlArchiver& archiver);
+    void mark_shared_strings(std::vector<bool>& referenced) const;
+
+    /**
+     * @brief 压缩共享字符串表后按映射表重新编号单元格中的索引
+     */
+    void remap_shared_strings(const std::vector<std::uint32_t>& mapping);
+
+    /**
+     * @brief 标记工作表内容已由流式写入器直接写入归档，保存时不再序列化
+     * @param part_path 写入的部件路径
+     */
+    void mark_streamed(std::string part_path);
+
+    /**
+     * @brief 工作表内容是否已由流式写入器写入
+     */
+    bool is_streamed() const noexcept { return streamed_part_path_.has_value(); }
 
     // ========================================
     // 条件格式
@@ -298,12 +408,6 @@ public:
     std::optional<std::uint32_t> apply_conditional_format(const core::Coordinate& pos);
 
 private:
-    /**
-     * @brief 判断字符串是否应该使用内联存储
-     * @param str 字符串
-     * @return true 如果应该使用内联存储
-     */
-    bool should_use_inline_string(const std::string& str) const;
     // 基本属性
     std::string name_;
     workbook_impl& workbook_;
@@ -312,8 +416,8 @@ private:
     LoadState load_state_ = LoadState::NotLoaded;
     bool is_dirty_ = false;
     
-    // 单元格数据存储
-    std::map<core::Coordinate, cell_data> cells_;
+    // 单元格数据存储（行块列式存储）
+    CellStore cells_;
     
     // 工作表尺寸
     std::size_t max_row_ = 0;
@@ -333,11 +437,33 @@ private:
     // 条件格式
     std::vector<excel::ConditionalFormat> conditional_formats_;
     
+    // 窗口化加载：保留工作表 XML 和行块索引，按需解析行块
+    std::string sheet_xml_;
+    std::optional<SheetRowIndex> row_index_;
+
+    // 流式写入的部件路径（内容不在 cells_ 中）
+    std::optional<std::string> streamed_part_path_;
+
     // 内部方法
-    void load_from_xml();
+    std::optional<std::string> read_sheet_xml() const;
+    void build_row_index();
+    void load_streamed();
+    bool stream_sheet_xml(core::EntryReader& reader);
+    void index_sheet_xml(std::string xml);
+    void parse_sheet_skeleton(std::string_view xml, const SheetRowIndex& index);
+    void load_row_blocks(std::size_t first_block, std::size_t last_block);
+    void finish_partial_load();
     void update_dimensions(const core::Coordinate& pos);
     void parse_cell_data(const std::string& xml_content);
-    std::string generate_worksheet_xml();
+    void parse_cell_data(std::istream& stream);
+    void parse_cell_elements(core::XmlParser& parser);
+    bool scan_cell_data(std::string_view xml);
+    void store_scanned_cell(const ScannedCell& cell, const excel::SharedStrings* shared_strings);
+    void store_cell(const core::Coordinate& pos, std::string_view type, std::string_view text,
+                    std::optional<std::string_view> formula, std::uint32_t style_id,
+                    const excel::SharedStrings* shared_strings);
+    void store_view(const core::Coordinate& pos, const CellView& view);
+    std::size_t write_worksheet_xml(std::ostream& out, const StringStoragePlan& plan);
 
     // 优化的解析方法
     void parse_single_cell(core::XmlParser::iterator& it, core::XmlParser& parser);
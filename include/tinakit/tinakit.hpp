@@ -15,11 +15,14 @@
 #include "tinakit/core/xml_parser.hpp"
 #include "tinakit/core/openxml_archiver.hpp"
 #include "tinakit/excel/workbook.hpp"
+#include "tinakit/excel/workbook_stream.hpp"
 #include "tinakit/excel/worksheet.hpp"
 #include "tinakit/excel/style_manager.hpp"
 #include "tinakit/excel/style.hpp"
 #include "tinakit/excel/cell.hpp"
 #include "tinakit/excel/row.hpp"
+#include "tinakit/excel/row_stream.hpp"
+#include "tinakit/excel/row_writer.hpp"
 #include <filesystem>
 #include <functional>
 
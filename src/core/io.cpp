@@ -3,37 +3,557 @@
 //
 
 #include "tinakit/core/io.hpp"
-#include <fstream>
+#include "tinakit/core/exceptions.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <filesystem>
+#include <list>
+#include <mutex>
 
-tinakit::async::Task<void> tinakit::core::write_file_binary(const std::string& path, const std::vector<std::byte>& data)
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
 {
-    std::ofstream file(path, std::ios::binary);
+    using tinakit::IOException;
+    using tinakit::core::IoBackend;
+    using tinakit::core::IoRequest;
+    using tinakit::core::NativeFile;
+
+    // 整个文件读写时每个请求的大小，所有请求同时提交
+    constexpr std::size_t IO_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    std::string temp_path_for(const std::string& path)
+    {
+        return path + ".tinakit-tmp";
+    }
+
+    void replace_with_temp(const std::string& temp_path, const std::string& path)
+    {
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temp_path, ec);
+            throw IOException("Failed to replace file", path);
+        }
+    }
+
+#ifdef _WIN32
+
+    NativeFile open_native(const std::string& path, bool write)
+    {
+        const std::wstring wide_path = std::filesystem::path(path).wstring();
+        HANDLE file = write
+            ? CreateFileW(wide_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)
+            : CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw IOException(write ? "Failed to create file" : "Failed to open file for reading", path);
+        }
+        return file;
+    }
+
+    void close_native(NativeFile file) noexcept
+    {
+        CloseHandle(file);
+    }
+
+    std::uint64_t native_size(NativeFile file, const std::string& path)
+    {
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size))
+        {
+            throw IOException("Failed to get file size", path);
+        }
+        return static_cast<std::uint64_t>(size.QuadPart);
+    }
+
+    void preallocate_native(NativeFile file, std::uint64_t size) noexcept
+    {
+        // 只分配空间，不改变文件末尾；失败时按普通写入处理
+        FILE_ALLOCATION_INFO info{};
+        info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+        SetFileInformationByHandle(file, FileAllocationInfo, &info, sizeof(info));
+    }
+
+    bool truncate_native(NativeFile file, std::uint64_t size) noexcept
+    {
+        FILE_END_OF_FILE_INFO end_of_file{};
+        end_of_file.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+        return SetFileInformationByHandle(file, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file));
+    }
+
+    bool sync_native(NativeFile file) noexcept
+    {
+        return FlushFileBuffers(file);
+    }
+
+    void sync_directory_of(const std::string&) noexcept
+    {
+        // NTFS 的重命名由文件系统日志保证，没有对应的目录刷新操作
+    }
+
+#else
+
+    NativeFile open_native(const std::string& path, bool write)
+    {
+        const int fd = write ? ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666)
+                             : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw IOException(write ? "Failed to create file" : "Failed to open file for reading", path);
+        }
+        return fd;
+    }
+
+    void close_native(NativeFile file) noexcept
+    {
+        ::close(file);
+    }
+
+    std::uint64_t native_size(NativeFile file, const std::string& path)
+    {
+        struct stat info{};
+        if (::fstat(file, &info) != 0)
+        {
+            throw IOException("Failed to get file size", path);
+        }
+        return static_cast<std::uint64_t>(info.st_size);
+    }
+
+    void preallocate_native([[maybe_unused]] NativeFile file, [[maybe_unused]] std::uint64_t size) noexcept
+    {
+#ifdef __linux__
+        // 只分配空间，不改变文件大小；文件系统不支持时按普通写入处理
+        ::fallocate(file, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+#endif
+    }
 
-    if (!file)
+    bool truncate_native(NativeFile file, std::uint64_t size) noexcept
     {
-        throw std::runtime_error("Failed to open file for writing: "+ path);
+        return ::ftruncate(file, static_cast<off_t>(size)) == 0;
     }
 
-    file.write(reinterpret_cast<const char*>(data.data()), data.size());
-    if (!file)
+    bool sync_native(NativeFile file) noexcept
     {
-        throw std::runtime_error("Failed to write data to file: " + path);
+        return ::fsync(file) == 0;
+    }
+
+    void sync_directory_of(const std::string& path) noexcept
+    {
+        // 重命名本身也要落盘，否则断电后目录里可能仍是旧文件
+        auto directory = std::filesystem::path(path).parent_path();
+        if (directory.empty())
+        {
+            directory = ".";
+        }
+        const int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0)
+        {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+
+#endif
+
+    /**
+     * @brief 作用域内持有的文件句柄
+     */
+    class ScopedFile
+    {
+    public:
+        ScopedFile(const std::string& path, bool write) : file_(open_native(path, write)) {}
+        ~ScopedFile() { close_native(file_); }
+
+        ScopedFile(const ScopedFile&) = delete;
+        ScopedFile& operator=(const ScopedFile&) = delete;
+
+        [[nodiscard]] NativeFile get() const noexcept { return file_; }
+
+    private:
+        NativeFile file_;
+    };
+
+    /**
+     * @brief 通过 I/O 后端读写 data 对应的文件区间，处理部分传输
+     */
+    tinakit::async::Task<void> transfer_range(IoBackend& backend, NativeFile file, std::span<std::byte> data,
+                                              std::uint64_t offset, bool write, const std::string& path)
+    {
+        while (!data.empty())
+        {
+            IoRequest request;
+            request.file = file;
+            request.data = data.data();
+            request.size = data.size();
+            request.offset = offset;
+            request.write = write;
+            const std::int64_t transferred = co_await tinakit::core::submit_io(backend, request);
+            if (transferred <= 0)
+            {
+                throw IOException(write ? "Failed to write data to file" : "Failed to read data from file", path);
+            }
+            data = data.subspan(static_cast<std::size_t>(transferred));
+            offset += static_cast<std::uint64_t>(transferred);
+        }
+    }
+
+    /**
+     * @brief 把 data 切分为 IO_CHUNK_SIZE 的请求同时提交，等待全部完成
+     */
+    tinakit::async::Task<void> transfer_all(NativeFile file, std::span<std::byte> data, bool write,
+                                            const std::string& path)
+    {
+        if (data.empty())
+        {
+            co_return;
+        }
+        auto& backend = IoBackend::instance();
+        std::vector<tinakit::async::Task<void>> tasks;
+        tasks.reserve((data.size() + IO_CHUNK_SIZE - 1) / IO_CHUNK_SIZE);
+        for (std::size_t offset = 0; offset < data.size(); offset += IO_CHUNK_SIZE)
+        {
+            tasks.push_back(transfer_range(backend, file, data.subspan(offset, std::min(IO_CHUNK_SIZE, data.size() - offset)),
+                                           offset, write, path));
+        }
+        co_await tinakit::async::when_all(std::move(tasks));
     }
-    co_return;
+}
+
+tinakit::async::Task<void> tinakit::core::write_file_binary(const std::string& path, std::span<const std::byte> data)
+{
+    ScopedFile file(path, true);
+    // 写请求不会修改数据，I/O 请求的缓冲区统一为可写指针
+    co_await transfer_all(file.get(), {const_cast<std::byte*>(data.data()), data.size()}, true, path);
 }
 
 tinakit::async::Task<std::vector<std::byte>> tinakit::core::read_file_binary(const std::string& path)
 {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file) {
-        throw std::runtime_error("Failed to open file for reading: " + path);
+    ScopedFile file(path, false);
+    std::vector<std::byte> buffer(static_cast<std::size_t>(native_size(file.get(), path)));
+    co_await transfer_all(file.get(), buffer, false, path);
+    co_return buffer;
+}
+
+// ========================================
+// SourceBuffer
+// ========================================
+
+std::shared_ptr<const tinakit::core::SourceBuffer> tinakit::core::SourceBuffer::from_bytes(std::vector<std::byte> bytes)
+{
+    std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+    buffer->owned_ = std::move(bytes);
+    buffer->data_ = buffer->owned_.data();
+    buffer->size_ = buffer->owned_.size();
+    return buffer;
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<const tinakit::core::SourceBuffer> tinakit::core::SourceBuffer::map_file(const std::string& path)
+{
+    const std::wstring wide_path = std::filesystem::path(path).wstring();
+    HANDLE file = CreateFileW(wide_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw IOException("Failed to open file for mapping", path);
     }
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
 
-    std::vector<std::byte> buffer(size);
-    if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
-        throw std::runtime_error("Failed to read data from file: " + path);
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        throw IOException("Failed to get file size", path);
+    }
+    if (file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return from_bytes({});
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        throw IOException("Failed to create file mapping", path);
+    }
+    // 视图会保持映射对象存活，句柄可以立即关闭
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+    {
+        throw IOException("Failed to map file", path);
+    }
+
+    std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+    buffer->mapping_ = view;
+    buffer->data_ = static_cast<const std::byte*>(view);
+    buffer->size_ = static_cast<std::size_t>(file_size.QuadPart);
+    return buffer;
+}
+
+tinakit::core::SourceBuffer::~SourceBuffer()
+{
+    if (mapping_)
+    {
+        UnmapViewOfFile(mapping_);
+    }
+}
+
+#else
+
+std::shared_ptr<const tinakit::core::SourceBuffer> tinakit::core::SourceBuffer::map_file(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw IOException("Failed to open file for mapping", path);
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw IOException("Failed to get file size", path);
+    }
+    if (info.st_size == 0)
+    {
+        ::close(fd);
+        return from_bytes({});
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后不再需要文件描述符
+    ::close(fd);
+    if (address == MAP_FAILED)
+    {
+        throw IOException("Failed to map file", path);
+    }
+
+    std::shared_ptr<SourceBuffer> buffer(new SourceBuffer());
+    buffer->mapping_ = address;
+    buffer->data_ = static_cast<const std::byte*>(address);
+    buffer->size_ = size;
+    return buffer;
+}
+
+tinakit::core::SourceBuffer::~SourceBuffer()
+{
+    if (mapping_)
+    {
+        ::munmap(mapping_, size_);
+    }
+}
+
+#endif
+
+// ========================================
+// OutputFile
+// ========================================
+
+/**
+ * @brief 后台写入状态：顺序写入先合并到 staging，攒满后异步提交，调用方继续生成后续数据
+ */
+struct tinakit::core::OutputFile::WriteBehind
+{
+    struct PendingWrite
+    {
+        IoRequest request;
+        std::vector<std::byte> buffer;
+        WriteBehind* owner = nullptr;
+        bool done = false;
+    };
+
+    std::vector<std::byte> staging;
+    std::uint64_t staging_offset = 0;
+
+    std::mutex mutex;
+    std::condition_variable progress;
+    std::list<PendingWrite> pending;
+    std::size_t in_flight_bytes = 0;
+    bool failed = false;
+
+    static void on_complete(IoRequest& request) noexcept
+    {
+        auto& write = *static_cast<PendingWrite*>(request.context);
+        auto& owner = *write.owner;
+        std::lock_guard lock(owner.mutex);
+        // 普通文件的定位写入不会部分完成，出现时按失败处理
+        if (request.result != static_cast<std::int64_t>(request.size))
+        {
+            owner.failed = true;
+        }
+        owner.in_flight_bytes -= request.size;
+        write.done = true;
+        owner.progress.notify_all();
+    }
+
+    /**
+     * @brief 提交 buffer，在途数据超过上限时先等待；之前的写入已失败时返回 false
+     */
+    bool submit(NativeFile file, std::vector<std::byte> buffer, std::uint64_t offset)
+    {
+        std::unique_lock lock(mutex);
+        progress.wait(lock, [this] { return in_flight_bytes < MAX_IN_FLIGHT; });
+        pending.remove_if([](const PendingWrite& write) { return write.done; });
+        if (failed)
+        {
+            return false;
+        }
+
+        auto& write = pending.emplace_back();
+        write.buffer = std::move(buffer);
+        write.owner = this;
+        write.request.file = file;
+        write.request.data = write.buffer.data();
+        write.request.size = write.buffer.size();
+        write.request.offset = offset;
+        write.request.write = true;
+        write.request.context = &write;
+        write.request.on_complete = &WriteBehind::on_complete;
+        in_flight_bytes += write.request.size;
+        lock.unlock();
+        IoBackend::instance().submit(write.request);
+        return true;
+    }
+
+    /**
+     * @brief 等待所有已提交的写入完成，返回是否全部成功
+     */
+    bool drain()
+    {
+        std::unique_lock lock(mutex);
+        progress.wait(lock, [this] { return in_flight_bytes == 0; });
+        pending.clear();
+        return !failed;
+    }
+
+    static constexpr std::size_t STAGING_SIZE = 1024 * 1024;
+    static constexpr std::size_t MAX_IN_FLIGHT = 8 * STAGING_SIZE;
+};
+
+tinakit::core::OutputFile::OutputFile(const std::string& path, const FileWritePolicy& policy)
+    : path_(path), temp_path_(temp_path_for(path)), policy_(policy), file_(open_native(temp_path_, true)),
+      write_behind_(std::make_unique<WriteBehind>())
+{
+    if (policy_.preallocate > 0)
+    {
+        preallocate_native(file_, policy_.preallocate);
+    }
+}
+
+tinakit::core::OutputFile::~OutputFile()
+{
+    // 内核可能仍在读取在途写入的缓冲区
+    write_behind_->drain();
+    close();
+    if (!temp_path_.empty())
+    {
+        std::error_code ec;
+        std::filesystem::remove(temp_path_, ec);
+    }
+}
+
+void tinakit::core::OutputFile::write(std::span<const std::byte> data)
+{
+    auto& state = *write_behind_;
+    if (state.staging.empty())
+    {
+        state.staging_offset = position_;
+    }
+
+    const std::uint64_t staging_end = state.staging_offset + state.staging.size();
+    if (position_ == staging_end)
+    {
+        state.staging.insert(state.staging.end(), data.begin(), data.end());
+        if (state.staging.size() >= WriteBehind::STAGING_SIZE)
+        {
+            flush_staging();
+        }
+    }
+    else if (position_ >= state.staging_offset && position_ + data.size() <= staging_end)
+    {
+        // 回填尚未提交的数据（例如本地文件头），直接修改缓冲区
+        std::copy(data.begin(), data.end(), state.staging.begin() + static_cast<std::ptrdiff_t>(position_ - state.staging_offset));
+    }
+    else
+    {
+        // 回填已提交的区域：等待在途写入完成后再写，避免新旧数据乱序落盘
+        flush_staging();
+        if (!state.drain() || !state.submit(file_, std::vector<std::byte>(data.begin(), data.end()), position_) ||
+            !state.drain())
+        {
+            throw IOException("Failed to write file", temp_path_);
+        }
+    }
+
+    position_ += data.size();
+    size_ = std::max(size_, position_);
+}
+
+void tinakit::core::OutputFile::flush_staging()
+{
+    auto& state = *write_behind_;
+    if (state.staging.empty())
+    {
+        return;
+    }
+    std::vector<std::byte> buffer;
+    buffer.reserve(WriteBehind::STAGING_SIZE);
+    buffer.swap(state.staging);
+    if (!state.submit(file_, std::move(buffer), state.staging_offset))
+    {
+        throw IOException("Failed to write file", temp_path_);
+    }
+}
+
+void tinakit::core::OutputFile::commit()
+{
+    flush_staging();
+    bool ok = write_behind_->drain();
+    if (ok && policy_.preallocate > 0)
+    {
+        // 预分配的块在文件末尾之后也会保留，截断后才会释放
+        ok = truncate_native(file_, size_);
+    }
+    if (ok && policy_.sync)
+    {
+        ok = sync_native(file_);
+    }
+    close();
+    if (!ok)
+    {
+        throw IOException("Failed to write file", temp_path_);
+    }
+
+    replace_with_temp(temp_path_, path_);
+    temp_path_.clear();
+    if (policy_.sync)
+    {
+        sync_directory_of(path_);
+    }
+}
+
+void tinakit::core::OutputFile::close() noexcept
+{
+    if (open_)
+    {
+        close_native(file_);
+        open_ = false;
     }
-    co_return buffer;
 }
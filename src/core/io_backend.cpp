@@ -0,0 +1,398 @@
+/**
+ * @file io_backend.cpp
+ * @brief 异步文件 I/O 后端实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/core/io_backend.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#ifdef TINAKIT_HAS_IO_URING
+#include <atomic>
+#include <cstring>
+#include <semaphore>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace tinakit::core
+{
+    namespace
+    {
+        // 单次请求的最大长度，Windows 的 ReadFile/WriteFile 和 io_uring 的 len 都是 32 位
+        constexpr std::size_t MAX_REQUEST_SIZE = 1u << 30;
+
+        std::size_t io_thread_count()
+        {
+            return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 2, 8);
+        }
+
+        /**
+         * @brief 执行一次阻塞的定位读写，返回传输的字节数或负的错误码
+         */
+        std::int64_t transfer_blocking(const IoRequest& request)
+        {
+            const std::size_t size = std::min(request.size, MAX_REQUEST_SIZE);
+#ifdef _WIN32
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(request.offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(request.offset >> 32);
+            DWORD transferred = 0;
+            const BOOL ok = request.write
+                ? WriteFile(request.file, request.data, static_cast<DWORD>(size), &transferred, &overlapped)
+                : ReadFile(request.file, request.data, static_cast<DWORD>(size), &transferred, &overlapped);
+            if (!ok)
+            {
+                const DWORD error = GetLastError();
+                return error == ERROR_HANDLE_EOF ? 0 : -static_cast<std::int64_t>(error);
+            }
+            return transferred;
+#else
+            while (true)
+            {
+                const ssize_t transferred = request.write
+                    ? ::pwrite(request.file, request.data, size, static_cast<off_t>(request.offset))
+                    : ::pread(request.file, request.data, size, static_cast<off_t>(request.offset));
+                if (transferred >= 0)
+                {
+                    return transferred;
+                }
+                if (errno != EINTR)
+                {
+                    return -errno;
+                }
+            }
+#endif
+        }
+
+        /**
+         * @brief 在专用线程上执行阻塞读写
+         *
+         * 阻塞读写在专用线程上进行，不占用恢复协程的执行器；但完成后的协程仍需执行器线程，
+         * 因此不能在执行器线程上同步等待 I/O（所有线程都在等待时会死锁）。
+         */
+        class ThreadPoolBackend final : public IoBackend
+        {
+        public:
+            explicit ThreadPoolBackend(std::size_t threads) : IoBackend(threads)
+            {
+                workers_.reserve(threads);
+                for (std::size_t i = 0; i < threads; ++i)
+                {
+                    workers_.emplace_back([this] { worker_loop(); });
+                }
+            }
+
+            ~ThreadPoolBackend() override
+            {
+                {
+                    std::lock_guard lock(mutex_);
+                    stopping_ = true;
+                }
+                ready_.notify_all();
+                workers_.clear();
+            }
+
+            IoBackendKind kind() const noexcept override { return IoBackendKind::ThreadPool; }
+
+            void submit(IoRequest& request) override
+            {
+                {
+                    std::lock_guard lock(mutex_);
+                    queue_.push_back(&request);
+                }
+                ready_.notify_one();
+            }
+
+        private:
+            void worker_loop()
+            {
+                while (true)
+                {
+                    IoRequest* request = nullptr;
+                    {
+                        std::unique_lock lock(mutex_);
+                        ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                        // 退出前处理完已提交的请求
+                        if (queue_.empty())
+                        {
+                            return;
+                        }
+                        request = queue_.front();
+                        queue_.pop_front();
+                    }
+                    request->result = transfer_blocking(*request);
+                    request->on_complete(*request);
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable ready_;
+            std::deque<IoRequest*> queue_;
+            bool stopping_ = false;
+            std::vector<std::jthread> workers_;
+        };
+
+#ifdef TINAKIT_HAS_IO_URING
+        /**
+         * @brief 直接通过系统调用使用 io_uring，不依赖 liburing
+         *
+         * 提交由互斥锁串行化，每次提交后立即 io_uring_enter；专用的完成线程等待并收割完成事件。
+         * 在途请求数不超过提交队列长度，完成队列（内核分配为两倍长度）不会溢出。
+         */
+        class IoUringBackend final : public IoBackend
+        {
+        public:
+            IoUringBackend(std::size_t threads, unsigned entries) : IoBackend(threads), slots_(entries)
+            {
+                io_uring_params params{};
+                ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+                if (ring_fd_ < 0)
+                {
+                    throw IOException("Failed to create io_uring");
+                }
+
+                if (!map_rings(params) || !supports_read_write())
+                {
+                    release();
+                    throw IOException("io_uring does not support the required operations");
+                }
+                completion_thread_ = std::thread([this] { reap_completions(); });
+            }
+
+            ~IoUringBackend() override
+            {
+                // user_data 为 0 的空操作通知完成线程退出
+                push(IORING_OP_NOP, nullptr);
+                completion_thread_.join();
+                release();
+            }
+
+            IoBackendKind kind() const noexcept override { return IoBackendKind::IoUring; }
+
+            void submit(IoRequest& request) override
+            {
+                push(request.write ? IORING_OP_WRITE : IORING_OP_READ, &request);
+            }
+
+        private:
+            bool map_rings(const io_uring_params& params)
+            {
+                sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (single_mmap)
+                {
+                    sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+                }
+
+                sq_ring_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                  IORING_OFF_SQ_RING);
+                if (sq_ring_ == MAP_FAILED)
+                {
+                    sq_ring_ = nullptr;
+                    return false;
+                }
+                if (single_mmap)
+                {
+                    cq_ring_ = sq_ring_;
+                }
+                else
+                {
+                    cq_ring_ = ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                      IORING_OFF_CQ_RING);
+                    if (cq_ring_ == MAP_FAILED)
+                    {
+                        cq_ring_ = nullptr;
+                        return false;
+                    }
+                }
+                sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+                void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                                    IORING_OFF_SQES);
+                if (sqes == MAP_FAILED)
+                {
+                    return false;
+                }
+                sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+                auto* sq = static_cast<char*>(sq_ring_);
+                sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                auto* cq = static_cast<char*>(cq_ring_);
+                cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                return true;
+            }
+
+            /**
+             * @brief IORING_OP_READ/WRITE 需要 Linux 5.6，用探测接口确认
+             */
+            bool supports_read_write() const
+            {
+                constexpr unsigned ops = 256;
+                std::vector<std::byte> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+                auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+                if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe, ops) < 0)
+                {
+                    return false;
+                }
+                const auto supported = [probe](unsigned op)
+                {
+                    return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+                };
+                return supported(IORING_OP_READ) && supported(IORING_OP_WRITE);
+            }
+
+            void push(std::uint8_t opcode, IoRequest* request)
+            {
+                slots_.acquire();
+                std::lock_guard lock(submit_mutex_);
+                const unsigned tail = *sq_tail_;
+                const unsigned index = tail & sq_mask_;
+                io_uring_sqe& sqe = sqes_[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = opcode;
+                sqe.user_data = reinterpret_cast<std::uint64_t>(request);
+                if (request)
+                {
+                    sqe.fd = request->file;
+                    sqe.off = request->offset;
+                    sqe.addr = reinterpret_cast<std::uint64_t>(request->data);
+                    sqe.len = static_cast<std::uint32_t>(std::min(request->size, MAX_REQUEST_SIZE));
+                }
+                sq_array_[index] = index;
+                std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+
+                while (::syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) < 0)
+                {
+                    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    {
+                        throw IOException("Failed to submit io_uring request");
+                    }
+                }
+            }
+
+            void reap_completions()
+            {
+                while (true)
+                {
+                    ::syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+                    unsigned head = *cq_head_;
+                    const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+                    bool stop = false;
+                    for (; head != tail; ++head)
+                    {
+                        const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                        auto* request = reinterpret_cast<IoRequest*>(cqe.user_data);
+                        const std::int32_t result = cqe.res;
+                        slots_.release();
+                        if (!request)
+                        {
+                            stop = true;
+                            continue;
+                        }
+                        request->result = result;
+                        request->on_complete(*request);
+                    }
+                    std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+                    if (stop)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            void release() noexcept
+            {
+                if (sqes_)
+                {
+                    ::munmap(sqes_, sqes_size_);
+                }
+                if (cq_ring_ && cq_ring_ != sq_ring_)
+                {
+                    ::munmap(cq_ring_, cq_size_);
+                }
+                if (sq_ring_)
+                {
+                    ::munmap(sq_ring_, sq_size_);
+                }
+                ::close(ring_fd_);
+            }
+
+            int ring_fd_ = -1;
+            void* sq_ring_ = nullptr;
+            void* cq_ring_ = nullptr;
+            std::size_t sq_size_ = 0;
+            std::size_t cq_size_ = 0;
+            std::size_t sqes_size_ = 0;
+            io_uring_sqe* sqes_ = nullptr;
+            unsigned* sq_tail_ = nullptr;
+            unsigned* sq_array_ = nullptr;
+            unsigned sq_mask_ = 0;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned cq_mask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+
+            std::mutex submit_mutex_;
+            std::counting_semaphore<> slots_;
+            std::thread completion_thread_;
+        };
+#endif
+    }
+
+    IoBackend& IoBackend::instance()
+    {
+        static const std::unique_ptr<IoBackend> backend = []
+        {
+#ifdef TINAKIT_HAS_IO_URING
+            try
+            {
+                return create(IoBackendKind::IoUring);
+            }
+            catch (const IOException&)
+            {
+                // 内核不支持或被禁止（例如容器的 seccomp 策略）时回退到阻塞线程
+            }
+#endif
+            return create(IoBackendKind::ThreadPool);
+        }();
+        return *backend;
+    }
+
+    std::unique_ptr<IoBackend> IoBackend::create(IoBackendKind kind)
+    {
+        if (kind == IoBackendKind::IoUring)
+        {
+#ifdef TINAKIT_HAS_IO_URING
+            return std::make_unique<IoUringBackend>(io_thread_count(), 256);
+#else
+            throw IOException("io_uring support is not compiled in");
+#endif
+        }
+        return std::make_unique<ThreadPoolBackend>(io_thread_count());
+    }
+}
@@ -5,7 +5,13 @@
 #include "tinakit/core/openxml_archiver.hpp"
 #include "tinakit/core/io.hpp"
 #include "tinakit/core/exceptions.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <thread>
 
 extern "C" {
 #include <mz.h>
@@ -17,32 +23,549 @@ extern "C" {
 
 namespace tinakit::core
 {
+    namespace
+    {
+        /**
+         * @brief 以 64 位偏移只读访问 SourceBuffer 的 minizip 流
+         *
+         * minizip 的内存流只支持 int32_t 大小（2 GB），而映射的文件不需要也不能复制到可写缓冲区。
+         */
+        struct SourceStream
+        {
+            mz_stream stream;
+            const std::byte* data;
+            int64_t size;
+            int64_t position;
+        };
+
+        int32_t source_stream_open(void* stream, const char* path, int32_t mode)
+        {
+            (void)stream;
+            (void)path;
+            return (mode & MZ_OPEN_MODE_WRITE) ? MZ_SUPPORT_ERROR : MZ_OK;
+        }
+
+        int32_t source_stream_is_open(void* stream)
+        {
+            return static_cast<SourceStream*>(stream)->data ? MZ_OK : MZ_OPEN_ERROR;
+        }
+
+        int32_t source_stream_read(void* stream, void* buf, int32_t size)
+        {
+            auto* source = static_cast<SourceStream*>(stream);
+            const int64_t count = std::min<int64_t>(size, source->size - source->position);
+            if (count <= 0)
+            {
+                return 0;
+            }
+            std::memcpy(buf, source->data + source->position, static_cast<std::size_t>(count));
+            source->position += count;
+            return static_cast<int32_t>(count);
+        }
+
+        int32_t source_stream_write(void* stream, const void* buf, int32_t size)
+        {
+            (void)stream;
+            (void)buf;
+            (void)size;
+            return MZ_SUPPORT_ERROR;
+        }
+
+        int64_t source_stream_tell(void* stream)
+        {
+            return static_cast<SourceStream*>(stream)->position;
+        }
+
+        int32_t source_stream_seek(void* stream, int64_t offset, int32_t origin)
+        {
+            auto* source = static_cast<SourceStream*>(stream);
+            int64_t position = 0;
+            switch (origin)
+            {
+            case MZ_SEEK_SET:
+                position = offset;
+                break;
+            case MZ_SEEK_CUR:
+                position = source->position + offset;
+                break;
+            case MZ_SEEK_END:
+                position = source->size + offset;
+                break;
+            default:
+                return MZ_SEEK_ERROR;
+            }
+            if (position < 0 || position > source->size)
+            {
+                return MZ_SEEK_ERROR;
+            }
+            source->position = position;
+            return MZ_OK;
+        }
+
+        int32_t source_stream_close(void* stream)
+        {
+            (void)stream;
+            return MZ_OK;
+        }
+
+        int32_t source_stream_error(void* stream)
+        {
+            (void)stream;
+            return MZ_OK;
+        }
+
+        void* source_stream_create()
+        {
+            return nullptr;
+        }
+
+        void source_stream_delete(void** stream)
+        {
+            delete static_cast<SourceStream*>(*stream);
+            *stream = nullptr;
+        }
+
+        mz_stream_vtbl source_stream_vtbl = {
+            source_stream_open, source_stream_is_open, source_stream_read, source_stream_write,
+            source_stream_tell, source_stream_seek, source_stream_close, source_stream_error,
+            source_stream_create, source_stream_delete, nullptr, nullptr};
+
+        /**
+         * @brief 创建读取 source 的 minizip 流，用 mz_stream_delete 释放
+         */
+        void* create_source_stream(const SourceBuffer& source)
+        {
+            auto* stream = new SourceStream{};
+            stream->stream.vtbl = &source_stream_vtbl;
+            stream->data = source.data();
+            stream->size = static_cast<int64_t>(source.size());
+            return stream;
+        }
+
+        /**
+         * @brief 把写入器的输出直接写到 OutputFile 或 std::ostream 的 minizip 流
+         *
+         * 写入器关闭条目时会回填本地头，因此目标必须支持随机写入。
+         */
+        struct SinkStream
+        {
+            mz_stream stream;
+            OutputFile* file;
+            std::ostream* out;
+            std::streamoff base;        // out 的起始位置，归档偏移从这里算起
+            std::streamoff out_position; // out 当前的写入位置，相同时不需要 seekp
+            int64_t size;
+            int64_t position;
+        };
+
+        int32_t sink_stream_open(void* stream, const char* path, int32_t mode)
+        {
+            (void)stream;
+            (void)path;
+            return (mode & MZ_OPEN_MODE_WRITE) ? MZ_OK : MZ_SUPPORT_ERROR;
+        }
+
+        int32_t sink_stream_is_open(void* stream)
+        {
+            auto* sink = static_cast<SinkStream*>(stream);
+            return sink->file || sink->out ? MZ_OK : MZ_OPEN_ERROR;
+        }
+
+        int32_t sink_stream_read(void* stream, void* buf, int32_t size)
+        {
+            (void)stream;
+            (void)buf;
+            (void)size;
+            return MZ_SUPPORT_ERROR;
+        }
+
+        int32_t sink_stream_write(void* stream, const void* buf, int32_t size)
+        {
+            auto* sink = static_cast<SinkStream*>(stream);
+            const auto* data = static_cast<const std::byte*>(buf);
+            if (sink->file)
+            {
+                try
+                {
+                    sink->file->seek(static_cast<std::uint64_t>(sink->position));
+                    sink->file->write({data, static_cast<std::size_t>(size)});
+                }
+                catch (const std::exception&)
+                {
+                    return MZ_WRITE_ERROR;
+                }
+            }
+            else
+            {
+                const std::streamoff target = sink->base + sink->position;
+                if (target != sink->out_position && !sink->out->seekp(target))
+                {
+                    return MZ_WRITE_ERROR;
+                }
+                if (!sink->out->write(reinterpret_cast<const char*>(data), size))
+                {
+                    return MZ_WRITE_ERROR;
+                }
+                sink->out_position = target + size;
+            }
+            sink->position += size;
+            sink->size = std::max(sink->size, sink->position);
+            return size;
+        }
+
+        int64_t sink_stream_tell(void* stream)
+        {
+            return static_cast<SinkStream*>(stream)->position;
+        }
+
+        int32_t sink_stream_seek(void* stream, int64_t offset, int32_t origin)
+        {
+            auto* sink = static_cast<SinkStream*>(stream);
+            int64_t position = 0;
+            switch (origin)
+            {
+            case MZ_SEEK_SET:
+                position = offset;
+                break;
+            case MZ_SEEK_CUR:
+                position = sink->position + offset;
+                break;
+            case MZ_SEEK_END:
+                position = sink->size + offset;
+                break;
+            default:
+                return MZ_SEEK_ERROR;
+            }
+            if (position < 0 || position > sink->size)
+            {
+                return MZ_SEEK_ERROR;
+            }
+            sink->position = position;
+            return MZ_OK;
+        }
+
+        void sink_stream_delete(void** stream)
+        {
+            delete static_cast<SinkStream*>(*stream);
+            *stream = nullptr;
+        }
+
+        // 关闭、错误和创建回调与源流一样都是空操作
+        mz_stream_vtbl sink_stream_vtbl = {
+            sink_stream_open, sink_stream_is_open, sink_stream_read, sink_stream_write,
+            sink_stream_tell, sink_stream_seek, source_stream_close, source_stream_error,
+            source_stream_create, sink_stream_delete, nullptr, nullptr};
+
+        /**
+         * @brief 创建写入 file 或 out 的 minizip 流，用 mz_stream_delete 释放
+         */
+        void* create_sink_stream(OutputFile* file, std::ostream* out)
+        {
+            auto* stream = new SinkStream{};
+            stream->stream.vtbl = &sink_stream_vtbl;
+            stream->file = file;
+            stream->out = out;
+            if (out)
+            {
+                stream->base = std::max<std::streamoff>(out->tellp(), 0);
+                stream->out_position = stream->base;
+            }
+            return stream;
+        }
+
+        /**
+         * @brief 在写入器中按 profile 打开条目，不支持 DEFLATE 时回退到 STORE
+         * @param uncompressed_size 未压缩大小，未知时为 0（此时使用 zip64 数据描述符）
+         */
+        int32_t open_writer_entry(void* writer, const std::string& filename, uint64_t uncompressed_size,
+                                  CompressionProfile profile)
+        {
+            mz_zip_file file_info = {};
+            file_info.filename = filename.c_str();
+            file_info.uncompressed_size = uncompressed_size;
+            file_info.compression_method = profile == CompressionProfile::Store ? MZ_COMPRESS_METHOD_STORE
+                                                                                : MZ_COMPRESS_METHOD_DEFLATE;
+            mz_zip_writer_set_compress_level(writer, static_cast<int16_t>(deflate_level(profile)));
+
+            int32_t status = mz_zip_writer_entry_open(writer, &file_info);
+            if (status == MZ_SUPPORT_ERROR)
+            {
+                file_info.compression_method = MZ_COMPRESS_METHOD_STORE;
+                status = mz_zip_writer_entry_open(writer, &file_info);
+            }
+            return status;
+        }
+
+        /**
+         * @brief 在写入器中打开一个原始 DEFLATE 条目，内容由调用方压缩
+         * @param uncompressed_size 未压缩大小，未知时为 0（此时本地头使用 zip64）
+         */
+        int32_t open_raw_entry(void* writer, const std::string& filename, uint64_t uncompressed_size, int level)
+        {
+            void* zip = nullptr;
+            if (mz_zip_writer_get_zip_handle(writer, &zip) != MZ_OK || !zip)
+            {
+                return MZ_PARAM_ERROR;
+            }
+
+            mz_zip_file file_info = {};
+            file_info.filename = filename.c_str();
+            file_info.uncompressed_size = uncompressed_size;
+            file_info.compression_method = MZ_COMPRESS_METHOD_DEFLATE;
+            // 级别只用于本地头中的压缩选项标志
+            return mz_zip_entry_write_open(zip, &file_info, static_cast<int16_t>(level), 1, nullptr);
+        }
+
+        /**
+         * @brief 向原始条目写入已压缩的数据
+         */
+        int32_t write_raw_entry(void* writer, std::span<const std::byte> data)
+        {
+            void* zip = nullptr;
+            mz_zip_writer_get_zip_handle(writer, &zip);
+            while (!data.empty())
+            {
+                const auto chunk = std::min<std::size_t>(data.size(), INT32_MAX);
+                const int32_t written = mz_zip_entry_write(zip, data.data(), static_cast<int32_t>(chunk));
+                if (written < 0)
+                {
+                    return written;
+                }
+                data = data.subspan(static_cast<std::size_t>(written));
+            }
+            return MZ_OK;
+        }
+
+        /**
+         * @brief 结束原始条目，写入未压缩大小和 CRC（本地头会被回填）
+         */
+        int32_t close_raw_entry(void* writer, const DeflatedData& written)
+        {
+            void* zip = nullptr;
+            mz_zip_writer_get_zip_handle(writer, &zip);
+            return mz_zip_entry_close_raw(zip, static_cast<int64_t>(written.uncompressed_size), written.crc);
+        }
+
+        /**
+         * @brief 按索引直接定位并打开条目，不扫描中央目录
+         */
+        int32_t open_indexed_entry(void* zip, const ArchiveEntry& entry)
+        {
+            if (int32_t status = mz_zip_goto_entry(zip, entry.directory_offset); status != MZ_OK)
+            {
+                return status;
+            }
+            return mz_zip_entry_read_open(zip, 0, nullptr);
+        }
+
+        /**
+         * @brief 把打开的条目读满 buffer，返回读取的字节数或负的错误码
+         */
+        int64_t read_open_entry(void* zip, std::span<std::byte> buffer)
+        {
+            std::size_t total = 0;
+            while (total < buffer.size())
+            {
+                const auto chunk = std::min<std::size_t>(buffer.size() - total, INT32_MAX);
+                const int32_t bytes_read = mz_zip_entry_read(zip, buffer.data() + total, static_cast<int32_t>(chunk));
+                if (bytes_read < 0)
+                {
+                    return bytes_read;
+                }
+                if (bytes_read == 0)
+                {
+                    break;
+                }
+                total += static_cast<std::size_t>(bytes_read);
+            }
+            return static_cast<int64_t>(total);
+        }
+
+        /**
+         * @brief 从 EntryReader 拉取数据的 streambuf
+         */
+        class EntryStreamBuf : public std::streambuf
+        {
+        public:
+            explicit EntryStreamBuf(EntryReader reader) : reader_(std::move(reader)) {}
+
+        protected:
+            int_type underflow() override
+            {
+                if (gptr() < egptr())
+                {
+                    return traits_type::to_int_type(*gptr());
+                }
+                const std::string_view chunk = reader_.next_chunk();
+                if (chunk.empty())
+                {
+                    return traits_type::eof();
+                }
+                // 只读的获取区，不会通过这些指针写入
+                char* begin = const_cast<char*>(chunk.data());
+                setg(begin, begin, begin + chunk.size());
+                return traits_type::to_int_type(*gptr());
+            }
+
+        private:
+            EntryReader reader_;
+        };
+
+        /**
+         * @brief 拥有 EntryStreamBuf 的输入流
+         */
+        class EntryInputStream : public std::istream
+        {
+        public:
+            explicit EntryInputStream(EntryReader reader)
+                : std::istream(nullptr), buffer_(std::move(reader))
+            {
+                rdbuf(&buffer_);
+            }
+
+        private:
+            EntryStreamBuf buffer_;
+        };
+    } // namespace
+
+    // ========================================
+    // EntryReader
+    // ========================================
+
+    class EntryReader::Impl
+    {
+    public:
+        explicit Impl(std::size_t chunk_size) : chunk_size_(std::max<std::size_t>(chunk_size, 1)) {}
+
+        ~Impl()
+        {
+            if (zip_)
+            {
+                if (entry_open_)
+                {
+                    mz_zip_entry_close(zip_);
+                }
+                mz_zip_close(zip_);
+                mz_zip_delete(&zip_);
+            }
+            mz_stream_delete(&stream_);
+        }
+
+        Impl(const Impl&) = delete;
+        Impl& operator=(const Impl&) = delete;
+
+        void open(std::shared_ptr<const SourceBuffer> source, const std::string& filename, const ArchiveEntry& entry)
+        {
+            source_ = std::move(source);
+            size_ = entry.uncompressed_size;
+            zip_ = mz_zip_create();
+            if (!zip_)
+            {
+                throw TinaKitException("Failed to create zip handle.", "OpenXmlArchiver.open_entry_reader");
+            }
+            stream_ = create_source_stream(*source_);
+            if (int32_t status = mz_zip_open(zip_, stream_, MZ_OPEN_MODE_READ); status != MZ_OK)
+            {
+                throw TinaKitException("Failed to open zip archive from buffer. Status: " + std::to_string(status),
+                                       "OpenXmlArchiver.open_entry_reader");
+            }
+            if (int32_t status = open_indexed_entry(zip_, entry); status != MZ_OK)
+            {
+                throw TinaKitException("Failed to open entry for reading: " + filename + ". Status: " + std::to_string(status),
+                                       "OpenXmlArchiver.open_entry_reader");
+            }
+            entry_open_ = true;
+            buffer_.resize(static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size_, std::max<std::uint64_t>(size_, 1))));
+        }
+
+        void open_pending(const std::vector<std::byte>& content)
+        {
+            const auto* data = reinterpret_cast<const char*>(content.data());
+            buffer_.assign(data, data + content.size());
+            size_ = content.size();
+        }
+
+        std::string_view next_chunk()
+        {
+            if (!zip_)
+            {
+                // 内存中的条目按块切分返回
+                const std::size_t count = std::min(chunk_size_, buffer_.size() - position_);
+                const std::string_view chunk(buffer_.data() + position_, count);
+                position_ += count;
+                return chunk;
+            }
+            if (!entry_open_)
+            {
+                return {};
+            }
+
+            const int32_t bytes_read = mz_zip_entry_read(zip_, buffer_.data(), static_cast<int32_t>(buffer_.size()));
+            if (bytes_read <= 0)
+            {
+                // 读取结束或出错后立即释放解压状态，完整读取时关闭条目会校验 CRC
+                const int32_t close_status = mz_zip_entry_close(zip_);
+                entry_open_ = false;
+                const int32_t status = bytes_read < 0 ? bytes_read : close_status;
+                if (status != MZ_OK)
+                {
+                    throw TinaKitException("Failed to read entry content. Status: " + std::to_string(status),
+                                           "EntryReader.next_chunk");
+                }
+                return {};
+            }
+            return std::string_view(buffer_.data(), static_cast<std::size_t>(bytes_read));
+        }
+
+        std::uint64_t size() const noexcept { return size_; }
+
+    private:
+        std::size_t chunk_size_;
+        std::shared_ptr<const SourceBuffer> source_;
+        void* stream_ = nullptr;
+        void* zip_ = nullptr;
+        bool entry_open_ = false;
+        std::vector<char> buffer_;
+        std::size_t position_ = 0;
+        std::uint64_t size_ = 0;
+    };
+
+    EntryReader::EntryReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+    EntryReader::EntryReader(EntryReader&&) noexcept = default;
+
+    EntryReader& EntryReader::operator=(EntryReader&&) noexcept = default;
+
+    EntryReader::~EntryReader() = default;
+
+    std::string_view EntryReader::next_chunk()
+    {
+        return impl_ ? impl_->next_chunk() : std::string_view();
+    }
+
+    std::uint64_t EntryReader::size() const noexcept
+    {
+        return impl_ ? impl_->size() : 0;
+    }
+
     OpenXmlArchiver::~OpenXmlArchiver()
     {
         close_handles();
     }
 
-    async::Task<OpenXmlArchiver> OpenXmlArchiver::open_from_file(const std::string& path)
+    async::Task<OpenXmlArchiver> OpenXmlArchiver::open_from_file(const std::string& path, SourceMode mode)
     {
         OpenXmlArchiver archiver;
-        archiver.reader_handle_.reset(mz_zip_reader_create());
-        if (!archiver.reader_handle_)
+        if (mode == SourceMode::MemoryMap)
         {
-            throw TinaKitException("Failed to create zip reader handle.", "OpenXmlArchiver::open_from_file");
+            archiver.source_buffer_ = SourceBuffer::map_file(path);
         }
-
-        archiver.source_buffer_ = co_await core::read_file_binary(path);
-
-        // 使用 mz_zip_reader_open_buffer 而不是创建临时流
-        if (int32_t status = mz_zip_reader_open_buffer(archiver.reader_handle_.get(),
-                                                       reinterpret_cast<uint8_t*>(archiver.source_buffer_.data()),
-                                                       static_cast<int32_t>(archiver.source_buffer_.size()), 0);
-            status != MZ_OK)
+        else
         {
-            throw TinaKitException("Failed to open zip archive from buffer. Status: " + std::to_string(status),
-                                   "OpenXmlArchiver::open_from_file");
+            archiver.source_buffer_ = SourceBuffer::from_bytes(co_await core::read_file_binary(path));
         }
 
+        archiver.open_source_reader("OpenXmlArchiver::open_from_file");
         co_await archiver.list_files();
         co_return archiver;
     }
@@ -50,63 +573,96 @@ namespace tinakit::core
     OpenXmlArchiver OpenXmlArchiver::open_from_memory(std::vector<std::byte> buffer)
     {
         OpenXmlArchiver archiver;
-        archiver.source_buffer_ = std::move(buffer);
-        if (archiver.source_buffer_.empty())
+        if (buffer.empty())
         {
             return create_in_memory_writer();
         }
+        archiver.source_buffer_ = SourceBuffer::from_bytes(std::move(buffer));
 
-        archiver.reader_handle_.reset(mz_zip_reader_create());
-        if (!archiver.reader_handle_)
-        {
-            throw TinaKitException("Failed to create zip reader handle.", "OpenXmlArchiver::open_from_memory");
-        }
-
-        // 使用 mz_zip_reader_open_buffer 而不是创建临时流
-        if (int32_t status = mz_zip_reader_open_buffer(archiver.reader_handle_.get(),
-                                                       reinterpret_cast<uint8_t*>(archiver.source_buffer_.data()),
-                                                       static_cast<int32_t>(archiver.source_buffer_.size()), 0);
-            status != MZ_OK)
-        {
-            throw TinaKitException("Failed to open zip archive from buffer. Status: " + std::to_string(status),
-                                   "OpenXmlArchiver::open_from_memory");
-        }
+        archiver.open_source_reader("OpenXmlArchiver::open_from_memory");
         async::sync_wait(archiver.list_files());
 
         return archiver;
     }
 
-    OpenXmlArchiver OpenXmlArchiver::create_in_memory_writer()
+    void OpenXmlArchiver::open_source_reader(const char* context)
     {
-        OpenXmlArchiver archiver;
-        archiver.writer_handle_.reset(mz_zip_writer_create());
-        if (!archiver.writer_handle_)
+        // 先释放旧的读取器，它可能还在使用旧的流
+        reader_handle_.reset(mz_zip_reader_create());
+        if (!reader_handle_)
+        {
+            throw TinaKitException("Failed to create zip reader handle.", context);
+        }
+
+        reader_stream_.reset(create_source_stream(*source_buffer_));
+        if (int32_t status = mz_zip_reader_open(reader_handle_.get(), reader_stream_.get()); status != MZ_OK)
         {
-            throw TinaKitException("Failed to create zip writer handle.", "OpenXmlArchiver::create_in_memory_writer");
+            reader_handle_.reset();
+            throw TinaKitException("Failed to open zip archive. Status: " + std::to_string(status), context);
         }
 
-        archiver.memory_stream_handle_.reset(mz_stream_mem_create());
-        if (!archiver.memory_stream_handle_)
+        // 只扫描一次中央目录，之后按名称直接定位条目
+        entry_index_.clear();
+        void* zip = nullptr;
+        mz_zip_reader_get_zip_handle(reader_handle_.get(), &zip);
+        for (int32_t status = mz_zip_goto_first_entry(zip); status == MZ_OK; status = mz_zip_goto_next_entry(zip))
         {
-            throw TinaKitException("Failed to create memory stream for writer.",
-                                   "OpenXmlArchiver::create_in_memory_writer");
+            mz_zip_file* file_info = nullptr;
+            if (mz_zip_entry_get_info(zip, &file_info) != MZ_OK || !file_info || !file_info->filename)
+            {
+                continue;
+            }
+            ArchiveEntry entry;
+            entry.directory_offset = mz_zip_get_entry(zip);
+            entry.header_offset = file_info->disk_offset;
+            entry.compressed_size = static_cast<std::uint64_t>(file_info->compressed_size);
+            entry.uncompressed_size = static_cast<std::uint64_t>(file_info->uncompressed_size);
+            entry.crc = file_info->crc;
+            entry.compression_method = file_info->compression_method;
+            entry_index_.try_emplace(file_info->filename, entry);
         }
+    }
 
-        // 关键修复：先打开内存流
-        if (int32_t status = mz_stream_mem_open(archiver.memory_stream_handle_.get(), nullptr, MZ_OPEN_MODE_CREATE);
-            status != MZ_OK)
+    const ArchiveEntry* OpenXmlArchiver::find_entry(const std::string& filename) const
+    {
+        if (!reader_handle_ || files_to_remove_.count(filename))
         {
-            throw TinaKitException("Failed to open memory stream. Status: " + std::to_string(status),
-                                   "OpenXmlArchiver::create_in_memory_writer");
+            return nullptr;
         }
+        auto it = entry_index_.find(filename);
+        return it != entry_index_.end() ? &it->second : nullptr;
+    }
 
-        if (int32_t status = mz_zip_writer_open(archiver.writer_handle_.get(), archiver.memory_stream_handle_.get(), 0);
-            status != MZ_OK)
+    const ArchiveEntry& OpenXmlArchiver::require_entry(const std::string& filename, const char* context) const
+    {
+        const ArchiveEntry* entry = find_entry(filename);
+        if (!entry)
         {
-            throw TinaKitException("Failed to open zip writer on memory stream. Status: " + std::to_string(status),
-                                   "OpenXmlArchiver::create_in_memory_writer");
+            throw TinaKitException("File not found in archive: " + filename, context);
         }
+        return *entry;
+    }
+
+    OpenXmlArchiver OpenXmlArchiver::create_in_memory_writer()
+    {
+        OpenXmlArchiver archiver;
+        archiver.open_writer("OpenXmlArchiver::create_in_memory_writer");
+        return archiver;
+    }
 
+    OpenXmlArchiver OpenXmlArchiver::create_file_writer(const std::string& path, FileWritePolicy policy)
+    {
+        OpenXmlArchiver archiver;
+        archiver.output_target_.emplace(path, policy);
+        archiver.open_writer("OpenXmlArchiver::create_file_writer");
+        return archiver;
+    }
+
+    OpenXmlArchiver OpenXmlArchiver::create_stream_writer(std::ostream& stream)
+    {
+        OpenXmlArchiver archiver;
+        archiver.output_stream_ = &stream;
+        archiver.open_writer("OpenXmlArchiver::create_stream_writer");
         return archiver;
     }
 
@@ -125,18 +681,9 @@ namespace tinakit::core
 
 
         std::set<std::string> files;
-        if (int32_t status = mz_zip_reader_goto_first_entry(reader_handle_.get()); status == MZ_OK)
+        for (const auto& [filename, entry] : entry_index_)
         {
-            do
-            {
-                mz_zip_file* file_info = nullptr;
-
-                if (mz_zip_reader_entry_get_info(reader_handle_.get(), &file_info) == MZ_OK && file_info)
-                {
-                    files.insert(file_info->filename);
-                }
-            }
-            while (mz_zip_reader_goto_next_entry(reader_handle_.get()) == MZ_OK);
+            files.insert(filename);
         }
 
         const_cast<OpenXmlArchiver*>(this)->current_files_ = files;
@@ -145,6 +692,11 @@ namespace tinakit::core
 
     async::Task<bool> OpenXmlArchiver::has_file(const std::string& filename) const
     {
+        // 未修改时直接查索引
+        if (!writer_handle_ && files_to_remove_.empty() && pending_new_files_.empty() && reader_handle_)
+        {
+            co_return entry_index_.count(filename) > 0;
+        }
         if (current_files_.empty())
         {
             co_await list_files();
@@ -172,38 +724,27 @@ namespace tinakit::core
             throw TinaKitException("Archive is not open for reading.", "OpenXmlArchiver.read_file");
         }
 
-        if (int32_t status = mz_zip_reader_locate_entry(reader_handle_.get(), filename.c_str(), 0); status != MZ_OK)
-        {
-            throw TinaKitException("File not found in archive: " + filename, "OpenXmlArchiver.read_file");
-        }
-
-        mz_zip_file* file_info = nullptr;
-        if (mz_zip_reader_entry_get_info(reader_handle_.get(), &file_info) != MZ_OK || !file_info) {
-            throw TinaKitException("Failed to get file info for: " + filename, "OpenXmlArchiver.read_file");
-        }
+        const ArchiveEntry& entry = require_entry(filename, "OpenXmlArchiver.read_file");
+        void* zip = nullptr;
+        mz_zip_reader_get_zip_handle(reader_handle_.get(), &zip);
 
         // 打开条目进行读取
-        if (int32_t status = mz_zip_reader_entry_open(reader_handle_.get()); status != MZ_OK) {
+        if (int32_t status = open_indexed_entry(zip, entry); status != MZ_OK) {
             throw TinaKitException("Failed to open entry for reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file");
         }
 
-        std::vector<std::byte> buffer(file_info->uncompressed_size);
+        std::vector<std::byte> buffer(entry.uncompressed_size);
 
-        try {
-            if (int32_t status = mz_zip_reader_entry_read(reader_handle_.get(), buffer.data(), static_cast<int32_t>(buffer.size())); status < 0)
-            {
-                throw TinaKitException(
-                    "Failed to read file content for: " + filename + ". Status: " + std::to_string(status),
-                    "OpenXmlArchiver.read_file");
-            }
-        } catch (...) {
-            // 确保关闭条目
-            mz_zip_reader_entry_close(reader_handle_.get());
-            throw;
+        const int64_t bytes_read = read_open_entry(zip, buffer);
+        if (bytes_read < 0 || static_cast<std::uint64_t>(bytes_read) != buffer.size()) {
+            mz_zip_entry_close(zip);
+            throw TinaKitException(
+                "Failed to read file content for: " + filename + ". Status: " + std::to_string(bytes_read),
+                "OpenXmlArchiver.read_file");
         }
 
-        // 关闭条目
-        if (int32_t status = mz_zip_reader_entry_close(reader_handle_.get()); status != MZ_OK) {
+        // 关闭条目（完整读取时校验 CRC）
+        if (int32_t status = mz_zip_entry_close(zip); status != MZ_OK) {
             throw TinaKitException("Failed to close entry after reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file");
         }
 
@@ -212,6 +753,11 @@ namespace tinakit::core
 
     async::Task<void> OpenXmlArchiver::add_file(const std::string& filename, std::vector<std::byte> content)
     {
+        if (written_files_.count(filename))
+        {
+            throw TinaKitException("Entry has already been written: " + filename, "OpenXmlArchiver.add_file");
+        }
+
         // 如果文件已存在，标记为需要移除，这样在复制时会跳过原文件
         // 这必须在 transition_to_writer_mode_if_needed() 之前完成
         if (current_files_.empty()) {
@@ -235,6 +781,11 @@ namespace tinakit::core
 
     async::Task<void> OpenXmlArchiver::add_file_stream(const std::string& filename, std::istream& stream, size_t estimated_size)
     {
+        if (written_files_.count(filename))
+        {
+            throw TinaKitException("Entry has already been written: " + filename, "OpenXmlArchiver.add_file");
+        }
+
         // 确保 current_files_ 已填充
         if (current_files_.empty()) {
             co_await list_files();
@@ -299,64 +850,226 @@ namespace tinakit::core
             throw TinaKitException("Archive is not open for reading.", "OpenXmlArchiver.read_file_stream");
         }
 
-        if (int32_t status = mz_zip_reader_locate_entry(reader_handle_.get(), filename.c_str(), 0); status != MZ_OK)
+        const ArchiveEntry& entry = require_entry(filename, "OpenXmlArchiver.read_file_stream");
+        void* zip = nullptr;
+        mz_zip_reader_get_zip_handle(reader_handle_.get(), &zip);
+
+        // 打开条目进行读取
+        if (int32_t status = open_indexed_entry(zip, entry); status != MZ_OK) {
+            throw TinaKitException("Failed to open entry for reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file_stream");
+        }
+
+        // 分块读取并写入流
+        constexpr size_t chunk_size = 64 * 1024; // 64KB 块
+        std::vector<std::byte> buffer(std::min<std::uint64_t>(chunk_size, entry.uncompressed_size));
+        std::uint64_t remaining = entry.uncompressed_size;
+        while (remaining > 0) {
+            const auto to_read = static_cast<std::size_t>(std::min<std::uint64_t>(buffer.size(), remaining));
+            const int64_t bytes_read = read_open_entry(zip, std::span<std::byte>(buffer.data(), to_read));
+            if (bytes_read <= 0) {
+                mz_zip_entry_close(zip);
+                throw TinaKitException(
+                    "Failed to read file content for: " + filename + ". Status: " + std::to_string(bytes_read),
+                    "OpenXmlArchiver.read_file_stream");
+            }
+
+            // 写入到输出流
+            stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(bytes_read));
+            remaining -= static_cast<std::uint64_t>(bytes_read);
+        }
+
+        // 关闭条目
+        if (int32_t status = mz_zip_entry_close(zip); status != MZ_OK) {
+            throw TinaKitException("Failed to close entry after reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file_stream");
+        }
+
+        co_return;
+    }
+
+    async::Task<std::unique_ptr<std::istream>> OpenXmlArchiver::open_entry_stream(
+        const std::string& filename, std::size_t buffer_size) const
+    {
+        co_return std::make_unique<EntryInputStream>(co_await open_entry_reader(filename, buffer_size));
+    }
+
+    async::Task<EntryReader> OpenXmlArchiver::open_entry_reader(const std::string& filename,
+                                                                std::size_t chunk_size) const
+    {
+        auto impl = std::make_unique<EntryReader::Impl>(chunk_size);
+
+        // 新添加且尚未保存的文件已经在内存中
+        if (auto it = pending_new_files_.find(filename); it != pending_new_files_.end())
         {
-            throw TinaKitException("File not found in archive: " + filename, "OpenXmlArchiver.read_file_stream");
+            impl->open_pending(it->second);
+            co_return EntryReader(std::move(impl));
         }
 
-        mz_zip_file* file_info = nullptr;
-        if (mz_zip_reader_entry_get_info(reader_handle_.get(), &file_info) != MZ_OK || !file_info) {
-            throw TinaKitException("Failed to get file info for: " + filename, "OpenXmlArchiver.read_file_stream");
+        if (!reader_handle_ || !source_buffer_)
+        {
+            throw TinaKitException("Archive is not open for reading.", "OpenXmlArchiver.open_entry_reader");
         }
+        const ArchiveEntry& entry = require_entry(filename, "OpenXmlArchiver.open_entry_reader");
+        impl->open(source_buffer_, filename, entry);
+        co_return EntryReader(std::move(impl));
+    }
 
-        // 打开条目进行读取
-        if (int32_t status = mz_zip_reader_entry_open(reader_handle_.get()); status != MZ_OK) {
-            throw TinaKitException("Failed to open entry for reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file_stream");
+    async::Task<void> OpenXmlArchiver::begin_entry(const std::string& filename)
+    {
+        if (open_entry_)
+        {
+            throw TinaKitException("Entry '" + *open_entry_ + "' is still being written.",
+                                   "OpenXmlArchiver.begin_entry");
+        }
+        if (written_files_.count(filename))
+        {
+            throw TinaKitException("Entry has already been written: " + filename, "OpenXmlArchiver.begin_entry");
         }
 
-        try {
-            // 分块读取并写入流
-            constexpr size_t chunk_size = 64 * 1024; // 64KB 块
-            std::vector<std::byte> buffer(chunk_size);
+        if (current_files_.empty())
+        {
+            co_await list_files();
+        }
+        // 原有条目和待写入的旧内容都会被这次写入取代
+        if (current_files_.count(filename))
+        {
+            files_to_remove_.insert(filename);
+        }
+        pending_new_files_.erase(filename);
 
-            size_t total_read = 0;
-            size_t remaining = file_info->uncompressed_size;
+        co_await transition_to_writer_mode_if_needed();
 
-            while (remaining > 0) {
-                size_t to_read = std::min(chunk_size, remaining);
+        // 不压缩的条目没有可并行的工作，直接交给写入器
+        const CompressionProfile profile = write_profile_.profile_for(filename);
+        const bool raw = deflate_pool_ && profile != CompressionProfile::Store;
+        const int32_t status = raw ? open_raw_entry(writer_handle_.get(), filename, 0, deflate_level(profile))
+                                   : open_writer_entry(writer_handle_.get(), filename, 0, profile);
+        if (status != MZ_OK)
+        {
+            throw TinaKitException("Failed to open entry for file '" + filename + "'. Status: " + std::to_string(status),
+                                   "OpenXmlArchiver.begin_entry");
+        }
 
-                int32_t bytes_read = mz_zip_reader_entry_read(reader_handle_.get(), buffer.data(), static_cast<int32_t>(to_read));
-                if (bytes_read < 0) {
-                    throw TinaKitException(
-                        "Failed to read file content for: " + filename + ". Status: " + std::to_string(bytes_read),
-                        "OpenXmlArchiver.read_file_stream");
-                }
+        raw_entry_ = raw;
+        raw_level_ = deflate_level(profile);
+        raw_pending_.clear();
+        raw_written_ = DeflatedData{};
+        open_entry_ = filename;
+        written_files_.insert(filename);
+        current_files_.insert(filename);
+    }
 
-                if (bytes_read == 0) {
-                    break; // 文件结束
-                }
+    async::Task<void> OpenXmlArchiver::write_entry(std::span<const std::byte> data)
+    {
+        if (!open_entry_)
+        {
+            throw TinaKitException("No entry is open for writing.", "OpenXmlArchiver.write_entry");
+        }
 
-                // 写入到输出流
-                const auto* char_data = reinterpret_cast<const char*>(buffer.data());
-                stream.write(char_data, bytes_read);
+        if (raw_entry_)
+        {
+            // 积累够每个线程一个块后再并行压缩
+            raw_pending_.insert(raw_pending_.end(), data.begin(), data.end());
+            if (raw_pending_.size() >= deflate_block_size_ * deflate_threads_)
+            {
+                co_await flush_raw_entry(false);
+            }
+            co_return;
+        }
 
-                total_read += bytes_read;
-                remaining -= bytes_read;
+        while (!data.empty())
+        {
+            // minizip 的单次写入长度为 int32_t
+            const auto chunk = std::min<std::size_t>(data.size(), INT32_MAX);
+            int32_t written = mz_zip_writer_entry_write(writer_handle_.get(), data.data(), static_cast<int32_t>(chunk));
+            if (written < 0)
+            {
+                throw TinaKitException("Failed to write content for file '" + *open_entry_ + "'. Status: " + std::to_string(written),
+                                       "OpenXmlArchiver.write_entry");
             }
-        } catch (...) {
-            // 确保关闭条目
-            mz_zip_reader_entry_close(reader_handle_.get());
-            throw;
+            data = data.subspan(static_cast<std::size_t>(written));
         }
+        co_return;
+    }
 
-        // 关闭条目
-        if (int32_t status = mz_zip_reader_entry_close(reader_handle_.get()); status != MZ_OK) {
-            throw TinaKitException("Failed to close entry after reading: " + filename + ". Status: " + std::to_string(status), "OpenXmlArchiver.read_file_stream");
+    async::Task<void> OpenXmlArchiver::end_entry()
+    {
+        if (!open_entry_)
+        {
+            throw TinaKitException("No entry is open for writing.", "OpenXmlArchiver.end_entry");
         }
 
+        const std::string filename = std::move(*open_entry_);
+        open_entry_.reset();
+        if (raw_entry_)
+        {
+            raw_entry_ = false;
+            co_await flush_raw_entry(true);
+            std::vector<std::byte>().swap(raw_pending_);
+            if (int32_t status = close_raw_entry(writer_handle_.get(), raw_written_); status != MZ_OK)
+            {
+                throw TinaKitException("Failed to close entry for file '" + filename + "'. Status: " + std::to_string(status),
+                                       "OpenXmlArchiver.end_entry");
+            }
+            co_return;
+        }
+        if (int32_t status = mz_zip_writer_entry_close(writer_handle_.get()); status != MZ_OK)
+        {
+            throw TinaKitException("Failed to close entry for file '" + filename + "'. Status: " + std::to_string(status),
+                                   "OpenXmlArchiver.end_entry");
+        }
         co_return;
     }
 
+    void OpenXmlArchiver::set_deflate_threads(std::size_t threads, std::size_t block_size)
+    {
+        if (open_entry_)
+        {
+            throw TinaKitException("Entry '" + *open_entry_ + "' is still being written.",
+                                   "OpenXmlArchiver.set_deflate_threads");
+        }
+        if (threads == 0)
+        {
+            threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        deflate_block_size_ = std::max<std::size_t>(block_size, 1);
+        if (threads == deflate_threads_)
+        {
+            return;
+        }
+        deflate_threads_ = threads;
+        deflate_pool_ = threads > 1 ? std::make_unique<async::ThreadPoolExecutor>(threads) : nullptr;
+    }
+
+    void OpenXmlArchiver::set_write_profile(WriteProfile profile)
+    {
+        write_profile_ = std::move(profile);
+    }
+
+    async::Task<void> OpenXmlArchiver::flush_raw_entry(bool final)
+    {
+        // 非最后一次只压缩完整的块，剩余部分留到下一批
+        const std::size_t size = final ? raw_pending_.size()
+                                       : raw_pending_.size() / deflate_block_size_ * deflate_block_size_;
+        if (size == 0 && !final)
+        {
+            co_return;
+        }
+
+        DeflatedData block = co_await deflate_parallel(*deflate_pool_, std::span<const std::byte>(raw_pending_.data(), size),
+                                                       raw_level_, deflate_block_size_, final);
+        if (int32_t status = write_raw_entry(writer_handle_.get(), block.bytes); status != MZ_OK)
+        {
+            throw TinaKitException("Failed to write content for file '" + open_entry_.value_or("") + "'. Status: " +
+                                   std::to_string(status), "OpenXmlArchiver.write_entry");
+        }
+        raw_pending_.erase(raw_pending_.begin(), raw_pending_.begin() + static_cast<std::ptrdiff_t>(size));
+
+        // 压缩数据已写出，只累计校验信息
+        block.bytes.clear();
+        raw_written_.append(block);
+    }
+
     async::Task<void> OpenXmlArchiver::remove_file(const std::string& filename)
     {
         if (current_files_.empty())
@@ -373,11 +1086,90 @@ namespace tinakit::core
         co_return;
     }
 
+    bool OpenXmlArchiver::set_output_file(const std::string& path, FileWritePolicy policy)
+    {
+        if (output_stream_)
+        {
+            return false;
+        }
+        if (output_target_)
+        {
+            // 已经打开的输出文件不能改变目标或策略
+            return output_target_->first == path;
+        }
+        if (writer_handle_)
+        {
+            if (open_entry_ || !written_files_.empty())
+            {
+                return false;
+            }
+            // 内存写入器中还没有任何条目，直接换成写入文件
+            writer_handle_.reset();
+            memory_stream_handle_.reset();
+            output_target_.emplace(path, policy);
+            open_writer("OpenXmlArchiver.set_output_file");
+            return true;
+        }
+        output_target_.emplace(path, policy);
+        return true;
+    }
+
     async::Task<void> OpenXmlArchiver::save_to_file(const std::string& path)
     {
-        auto memory_buffer = co_await save_to_memory();
+        if (output_target_ && output_target_->first != path)
+        {
+            throw TinaKitException("Archive is being written to another file: " + output_target_->first,
+                                   "OpenXmlArchiver::save_to_file");
+        }
+        if (output_target_ && (writer_handle_ || !pending_new_files_.empty() || !files_to_remove_.empty()))
+        {
+            // 条目已经写入临时文件，写完中央目录后替换目标文件
+            co_await finish_writer("OpenXmlArchiver::save_to_file");
+            writer_handle_.reset();
+            sink_stream_.reset();
+            output_target_.reset();
+            const auto output_file = std::move(output_file_);
+            output_file->commit();
+
+            current_files_.clear();
+            files_to_remove_.clear();
 
-        co_await core::write_file_binary(path, memory_buffer);
+            // 映射刚写入的文件以便继续读取
+            source_buffer_ = SourceBuffer::map_file(path);
+            open_source_reader("OpenXmlArchiver::save_to_file");
+            co_await list_files();
+            co_return;
+        }
+        output_target_.reset();
+
+        // 源文件仍被映射时先写入临时文件再替换，避免截断正在读取的映射
+        const bool replace_mapped = source_buffer_ && source_buffer_->mapped();
+        const bool unchanged = !writer_handle_ && pending_new_files_.empty() && files_to_remove_.empty();
+        std::vector<std::byte> memory_buffer;
+        if (!unchanged || !source_buffer_)
+        {
+            memory_buffer = co_await save_to_memory();
+        }
+        // 未修改时直接写出源数据，不复制
+        const std::span<const std::byte> content = unchanged && source_buffer_
+            ? source_buffer_->bytes() : std::span<const std::byte>(memory_buffer);
+
+        if (replace_mapped)
+        {
+            const std::string temp_path = path + ".tinakit-tmp";
+            co_await core::write_file_binary(temp_path, content);
+            std::error_code ec;
+            std::filesystem::rename(temp_path, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(temp_path, ec);
+                throw IOException("Failed to replace file", path);
+            }
+        }
+        else
+        {
+            co_await core::write_file_binary(path, content);
+        }
 
         // 保存后重新初始化 reader，以便继续读取
         if (writer_handle_) {
@@ -393,26 +1185,12 @@ namespace tinakit::core
             // 清空其他状态
             files_to_remove_.clear();
 
-            // 使用刚保存的内容重新创建 reader
-            reader_handle_.reset(mz_zip_reader_create());
-            if (reader_handle_) {
-                source_buffer_ = std::move(memory_buffer);  // 更新源缓冲区
-
-                // 重新打开 reader
-                if (int32_t status = mz_zip_reader_open_buffer(reader_handle_.get(),
-                                                               reinterpret_cast<uint8_t*>(source_buffer_.data()),
-                                                               static_cast<int32_t>(source_buffer_.size()), 0);
-                    status != MZ_OK) {
-                    reader_handle_.reset();  // 失败时清理
-                    throw TinaKitException("Failed to reinitialize reader after save. Status: " + std::to_string(status),
-                                           "OpenXmlArchiver::save_to_file");
-                }
+            // 使用刚保存的内容重新创建 reader（仍在使用旧缓冲区的条目流各自持有其所有权）
+            source_buffer_ = SourceBuffer::from_bytes(std::move(memory_buffer));
+            open_source_reader("OpenXmlArchiver::save_to_file");
 
-                // 重新扫描文件列表
-                co_await list_files();
-            } else {
-                throw TinaKitException("Failed to create reader handle after save.", "OpenXmlArchiver::save_to_file");
-            }
+            // 重新扫描文件列表
+            co_await list_files();
         }
     }
 
@@ -423,22 +1201,54 @@ namespace tinakit::core
         {
             if (reader_handle_)
             {
-                co_return source_buffer_;
+                const auto bytes = source_buffer_->bytes();
+                co_return std::vector<std::byte>(bytes.begin(), bytes.end());
             }
             co_return std::vector<std::byte>();
         }
 
-        co_await transition_to_writer_mode_if_needed();
-
-        // 检查写入器状态
-        if (!writer_handle_) {
-            throw TinaKitException("Writer handle is null", "OpenXmlArchiver.save_to_memory");
+        if (output_target_ || output_stream_)
+        {
+            throw TinaKitException("Archive is written directly to its output; use save_to_file() or finish().",
+                                   "OpenXmlArchiver.save_to_memory");
         }
 
+        co_await finish_writer("OpenXmlArchiver.save_to_memory");
+
         if (!memory_stream_handle_) {
             throw TinaKitException("Memory stream handle is null", "OpenXmlArchiver.save_to_memory");
         }
 
+        // 现在，从内存流句柄中提取最终的存档。
+        const void* buffer_ptr = nullptr;
+        mz_stream_mem_get_buffer(memory_stream_handle_.get(), &buffer_ptr);
+        int32_t buffer_len = 0;
+        mz_stream_mem_get_buffer_length(memory_stream_handle_.get(), &buffer_len);
+
+        if (!buffer_ptr || buffer_len < 0) {
+            throw TinaKitException("Failed to retrieve buffer from memory stream after saving.", "OpenXmlArchiver.save_to_memory");
+        }
+
+        const auto* byte_ptr = static_cast<const std::byte*>(buffer_ptr);
+        std::vector<std::byte> result(byte_ptr, byte_ptr + buffer_len);
+
+        co_return result;
+    }
+
+    async::Task<void> OpenXmlArchiver::finish_writer(const char* context)
+    {
+        if (open_entry_)
+        {
+            throw TinaKitException("Entry '" + *open_entry_ + "' is still being written.", context);
+        }
+
+        co_await transition_to_writer_mode_if_needed();
+
+        // 检查写入器状态
+        if (!writer_handle_) {
+            throw TinaKitException("Writer handle is null", context);
+        }
+
         // 首先，从原始reader复制不需要删除且不会被新文件替换的文件
         if (reader_handle_) {
             if (int32_t status = mz_zip_reader_goto_first_entry(reader_handle_.get()); status == MZ_OK) {
@@ -451,14 +1261,15 @@ namespace tinakit::core
 
                     // 检查文件是否在移除列表中，或者是否有待写入的新版本
                     bool should_skip = files_to_remove_.find(filename) != files_to_remove_.end() ||
-                                      pending_new_files_.find(filename) != pending_new_files_.end();
+                                      pending_new_files_.find(filename) != pending_new_files_.end() ||
+                                      written_files_.find(filename) != written_files_.end();
 
                     if (!should_skip) {
                         if (int32_t copy_status = mz_zip_writer_copy_from_reader(
                             writer_handle_.get(), reader_handle_.get()); copy_status != MZ_OK) {
                             throw TinaKitException(
                                 "Failed to copy entry '" + filename + "' during save.",
-                                "OpenXmlArchiver.save_to_memory");
+                                context);
                         }
                     }
                 } while (mz_zip_reader_goto_next_entry(reader_handle_.get()) == MZ_OK);
@@ -466,65 +1277,93 @@ namespace tinakit::core
 
             // 复制完成后释放reader
             reader_handle_.reset(nullptr);
-            source_buffer_.clear();
+            reader_stream_.reset();
+            source_buffer_.reset();
+            entry_index_.clear();
         }
 
         // 然后写入所有新文件
+        std::vector<CompressionProfile> profiles;
+        profiles.reserve(pending_new_files_.size());
         for (auto const& [filename, content] : pending_new_files_) {
-            // 设置文件信息
-            mz_zip_file file_info = {};
-            file_info.filename = filename.c_str();
-            file_info.uncompressed_size = static_cast<uint64_t>(content.size());
-            file_info.compression_method = MZ_COMPRESS_METHOD_DEFLATE;
+            profiles.push_back(write_profile_.profile_for(filename));
+        }
 
-            int32_t status = mz_zip_writer_entry_open(writer_handle_.get(), &file_info);
-            if (status != MZ_OK) {
-                if (status == -109 && file_info.compression_method == MZ_COMPRESS_METHOD_DEFLATE) {
-                    // DEFLATE 不支持，回退到 STORE 模式
-                    file_info.compression_method = MZ_COMPRESS_METHOD_STORE;
-                    status = mz_zip_writer_entry_open(writer_handle_.get(), &file_info);
+        // 并行模式下所有需要压缩的条目同时分块压缩，再按名称顺序写入
+        std::vector<DeflatedData> compressed;
+        if (deflate_pool_) {
+            std::vector<async::Task<DeflatedData>> tasks;
+            std::size_t index = 0;
+            for (auto const& [filename, content] : pending_new_files_) {
+                const CompressionProfile profile = profiles[index++];
+                if (profile != CompressionProfile::Store) {
+                    tasks.push_back(deflate_parallel(*deflate_pool_, content, deflate_level(profile), deflate_block_size_));
                 }
+            }
+            compressed = co_await async::when_all(std::move(tasks));
+        }
 
-                if (status != MZ_OK) {
-                    throw TinaKitException("Failed to open entry for file '" + filename + "'. Status: " + std::to_string(status), "OpenXmlArchiver.save_to_memory");
+        std::size_t index = 0;
+        std::size_t compressed_index = 0;
+        for (auto const& [filename, content] : pending_new_files_) {
+            const CompressionProfile profile = profiles[index++];
+            if (deflate_pool_ && profile != CompressionProfile::Store) {
+                auto& entry = compressed[compressed_index++];
+                if (int32_t status = open_raw_entry(writer_handle_.get(), filename, content.size(), deflate_level(profile)); status != MZ_OK) {
+                    throw TinaKitException("Failed to open entry for file '" + filename + "'. Status: " + std::to_string(status), context);
+                }
+                if (int32_t status = write_raw_entry(writer_handle_.get(), entry.bytes); status != MZ_OK) {
+                    throw TinaKitException("Failed to write content for file '" + filename + "'. Status: " + std::to_string(status), context);
                 }
+                if (int32_t status = close_raw_entry(writer_handle_.get(), entry); status != MZ_OK) {
+                    throw TinaKitException("Failed to close entry for file '" + filename + "'. Status: " + std::to_string(status), context);
+                }
+                std::vector<std::byte>().swap(entry.bytes);
+                continue;
+            }
+
+            if (int32_t status = open_writer_entry(writer_handle_.get(), filename, content.size(), profile); status != MZ_OK) {
+                throw TinaKitException("Failed to open entry for file '" + filename + "'. Status: " + std::to_string(status), context);
             }
 
             // 写入文件内容
             int32_t bytes_written = mz_zip_writer_entry_write(writer_handle_.get(), content.data(), static_cast<int32_t>(content.size()));
             if (bytes_written < 0) {
                 mz_zip_writer_entry_close(writer_handle_.get());
-                throw TinaKitException("Failed to write content for file '" + filename + "'. Status: " + std::to_string(bytes_written), "OpenXmlArchiver.save_to_memory");
+                throw TinaKitException("Failed to write content for file '" + filename + "'. Status: " + std::to_string(bytes_written), context);
             }
 
             // 关闭文件条目
             if (int32_t close_status = mz_zip_writer_entry_close(writer_handle_.get()); close_status != MZ_OK) {
-                throw TinaKitException("Failed to close entry for file '" + filename + "'. Status: " + std::to_string(close_status), "OpenXmlArchiver.save_to_memory");
+                throw TinaKitException("Failed to close entry for file '" + filename + "'. Status: " + std::to_string(close_status), context);
             }
         }
         pending_new_files_.clear();
         files_to_remove_.clear();  // 清空移除列表，因为保存操作已完成
+        written_files_.clear();
 
         if (int32_t status = mz_zip_writer_close(writer_handle_.get()); status != MZ_OK) {
-            throw TinaKitException("Failed to close zip writer. Status: " + std::to_string(status), "OpenXmlArchiver.save_to_memory");
+            throw TinaKitException("Failed to close zip writer. Status: " + std::to_string(status), context);
         }
+    }
 
-        // 现在，从内存流句柄中提取最终的存档。
-        const void* buffer_ptr = nullptr;
-        mz_stream_mem_get_buffer(memory_stream_handle_.get(), &buffer_ptr);
-        int32_t buffer_len = 0;
-        mz_stream_mem_get_buffer_length(memory_stream_handle_.get(), &buffer_len);
-
-        if (!buffer_ptr || buffer_len < 0) {
-            throw TinaKitException("Failed to retrieve buffer from memory stream after saving.", "OpenXmlArchiver.save_to_memory");
+    async::Task<void> OpenXmlArchiver::finish()
+    {
+        if (!output_stream_)
+        {
+            throw TinaKitException("Archive is not written to a stream.", "OpenXmlArchiver.finish");
         }
 
-        const auto* byte_ptr = static_cast<const std::byte*>(buffer_ptr);
-        std::vector<std::byte> result(byte_ptr, byte_ptr + buffer_len);
-
-        co_return result;
-
-        
+        co_await finish_writer("OpenXmlArchiver.finish");
+        writer_handle_.reset();
+        sink_stream_.reset();
+        std::ostream& stream = *output_stream_;
+        output_stream_ = nullptr;
+        current_files_.clear();
+        if (!stream.flush())
+        {
+            throw TinaKitException("Failed to flush output stream.", "OpenXmlArchiver.finish");
+        }
     }
 
     void OpenXmlArchiver::ZipReaderDeleter::operator()(void* handle) const
@@ -547,7 +1386,7 @@ namespace tinakit::core
     {
         if (handle)
         {
-            mz_stream_mem_delete(&handle);
+            mz_stream_delete(&handle);
         }
     }
 
@@ -558,45 +1397,170 @@ namespace tinakit::core
             co_return;
         }
 
+        // 不在这里复制原有条目，而是延迟到 finish_writer() 时进行
+        // 这样可以确保 files_to_remove_ 和 pending_new_files_ 都是最终状态
+        open_writer("OpenXmlArchiver.transition_to_writer_mode_if_needed");
+        co_return;
+    }
+
+    void OpenXmlArchiver::open_writer(const char* context)
+    {
         writer_handle_.reset(mz_zip_writer_create());
         if (!writer_handle_)
         {
-            throw TinaKitException("Failed to create zip writer handle for transition.",
-                                   "OpenXmlArchiver.transition_to_writer_mode_if_needed");
+            throw TinaKitException("Failed to create zip writer handle.", context);
         }
 
-        memory_stream_handle_.reset(mz_stream_mem_create());
-        if (!memory_stream_handle_)
+        void* stream = nullptr;
+        if (output_target_ && !output_file_)
         {
-            throw TinaKitException("Failed to create memory stream for writer for transition.",
-                                   "OpenXmlArchiver.transition_to_writer_mode_if_needed");
+            output_file_ = std::make_shared<OutputFile>(output_target_->first, output_target_->second);
         }
-
-        // 关键修复：先打开内存流
-        if (int32_t status = mz_stream_mem_open(memory_stream_handle_.get(), nullptr, MZ_OPEN_MODE_CREATE);
-            status != MZ_OK)
+        if (output_file_ || output_stream_)
         {
-            throw TinaKitException("Failed to open memory stream for transition. Status: " + std::to_string(status),
-                                   "OpenXmlArchiver.transition_to_writer_mode_if_needed");
+            sink_stream_.reset(create_sink_stream(output_file_.get(), output_stream_));
+            stream = sink_stream_.get();
         }
-
-        if (int32_t status = mz_zip_writer_open(writer_handle_.get(), memory_stream_handle_.get(), 0); status != MZ_OK)
+        else
         {
-            throw TinaKitException(
-                "Failed to open zip writer on memory stream for transition. Status: " + std::to_string(status),
-                "OpenXmlArchiver.transition_to_writer_mode_if_needed");
+            memory_stream_handle_.reset(mz_stream_mem_create());
+            if (!memory_stream_handle_)
+            {
+                throw TinaKitException("Failed to create memory stream for writer.", context);
+            }
+            // 关键修复：先打开内存流
+            if (int32_t status = mz_stream_mem_open(memory_stream_handle_.get(), nullptr, MZ_OPEN_MODE_CREATE);
+                status != MZ_OK)
+            {
+                throw TinaKitException("Failed to open memory stream. Status: " + std::to_string(status), context);
+            }
+            stream = memory_stream_handle_.get();
         }
 
-        // 不再在这里立即复制文件，而是延迟到 save_to_memory() 时进行
-        // 这样可以确保 files_to_remove_ 和 pending_new_files_ 都是最终状态
-
-        co_return;
+        if (int32_t status = mz_zip_writer_open(writer_handle_.get(), stream, 0); status != MZ_OK)
+        {
+            throw TinaKitException("Failed to open zip writer. Status: " + std::to_string(status), context);
+        }
     }
 
     void OpenXmlArchiver::close_handles()
     {
         writer_handle_.reset(nullptr);
+        sink_stream_.reset(nullptr);
         reader_handle_.reset(nullptr);
+        reader_stream_.reset(nullptr);
         memory_stream_handle_.reset(nullptr);
     }
+
+    // ========================================
+    // EntryOutputStream
+    // ========================================
+
+    class EntryOutputStream::Buffer : public std::streambuf
+    {
+    public:
+        Buffer(OpenXmlArchiver& archiver, std::size_t buffer_size)
+            : archiver_(archiver), buffer_(std::max<std::size_t>(buffer_size, 1))
+        {
+            setp(buffer_.data(), buffer_.data() + buffer_.size());
+        }
+
+        void flush_buffer()
+        {
+            const auto size = static_cast<std::size_t>(pptr() - pbase());
+            if (size > 0)
+            {
+                async::sync_wait(archiver_.write_entry(
+                    std::span<const std::byte>(reinterpret_cast<const std::byte*>(pbase()), size)));
+                setp(buffer_.data(), buffer_.data() + buffer_.size());
+            }
+        }
+
+        OpenXmlArchiver& archiver() noexcept { return archiver_; }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            flush_buffer();
+            if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        std::streamsize xsputn(const char* data, std::streamsize count) override
+        {
+            // 大块内容不经过缓冲区，直接交给压缩器
+            if (static_cast<std::size_t>(count) >= buffer_.size())
+            {
+                flush_buffer();
+                async::sync_wait(archiver_.write_entry(
+                    std::span<const std::byte>(reinterpret_cast<const std::byte*>(data), static_cast<std::size_t>(count))));
+                return count;
+            }
+            return std::streambuf::xsputn(data, count);
+        }
+
+        int sync() override
+        {
+            flush_buffer();
+            return 0;
+        }
+
+    private:
+        OpenXmlArchiver& archiver_;
+        std::vector<char> buffer_;
+    };
+
+    EntryOutputStream::EntryOutputStream(OpenXmlArchiver& archiver, const std::string& filename, std::size_t buffer_size)
+        : std::ostream(nullptr), buffer_(std::make_unique<Buffer>(archiver, buffer_size))
+    {
+        async::sync_wait(archiver.begin_entry(filename));
+        rdbuf(buffer_.get());
+        // 让压缩失败以异常形式传递给调用者，而不是只设置 badbit
+        exceptions(std::ios::badbit);
+    }
+
+    EntryOutputStream::~EntryOutputStream()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+            // 析构时无法报告错误
+        }
+    }
+
+    void EntryOutputStream::close()
+    {
+        if (!buffer_)
+        {
+            return;
+        }
+        auto buffer = std::move(buffer_);
+        exceptions(std::ios::goodbit);
+        rdbuf(nullptr);
+
+        try
+        {
+            buffer->flush_buffer();
+        }
+        catch (...)
+        {
+            // 写入失败时仍然结束条目，避免归档器停留在写入状态
+            try
+            {
+                async::sync_wait(buffer->archiver().end_entry());
+            }
+            catch (...)
+            {
+            }
+            throw;
+        }
+        async::sync_wait(buffer->archiver().end_entry());
+    }
 }
@@ -0,0 +1,136 @@
+/**
+ * @file parallel_deflate.cpp
+ * @brief 分块独立压缩的 deflate 编码器实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/core/parallel_deflate.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <zlib.h>
+
+namespace tinakit::core
+{
+    namespace
+    {
+        // zlib 的 avail_in/avail_out 为 uInt，超大输入分段送入
+        constexpr std::size_t MAX_ZLIB_CHUNK = 1u << 30;
+
+        async::Task<DeflatedData> deflate_block_on(async::Executor& executor, std::span<const std::byte> input,
+                                                   int level, bool final)
+        {
+            co_await async::schedule_on(executor);
+            co_return deflate_block(input, level, final);
+        }
+    }
+
+    void DeflatedData::append(const DeflatedData& block)
+    {
+        bytes.insert(bytes.end(), block.bytes.begin(), block.bytes.end());
+        crc = static_cast<std::uint32_t>(
+            crc32_combine(crc, block.crc, static_cast<z_off64_t>(block.uncompressed_size)));
+        uncompressed_size += block.uncompressed_size;
+    }
+
+    DeflatedData deflate_block(std::span<const std::byte> input, int level, bool final)
+    {
+        z_stream stream = {};
+        // 负的窗口位数表示输出原始 deflate 流，这正是 zip 条目需要的格式
+        if (int status = deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY); status != Z_OK)
+        {
+            throw TinaKitException("Failed to initialize deflate stream. Status: " + std::to_string(status),
+                                   "deflate_block");
+        }
+
+        DeflatedData result;
+        const auto* data = reinterpret_cast<const unsigned char*>(input.data());
+        result.crc = static_cast<std::uint32_t>(crc32_z(0, data, input.size()));
+        result.uncompressed_size = input.size();
+
+        // 全刷新会额外写入一个空的存储块，deflateBound 不包含这部分
+        const auto bound = deflateBound(&stream, static_cast<unsigned long>(std::min(input.size(), MAX_ZLIB_CHUNK)));
+        result.bytes.resize(static_cast<std::size_t>(bound) + 16);
+
+        std::size_t consumed = 0;
+        std::size_t produced = 0;
+        int status = Z_OK;
+        while (true)
+        {
+            const std::size_t chunk = std::min(input.size() - consumed, MAX_ZLIB_CHUNK);
+            const bool last_chunk = consumed + chunk == input.size();
+            const int flush = last_chunk ? (final ? Z_FINISH : Z_FULL_FLUSH) : Z_NO_FLUSH;
+            stream.next_in = const_cast<unsigned char*>(data + consumed);
+            stream.avail_in = static_cast<uInt>(chunk);
+
+            do
+            {
+                if (produced == result.bytes.size())
+                {
+                    result.bytes.resize(result.bytes.size() * 2);
+                }
+                const std::size_t space = std::min(result.bytes.size() - produced, MAX_ZLIB_CHUNK);
+                stream.next_out = reinterpret_cast<unsigned char*>(result.bytes.data() + produced);
+                stream.avail_out = static_cast<uInt>(space);
+                status = deflate(&stream, flush);
+                produced += space - stream.avail_out;
+                if (status == Z_STREAM_ERROR)
+                {
+                    deflateEnd(&stream);
+                    throw TinaKitException("Deflate stream error.", "deflate_block");
+                }
+                // 输出缓冲区被填满时 deflate 可能还有待输出的数据
+            } while (stream.avail_out == 0);
+
+            consumed += chunk;
+            if (last_chunk)
+            {
+                break;
+            }
+        }
+
+        deflateEnd(&stream);
+        if (final && status != Z_STREAM_END)
+        {
+            throw TinaKitException("Deflate stream did not finish.", "deflate_block");
+        }
+        result.bytes.resize(produced);
+        return result;
+    }
+
+    async::Task<DeflatedData> deflate_parallel(async::Executor& executor, std::span<const std::byte> input,
+                                               int level, std::size_t block_size, bool final)
+    {
+        block_size = std::max<std::size_t>(block_size, 1);
+        if (input.size() <= block_size)
+        {
+            co_return deflate_block(input, level, final);
+        }
+
+        std::vector<async::Task<DeflatedData>> tasks;
+        tasks.reserve((input.size() + block_size - 1) / block_size);
+        for (std::size_t offset = 0; offset < input.size(); offset += block_size)
+        {
+            const auto block = input.subspan(offset, std::min(block_size, input.size() - offset));
+            const bool last = offset + block.size() == input.size();
+            tasks.push_back(deflate_block_on(executor, block, level, final && last));
+        }
+
+        auto blocks = co_await async::when_all(std::move(tasks));
+
+        DeflatedData result = std::move(blocks.front());
+        std::size_t total = result.bytes.size();
+        for (std::size_t i = 1; i < blocks.size(); ++i)
+        {
+            total += blocks[i].bytes.size();
+        }
+        result.bytes.reserve(total);
+        for (std::size_t i = 1; i < blocks.size(); ++i)
+        {
+            result.append(blocks[i]);
+        }
+        co_return result;
+    }
+}
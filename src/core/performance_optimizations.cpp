@@ -9,13 +9,133 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstring>
+#include <stdexcept>
 
 namespace tinakit::core {
 
 // 全局性能计数器实例
 PerformanceCounter g_perf_counter;
 
+// ========================================
+// StringPool 实现
+// ========================================
+
+/**
+ * @brief 字符串池的分片
+ *
+ * 序号到视图的表分段保存，段长依次翻倍；已分配的段不再移动，读取时不需要加锁。
+ */
+struct StringPool::Shard {
+    static constexpr std::size_t FIRST_SEGMENT = 256;
+    static constexpr std::size_t SEGMENT_COUNT = 21;   // 容量超过分片内序号上限 2^28
+    static constexpr std::size_t MAX_ENTRIES = (std::size_t{1} << (32 - SHARD_BITS)) - 1;
+
+    std::mutex mutex;
+    std::pmr::monotonic_buffer_resource arena;
+    std::unordered_map<std::string_view, StringId> index;
+    std::array<std::atomic<std::string_view*>, SEGMENT_COUNT> segments{};
+    std::atomic<std::size_t> count{0};
+
+    ~Shard() { release_segments(); }
+
+    static std::pair<std::size_t, std::size_t> locate(std::size_t position) noexcept {
+        const std::size_t segment = static_cast<std::size_t>(std::bit_width(position / FIRST_SEGMENT + 1)) - 1;
+        return {segment, position - FIRST_SEGMENT * ((std::size_t{1} << segment) - 1)};
+    }
+
+    void release_segments() noexcept {
+        for (auto& segment : segments) {
+            delete[] segment.exchange(nullptr, std::memory_order_relaxed);
+        }
+    }
+};
+
+StringPool::StringPool() {
+    for (auto& shard : shards_) {
+        shard = std::make_unique<Shard>();
+    }
+}
+
+StringPool::~StringPool() = default;
+
+StringPool::StringId StringPool::intern(std::string_view str) {
+    if (str.empty()) {
+        return INVALID_ID;
+    }
+
+    // 用哈希的高位选分片，低位留给分片内的哈希表
+    const std::size_t hash = std::hash<std::string_view>{}(str);
+    const std::size_t shard_index = hash >> (sizeof(std::size_t) * 8 - SHARD_BITS);
+    auto& shard = *shards_[shard_index];
+
+    std::lock_guard lock(shard.mutex);
+    if (auto it = shard.index.find(str); it != shard.index.end()) {
+        return it->second;
+    }
+
+    const std::size_t position = shard.count.load(std::memory_order_relaxed);
+    if (position >= Shard::MAX_ENTRIES) {
+        throw std::length_error("StringPool: too many strings in one shard");
+    }
+    auto [segment, offset] = Shard::locate(position);
+    auto* entries = shard.segments[segment].load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = new std::string_view[Shard::FIRST_SEGMENT << segment];
+        shard.segments[segment].store(entries, std::memory_order_release);
+    }
+
+    auto* data = static_cast<char*>(shard.arena.allocate(str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    const std::string_view stored(data, str.size());
+    entries[offset] = stored;
+
+    const auto id = static_cast<StringId>(((position + 1) << SHARD_BITS) | shard_index);
+    shard.index.emplace(stored, id);
+    shard.count.store(position + 1, std::memory_order_release);
+    return id;
+}
+
+std::string_view StringPool::get_string(StringId id) const noexcept {
+    if (id == INVALID_ID) {
+        return {};
+    }
+    const auto& shard = *shards_[id & (SHARD_COUNT - 1)];
+    const std::size_t position = (id >> SHARD_BITS) - 1;
+    if (position >= shard.count.load(std::memory_order_acquire)) {
+        return {};
+    }
+    auto [segment, offset] = Shard::locate(position);
+    return shard.segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+void StringPool::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard->mutex);
+        shard->index.clear();
+        shard->release_segments();
+        shard->arena.release();
+        shard->count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void StringPool::reserve(std::size_t size) {
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard->mutex);
+        shard->index.reserve(size / SHARD_COUNT + 1);
+    }
+}
+
+std::size_t StringPool::size() const noexcept {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
 // ========================================
 // PerformanceCounter 实现
 // ========================================
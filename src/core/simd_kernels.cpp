@@ -0,0 +1,307 @@
+/**
+ * @file simd_kernels.cpp
+ * @brief XML 文本扫描的 SIMD 内核（运行时按 CPU 选择 AVX2 / SSE2 / 标量实现）
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/core/performance_optimizations.hpp"
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TINAKIT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TINAKIT_TARGET_SSE2
+#define TINAKIT_TARGET_AVX2
+#else
+#define TINAKIT_TARGET_SSE2 __attribute__((target("sse2")))
+#define TINAKIT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace tinakit::core::simd {
+
+namespace {
+
+// 向量路径固定比较 4 个字符，不足 4 个时用最后一个字符补齐
+constexpr std::size_t MAX_VECTOR_NEEDLES = 4;
+
+struct Kernels {
+    Level level;
+    // 返回第一个匹配字节的偏移，未找到时返回 size
+    std::size_t (*find_any4)(const char* data, std::size_t size, const char* needles) noexcept;
+    // 返回开头连续 ASCII 字节的数量
+    std::size_t (*ascii_prefix)(const char* data, std::size_t size) noexcept;
+};
+
+// ========================================
+// 标量实现
+// ========================================
+
+std::size_t find_any4_scalar(const char* data, std::size_t size, const char* needles) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        const char c = data[i];
+        if (c == needles[0] || c == needles[1] || c == needles[2] || c == needles[3]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+std::size_t ascii_prefix_scalar(const char* data, std::size_t size) noexcept {
+    std::size_t i = 0;
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) ++i;
+    return i;
+}
+
+/**
+ * @brief 校验 p 处的一个多字节 UTF-8 序列
+ * @return 序列长度，非法时返回 0
+ */
+std::size_t utf8_sequence_length(const unsigned char* p, std::size_t remaining) noexcept {
+    const unsigned char lead = p[0];
+    std::size_t length = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead == 0xE0) {
+        length = 3;
+        low = 0xA0;     // 过长编码
+    } else if (lead == 0xED) {
+        length = 3;
+        high = 0x9F;    // 代理项
+    } else if (lead >= 0xE1 && lead <= 0xEF) {
+        length = 3;
+    } else if (lead == 0xF0) {
+        length = 4;
+        low = 0x90;     // 过长编码
+    } else if (lead >= 0xF1 && lead <= 0xF3) {
+        length = 4;
+    } else if (lead == 0xF4) {
+        length = 4;
+        high = 0x8F;    // 超出 U+10FFFF
+    } else {
+        return 0;
+    }
+
+    if (remaining < length || p[1] < low || p[1] > high) {
+        return 0;
+    }
+    for (std::size_t i = 2; i < length; ++i) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+// ========================================
+// SSE2 / AVX2 实现
+// ========================================
+
+#ifdef TINAKIT_SIMD_X86
+
+TINAKIT_TARGET_SSE2
+std::size_t find_any4_sse2(const char* data, std::size_t size, const char* needles) noexcept {
+    const __m128i n0 = _mm_set1_epi8(needles[0]);
+    const __m128i n1 = _mm_set1_epi8(needles[1]);
+    const __m128i n2 = _mm_set1_epi8(needles[2]);
+    const __m128i n3 = _mm_set1_epi8(needles[3]);
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, n0), _mm_cmpeq_epi8(block, n1)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, n2), _mm_cmpeq_epi8(block, n3)));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return i + find_any4_scalar(data + i, size - i, needles);
+}
+
+TINAKIT_TARGET_SSE2
+std::size_t ascii_prefix_sse2(const char* data, std::size_t size) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(block));
+        if (mask != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return i + ascii_prefix_scalar(data + i, size - i);
+}
+
+TINAKIT_TARGET_AVX2
+std::size_t find_any4_avx2(const char* data, std::size_t size, const char* needles) noexcept {
+    const __m256i n0 = _mm256_set1_epi8(needles[0]);
+    const __m256i n1 = _mm256_set1_epi8(needles[1]);
+    const __m256i n2 = _mm256_set1_epi8(needles[2]);
+    const __m256i n3 = _mm256_set1_epi8(needles[3]);
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, n0), _mm256_cmpeq_epi8(block, n1)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, n2), _mm256_cmpeq_epi8(block, n3)));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return i + find_any4_sse2(data + i, size - i, needles);
+}
+
+TINAKIT_TARGET_AVX2
+std::size_t ascii_prefix_avx2(const char* data, std::size_t size) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(block));
+        if (mask != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return i + ascii_prefix_sse2(data + i, size - i);
+}
+
+#endif
+
+// ========================================
+// 运行时分派
+// ========================================
+
+constexpr Kernels scalar_kernels{Level::Scalar, find_any4_scalar, ascii_prefix_scalar};
+#ifdef TINAKIT_SIMD_X86
+constexpr Kernels sse2_kernels{Level::SSE2, find_any4_sse2, ascii_prefix_sse2};
+constexpr Kernels avx2_kernels{Level::AVX2, find_any4_avx2, ascii_prefix_avx2};
+#endif
+
+Level detect_level() noexcept {
+#ifdef TINAKIT_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                        (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if (max_leaf >= 7 && os_avx) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse2 = __builtin_cpu_supports("sse2");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return Level::AVX2;
+    }
+    if (sse2) {
+        return Level::SSE2;
+    }
+#endif
+    return Level::Scalar;
+}
+
+const Kernels* kernels_for(Level level) noexcept {
+#ifdef TINAKIT_SIMD_X86
+    switch (level) {
+    case Level::AVX2:
+        return &avx2_kernels;
+    case Level::SSE2:
+        return &sse2_kernels;
+    case Level::Scalar:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return &scalar_kernels;
+}
+
+std::atomic<const Kernels*>& active_kernels() noexcept {
+    static std::atomic<const Kernels*> kernels{kernels_for(detected_level())};
+    return kernels;
+}
+
+} // namespace
+
+Level detected_level() noexcept {
+    static const Level level = detect_level();
+    return level;
+}
+
+Level active_level() noexcept {
+    return active_kernels().load(std::memory_order_relaxed)->level;
+}
+
+Level set_level(Level level) noexcept {
+    const Level effective = std::min(level, detected_level());
+    active_kernels().store(kernels_for(effective), std::memory_order_relaxed);
+    return effective;
+}
+
+const char* level_name(Level level) noexcept {
+    switch (level) {
+    case Level::AVX2:
+        return "AVX2";
+    case Level::SSE2:
+        return "SSE2";
+    case Level::Scalar:
+        break;
+    }
+    return "Scalar";
+}
+
+std::size_t find_any(std::string_view text, std::string_view needles, std::size_t pos) noexcept {
+    if (pos >= text.size() || needles.empty()) {
+        return std::string_view::npos;
+    }
+    if (needles.size() > MAX_VECTOR_NEEDLES) {
+        return text.find_first_of(needles, pos);
+    }
+
+    char padded[MAX_VECTOR_NEEDLES];
+    for (std::size_t i = 0; i < MAX_VECTOR_NEEDLES; ++i) {
+        padded[i] = needles[std::min(i, needles.size() - 1)];
+    }
+
+    const std::size_t remaining = text.size() - pos;
+    const std::size_t offset = active_kernels().load(std::memory_order_relaxed)->find_any4(text.data() + pos, remaining, padded);
+    return offset == remaining ? std::string_view::npos : pos + offset;
+}
+
+std::size_t find_invalid_utf8(std::string_view text) noexcept {
+    const auto* kernels = active_kernels().load(std::memory_order_relaxed);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const std::size_t size = text.size();
+
+    // ASCII 段整块跳过，只有非 ASCII 序列逐个校验
+    std::size_t i = 0;
+    while (i < size) {
+        i += kernels->ascii_prefix(text.data() + i, size - i);
+        while (i < size && bytes[i] >= 0x80) {
+            const std::size_t length = utf8_sequence_length(bytes + i, size - i);
+            if (length == 0) {
+                return i;
+            }
+            i += length;
+        }
+    }
+    return std::string_view::npos;
+}
+
+} // namespace tinakit::core::simd
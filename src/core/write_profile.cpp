@@ -0,0 +1,88 @@
+/**
+ * @file write_profile.cpp
+ * @brief 归档写入压缩配置的实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/core/write_profile.hpp"
+
+namespace tinakit::core
+{
+    int deflate_level(CompressionProfile profile) noexcept
+    {
+        switch (profile)
+        {
+        case CompressionProfile::Fastest:
+            return 1;
+        case CompressionProfile::Smallest:
+            return 9;
+        case CompressionProfile::Store:
+            return 0;
+        case CompressionProfile::Balanced:
+            break;
+        }
+        return -1;
+    }
+
+    WriteProfile WriteProfile::uniform(CompressionProfile profile)
+    {
+        WriteProfile result;
+        result.default_profile = profile;
+        return result;
+    }
+
+    WriteProfile& WriteProfile::add(std::string pattern, CompressionProfile profile)
+    {
+        rules.emplace_back(std::move(pattern), profile);
+        return *this;
+    }
+
+    CompressionProfile WriteProfile::profile_for(std::string_view entry_name) const
+    {
+        for (const auto& [pattern, profile] : rules)
+        {
+            if (match_entry_pattern(pattern, entry_name))
+            {
+                return profile;
+            }
+        }
+        return default_profile;
+    }
+
+    bool match_entry_pattern(std::string_view pattern, std::string_view name) noexcept
+    {
+        // 贪心匹配，遇到不匹配时回溯到上一个 '*'
+        std::size_t p = 0;
+        std::size_t n = 0;
+        std::size_t star = std::string_view::npos;
+        std::size_t star_name = 0;
+        while (n < name.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+            {
+                ++p;
+                ++n;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star = p++;
+                star_name = n;
+            }
+            else if (star != std::string_view::npos)
+            {
+                p = star + 1;
+                n = ++star_name;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            ++p;
+        }
+        return p == pattern.size();
+    }
+}
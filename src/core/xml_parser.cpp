@@ -3,11 +3,14 @@
 //
 
 #include "tinakit/core/xml_parser.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <libstudxml/parser.hxx>
 #include <libstudxml/serializer.hxx>
 #include <unordered_set>
+#include <vector>
 
 namespace tinakit::core
 {
@@ -111,10 +114,67 @@ namespace tinakit::core
             "val", "sz", "b", "i", "u", "color", "rgb", "theme", "indexed"
         };
     
+    namespace
+    {
+        // Read-only streambuf over a caller-owned buffer; seekable so that reset() works.
+        class ViewStreamBuf : public std::streambuf
+        {
+        public:
+            explicit ViewStreamBuf(std::string_view buffer)
+            {
+                char* begin = const_cast<char*>(buffer.data());
+                setg(begin, begin, begin + buffer.size());
+            }
+
+        protected:
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+            {
+                if (!(which & std::ios_base::in))
+                {
+                    return pos_type(off_type(-1));
+                }
+                off_type base = 0;
+                if (dir == std::ios_base::cur)
+                {
+                    base = gptr() - eback();
+                }
+                else if (dir == std::ios_base::end)
+                {
+                    base = egptr() - eback();
+                }
+                const off_type target = base + off;
+                if (target < 0 || target > egptr() - eback())
+                {
+                    return pos_type(off_type(-1));
+                }
+                setg(eback(), eback() + target, egptr());
+                return pos_type(target);
+            }
+
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+            {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
+            }
+        };
+
+        class ViewInputStream : public std::istream
+        {
+        public:
+            explicit ViewInputStream(std::string_view buffer)
+                : std::istream(nullptr), buffer_(buffer)
+            {
+                rdbuf(&buffer_);
+            }
+
+        private:
+            ViewStreamBuf buffer_;
+        };
+    } // namespace
+
     struct XmlParser::Impl
     {
-        // Manages file stream lifetime
-        std::unique_ptr<std::ifstream> owned_stream;
+        // Manages file or buffer stream lifetime
+        std::unique_ptr<std::istream> owned_stream;
         // Reference to the active stream
         std::istream& stream_ref;
         // The actual libstudxml parser
@@ -124,8 +184,12 @@ namespace tinakit::core
         // Error handling
         std::optional<XmlParseError> last_error;
         bool error_recovery_enabled = false;
+        // Transient allocations of the current parse (text_view / attribute_view)
+        ParseArena arena;
+        // Reused buffer for collecting text split across several character events
+        std::string text_buffer;
 
-        Impl(std::unique_ptr<std::ifstream> stream, const std::string& doc_name):
+        Impl(std::unique_ptr<std::istream> stream, const std::string& doc_name):
             owned_stream(std::move(stream)),
             stream_ref(*owned_stream),
             document_name(doc_name)
@@ -186,6 +250,19 @@ namespace tinakit::core
         impl_ = std::make_unique<Impl>(stream, document_name);
     }
 
+    XmlParser::XmlParser(std::string_view buffer, const std::string& document_name)
+    {
+        // UTF-16 documents (BOM) are left to expat's own decoder
+        const bool utf16 = buffer.size() >= 2 &&
+            ((buffer[0] == '\xFE' && buffer[1] == '\xFF') || (buffer[0] == '\xFF' && buffer[1] == '\xFE'));
+        if (const auto offset = utf16 ? std::string_view::npos : simd::find_invalid_utf8(buffer);
+            offset != std::string_view::npos)
+        {
+            throw ParseException("Invalid UTF-8 in " + document_name + " at byte " + std::to_string(offset));
+        }
+        impl_ = std::make_unique<Impl>(std::make_unique<ViewInputStream>(buffer), document_name);
+    }
+
     XmlParser::~XmlParser() = default;
 
     XmlParser::iterator XmlParser::begin()
@@ -201,9 +278,20 @@ namespace tinakit::core
     bool XmlParser::reset()
     {
         impl_->last_error.reset(); // Clear any previous errors
+        impl_->arena.release();
         return impl_->reset();
     }
 
+    std::pmr::memory_resource* XmlParser::arena() noexcept
+    {
+        return impl_->arena.resource();
+    }
+
+    void XmlParser::release_arena() noexcept
+    {
+        impl_->arena.release();
+    }
+
     void XmlParser::parse_multiple_elements(const std::map<std::string, std::function<void(iterator&)>>& element_handlers)
     {
         for (auto it = begin(); it != end(); ++it)
@@ -219,6 +307,7 @@ namespace tinakit::core
                             throw;
                         }
                     }
+                    impl_->arena.release();
                 }
             }
         }
@@ -226,20 +315,40 @@ namespace tinakit::core
 
     void XmlParser::parse_multiple_elements_ns(const std::map<std::pair<std::string, std::string>, std::function<void(iterator&)>>& element_handlers)
     {
+        // Look handlers up by views into the map keys: building a (namespace, name)
+        // pair of strings for every element would allocate, since namespace URIs
+        // are longer than the small-string buffer.
+        struct Entry
+        {
+            std::string_view namespace_uri;
+            std::string_view name;
+            const std::function<void(iterator&)>* handler;
+        };
+        std::vector<Entry> entries;
+        entries.reserve(element_handlers.size());
+        for (const auto& [key, handler] : element_handlers)
+        {
+            entries.push_back({key.first, key.second, &handler});
+        }
+
         for (auto it = begin(); it != end(); ++it)
         {
             if (it.is_start_element()) {
-                std::pair<std::string, std::string> key = {it.namespace_uri(), it.name()};
-                auto handler_it = element_handlers.find(key);
-                if (handler_it != element_handlers.end()) {
+                const std::string& name = it.name();
+                const std::string& namespace_uri = it.namespace_uri();
+                auto entry = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) {
+                    return e.name == name && e.namespace_uri == namespace_uri;
+                });
+                if (entry != entries.end()) {
                     try {
-                        handler_it->second(it);
+                        (*entry->handler)(it);
                     } catch (const std::exception& e) {
                         impl_->last_error = XmlParseError(e.what(), it.line(), it.column(), it.name());
                         if (!impl_->error_recovery_enabled) {
                             throw;
                         }
                     }
+                    impl_->arena.release();
                 }
             }
         }
@@ -263,6 +372,7 @@ namespace tinakit::core
             if (it.is_start_element() && it.name() == element_name)
             {
                 callback(it);
+                impl_->arena.release();
             }
         }
     }
@@ -275,6 +385,7 @@ namespace tinakit::core
             if (it.is_start_element() && it.name() == element_name && it.namespace_uri() == namespace_uri)
             {
                 callback(it);
+                impl_->arena.release();
             }
         }
     }
@@ -433,6 +544,44 @@ namespace tinakit::core
         return content;
     }
 
+    std::string_view XmlParser::iterator::text_view()
+    {
+        if (!parser_ || !is_start_element())
+        {
+            return {};
+        }
+
+        // 先收集到复用的缓冲区（文本可能被拆成多个字符事件），再整体拷贝到分配区
+        Impl& impl = *parser_->impl_;
+        impl.text_buffer.clear();
+        int depth = 1;
+
+        ++(*this);
+
+        while (parser_ && depth > 0)
+        {
+            if (is_characters())
+            {
+                impl.text_buffer += value();
+            }
+            else if (is_start_element())
+            {
+                depth++;
+            }
+            else if (is_end_element())
+            {
+                depth--;
+                if (depth == 0)
+                {
+                    break;
+                }
+            }
+            ++(*this);
+        }
+
+        return impl.arena.copy(impl.text_buffer);
+    }
+
     std::optional<std::string> XmlParser::iterator::attribute(const std::string& qname) const
     {
         if (!parser_)
@@ -440,29 +589,40 @@ namespace tinakit::core
             return std::nullopt;
         }
 
-        try {
-            // libstudxml 使用 attribute 方法获取属性，如果属性不存在会抛出异常
-            return parser_->impl_->parser->attribute(qname);
-        } catch (const std::exception&) {
-            // 属性不存在时返回 nullopt
+        return attribute(xml::qname(qname));
+    }
+
+    std::optional<std::string> XmlParser::iterator::attribute(const xml::qname& qname) const
+    {
+        if (!parser_)
+        {
+            return std::nullopt;
+        }
+
+        // libstudxml 的 attribute() 在属性不存在时抛出异常，先检查是否存在，
+        // 避免可选属性（如单元格的 t、s）缺失时每次都抛出和捕获异常
+        auto& parser = *parser_->impl_->parser;
+        if (!parser.attribute_present(qname))
+        {
             return std::nullopt;
         }
+        return parser.attribute(qname);
     }
 
-    std::optional<std::string> XmlParser::iterator::attribute(const xml::qname& qname) const
+    std::optional<std::string_view> XmlParser::iterator::attribute_view(const std::string& qname) const
     {
         if (!parser_)
         {
             return std::nullopt;
         }
 
-        try {
-            // libstudxml 使用 attribute 方法获取属性，如果属性不存在会抛出异常
-            return parser_->impl_->parser->attribute(qname);
-        } catch (const std::exception&) {
-            // 属性不存在时返回 nullopt
+        const xml::qname name(qname);
+        auto& parser = *parser_->impl_->parser;
+        if (!parser.attribute_present(name))
+        {
             return std::nullopt;
         }
+        return parser_->impl_->arena.copy(parser.attribute(name));
     }
 
     bool XmlParser::iterator::has_attribute(const std::string& qname) const
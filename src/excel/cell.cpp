@@ -10,12 +10,24 @@
 #include "tinakit/excel/style_manager.hpp"
 #include "tinakit/excel/style.hpp"
 #include "tinakit/internal/workbook_impl.hpp"
+#include "tinakit/internal/number_codec.hpp"
 #include "tinakit/core/exceptions.hpp"
 #include "tinakit/excel/types.hpp"
+#include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace tinakit::excel {
 
+namespace {
+    // 读取单元格的存储视图；单元格不存在时返回空视图
+    internal::CellView read_cell(internal::workbook_impl* workbook, std::uint32_t sheet_id,
+                                 std::size_t row, std::size_t column) {
+        auto cell = workbook->get_cell(sheet_id, core::Coordinate(row, column));
+        return cell ? workbook->resolve_cell(*cell) : internal::CellView{};
+    }
+}
+
 // ========================================
 // 构造函数和析构函数
 // ========================================
@@ -48,21 +60,13 @@ std::size_t Cell::column() const noexcept {
 
 bool Cell::empty() const noexcept {
     try {
-        auto pos = core::Coordinate(row_, column_);
-        auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
+        auto cell = read_cell(workbook_impl_, sheet_id_, row_, column_);
 
-        // 检查是否为空值
-        if (std::holds_alternative<std::monostate>(data.value)) {
-        return true;
-    }
-
-    // 检查字符串是否为空
-    if (std::holds_alternative<std::string>(data.value)) {
-        return std::get<std::string>(data.value).empty();
-    }
-
-        // 其他类型（数字、布尔值）认为非空
-        return false;
+        // 空值和空字符串认为为空，其他类型（数字、布尔值、错误值）认为非空
+        if (cell.kind == internal::CellKind::String) {
+            return cell.text.empty();
+        }
+        return cell.kind == internal::CellKind::Empty;
     } catch (...) {
         // 如果发生任何异常（如无效的sheet_id），认为单元格为空
         return true;
@@ -70,34 +74,11 @@ bool Cell::empty() const noexcept {
 }
 
 const Cell::CellValue& Cell::raw_value() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
     static thread_local CellValue cached_value;
-    cached_value = data.value;
+    cached_value = read_cell(workbook_impl_, sheet_id_, row_, column_).to_cell_data().value;
     return cached_value;
 }
 
-std::string Cell::to_string() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-
-    return std::visit([](const auto& value) -> std::string {
-        using T = std::decay_t<decltype(value)>;
-        if constexpr (std::is_same_v<T, std::monostate>) {
-            return "";  // 空单元格返回空字符串
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            return value;
-        } else if constexpr (std::is_same_v<T, double>) {
-            return std::to_string(value);
-        } else if constexpr (std::is_same_v<T, int>) {
-            return std::to_string(value);
-        } else if constexpr (std::is_same_v<T, bool>) {
-            return value ? "TRUE" : "FALSE";
-        }
-        return "";
-    }, data.value);
-}
-
 // ========================================
 // 值操作（委托给 workbook_impl）
 // ========================================
@@ -135,83 +116,98 @@ Cell& Cell::value<bool>(const bool& value) {
 // ========================================
 
 namespace {
-    // 内部通用转换函数
+    // 内部通用转换函数：直接从存储视图转换，只有结果本身是字符串时才拷贝文本
     template<typename T>
-    std::optional<T> convert_cell_value(const internal::cell_data::CellValue& value) {
-        return std::visit([](const auto& val) -> std::optional<T> {
-            using ValueType = std::decay_t<decltype(val)>;
-
-            // 处理 monostate（空单元格）
-            if constexpr (std::is_same_v<ValueType, std::monostate>) {
+    std::optional<T> convert_cell_value(const internal::CellView& cell) {
+        using internal::CellKind;
+        using internal::utils::NumberCodec;
+        switch (cell.kind) {
+            case CellKind::Empty:
+            case CellKind::Formula:
                 if constexpr (std::is_same_v<T, std::string>) {
                     return std::string("");  // 空单元格转换为空字符串
                 } else {
                     return std::nullopt;  // 其他类型无法从空单元格转换
                 }
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                if constexpr (std::is_same_v<ValueType, std::string>) {
-                    return val;
-                } else if constexpr (std::is_same_v<ValueType, double>) {
-                    return std::to_string(val);
-                } else if constexpr (std::is_same_v<ValueType, int>) {
-                    return std::to_string(val);
-                } else if constexpr (std::is_same_v<ValueType, bool>) {
-                    return val ? "TRUE" : "FALSE";
-                }
-            } else if constexpr (std::is_same_v<T, int>) {
-                if constexpr (std::is_same_v<ValueType, int>) {
-                    return val;
-                } else if constexpr (std::is_same_v<ValueType, double>) {
-                    if (val == static_cast<int>(val)) {
-                        return static_cast<int>(val);
+            case CellKind::String:
+            case CellKind::SharedString:
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::string(cell.text);
+                } else if constexpr (std::is_same_v<T, int>) {
+                    // 整个文本必须是数字；"1e5" 等整数值的浮点写法也可以转换
+                    if (auto integer = NumberCodec::parse_integer(cell.text)) {
+                        return *integer;
                     }
-                } else if constexpr (std::is_same_v<ValueType, bool>) {
-                    return val ? 1 : 0;
-                } else if constexpr (std::is_same_v<ValueType, std::string>) {
-                    try {
-                        return std::stoi(val);
-                    } catch (...) {
-                        return std::nullopt;
+                    if (auto number = NumberCodec::parse_number(cell.text);
+                        number && *number == std::trunc(*number) &&
+                        *number >= std::numeric_limits<int>::min() && *number <= std::numeric_limits<int>::max()) {
+                        return static_cast<int>(*number);
                     }
+                    return std::nullopt;
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return NumberCodec::parse_number(cell.text);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    if (cell.text == "true" || cell.text == "TRUE" || cell.text == "1") return true;
+                    if (cell.text == "false" || cell.text == "FALSE" || cell.text == "0") return false;
+                    return !cell.text.empty();
                 }
-            } else if constexpr (std::is_same_v<T, double>) {
-                if constexpr (std::is_same_v<ValueType, double>) {
-                    return val;
-                } else if constexpr (std::is_same_v<ValueType, int>) {
-                    return static_cast<double>(val);
-                } else if constexpr (std::is_same_v<ValueType, bool>) {
-                    return val ? 1.0 : 0.0;
-                } else if constexpr (std::is_same_v<ValueType, std::string>) {
-                    try {
-                        return std::stod(val);
-                    } catch (...) {
-                        return std::nullopt;
+                break;
+            case CellKind::Number:
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return NumberCodec::format_number(cell.number);
+                } else if constexpr (std::is_same_v<T, int>) {
+                    if (cell.number == static_cast<int>(cell.number)) {
+                        return static_cast<int>(cell.number);
                     }
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return cell.number;
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return cell.number != 0.0;
                 }
-            } else if constexpr (std::is_same_v<T, bool>) {
-                if constexpr (std::is_same_v<ValueType, bool>) {
-                    return val;
-                } else if constexpr (std::is_same_v<ValueType, int>) {
-                    return val != 0;
-                } else if constexpr (std::is_same_v<ValueType, double>) {
-                    return val != 0.0;
-                } else if constexpr (std::is_same_v<ValueType, std::string>) {
-                    if (val == "true" || val == "TRUE" || val == "1") return true;
-                    if (val == "false" || val == "FALSE" || val == "0") return false;
-                    return !val.empty();
+                break;
+            case CellKind::Integer: {
+                const int value = static_cast<int>(cell.number);
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::to_string(value);
+                } else if constexpr (std::is_same_v<T, int>) {
+                    return value;
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return static_cast<double>(value);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return value != 0;
                 }
+                break;
             }
-            return std::nullopt;
-        }, value);
+            case CellKind::Boolean:
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::string(cell.boolean ? "TRUE" : "FALSE");
+                } else if constexpr (std::is_same_v<T, int>) {
+                    return cell.boolean ? 1 : 0;
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return cell.boolean ? 1.0 : 0.0;
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return cell.boolean;
+                }
+                break;
+            case CellKind::Error:
+                // 错误值只能转换为其文本
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::string(internal::cell_error_text(cell.error));
+                }
+                break;
+        }
+        return std::nullopt;
     }
 }
 
+std::string Cell::to_string() const {
+    // 空单元格返回空字符串，与 as<std::string>() 的转换规则一致
+    return convert_cell_value<std::string>(read_cell(workbook_impl_, sheet_id_, row_, column_)).value_or("");
+}
+
 template<>
 std::string Cell::as<std::string>() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-
-    auto result = convert_cell_value<std::string>(data.value);
+    auto result = convert_cell_value<std::string>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     if (result) {
         return *result;
     }
@@ -220,10 +216,7 @@ std::string Cell::as<std::string>() const {
 
 template<>
 int Cell::as<int>() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-
-    auto result = convert_cell_value<int>(data.value);
+    auto result = convert_cell_value<int>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     if (result) {
         return *result;
     }
@@ -232,10 +225,7 @@ int Cell::as<int>() const {
 
 template<>
 double Cell::as<double>() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-
-    auto result = convert_cell_value<double>(data.value);
+    auto result = convert_cell_value<double>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     if (result) {
         return *result;
     }
@@ -244,10 +234,7 @@ double Cell::as<double>() const {
 
 template<>
 bool Cell::as<bool>() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-
-    auto result = convert_cell_value<bool>(data.value);
+    auto result = convert_cell_value<bool>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     if (result) {
         return *result;
     }
@@ -257,9 +244,7 @@ bool Cell::as<bool>() const {
 template<>
 std::optional<std::string> Cell::try_as<std::string>() const noexcept {
     try {
-        auto pos = core::Coordinate(row_, column_);
-        auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-        return convert_cell_value<std::string>(data.value);
+        return convert_cell_value<std::string>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     } catch (...) {
         return std::nullopt;
     }
@@ -268,9 +253,7 @@ std::optional<std::string> Cell::try_as<std::string>() const noexcept {
 template<>
 std::optional<int> Cell::try_as<int>() const noexcept {
     try {
-        auto pos = core::Coordinate(row_, column_);
-        auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-        return convert_cell_value<int>(data.value);
+        return convert_cell_value<int>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     } catch (...) {
         return std::nullopt;
     }
@@ -279,9 +262,7 @@ std::optional<int> Cell::try_as<int>() const noexcept {
 template<>
 std::optional<double> Cell::try_as<double>() const noexcept {
     try {
-        auto pos = core::Coordinate(row_, column_);
-        auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-        return convert_cell_value<double>(data.value);
+        return convert_cell_value<double>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     } catch (...) {
         return std::nullopt;
     }
@@ -290,9 +271,7 @@ std::optional<double> Cell::try_as<double>() const noexcept {
 template<>
 std::optional<bool> Cell::try_as<bool>() const noexcept {
     try {
-        auto pos = core::Coordinate(row_, column_);
-        auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-        return convert_cell_value<bool>(data.value);
+        return convert_cell_value<bool>(read_cell(workbook_impl_, sheet_id_, row_, column_));
     } catch (...) {
         return std::nullopt;
     }
@@ -309,9 +288,11 @@ Cell& Cell::formula(const std::string& formula) {
 }
 
 std::optional<std::string> Cell::formula() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-    return data.formula;
+    auto cell = read_cell(workbook_impl_, sheet_id_, row_, column_);
+    if (!cell.formula) {
+        return std::nullopt;
+    }
+    return std::string(*cell.formula);
 }
 
 // ========================================
@@ -645,15 +626,12 @@ Cell& Cell::style_id(std::uint32_t style_id) {
 }
 
 std::uint32_t Cell::style_id() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-    return data.style_id;
+    auto cell = workbook_impl_->get_cell(sheet_id_, core::Coordinate(row_, column_));
+    return cell ? cell->style_id : 0;
 }
 
 bool Cell::has_custom_style() const {
-    auto pos = core::Coordinate(row_, column_);
-    auto data = workbook_impl_->get_cell_data(sheet_id_, pos);
-    return data.style_id != 0;
+    return style_id() != 0;
 }
 
 // ========================================
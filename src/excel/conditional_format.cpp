@@ -8,20 +8,17 @@
 #include "tinakit/excel/conditional_format.hpp"
 #include "tinakit/excel/worksheet.hpp"
 #include "tinakit/excel/style_manager.hpp"
+#include "tinakit/internal/number_codec.hpp"
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace tinakit::excel {
 
-// 辅助函数：格式化数字为字符串，去掉不必要的小数点
+// 辅助函数：格式化数字为字符串（最短往返表示，整数值不带小数点）
 std::string format_number_for_condition(double value) {
-    // 检查是否为整数
-    if (value == std::floor(value)) {
-        return std::to_string(static_cast<long long>(value));
-    } else {
-        return std::to_string(value);
-    }
+    return internal::utils::NumberCodec::format_number(value);
 }
 
 // =============================================================================
@@ -9,6 +9,7 @@
 #include "tinakit/internal/workbook_impl.hpp"
 #include "tinakit/internal/worksheet_impl.hpp"
 #include "tinakit/internal/coordinate_utils.hpp"
+#include "tinakit/internal/number_codec.hpp"
 #include "tinakit/core/types.hpp"
 #include <regex>
 #include <algorithm>
@@ -17,11 +18,39 @@
 #include <cmath>
 #include <limits>
 
-// 使用内部命名空间的类型
-using tinakit::internal::cell_data;
-
 namespace tinakit::excel {
 
+namespace {
+
+/**
+ * @brief 把存储中的单元格转换为公式值（整数按数字处理，错误值按其文本处理）
+ */
+FormulaResult to_formula_result(const std::optional<internal::CompactCell>& cell,
+                                const internal::workbook_impl& workbook) {
+    if (!cell) {
+        return std::monostate{};
+    }
+    const auto view = workbook.resolve_cell(*cell);
+    switch (view.kind) {
+        case internal::CellKind::Number:
+        case internal::CellKind::Integer:
+            return view.number;
+        case internal::CellKind::Boolean:
+            return view.boolean;
+        case internal::CellKind::String:
+        case internal::CellKind::SharedString:
+            return std::string(view.text);
+        case internal::CellKind::Error:
+            return std::string(internal::cell_error_text(view.error));
+        case internal::CellKind::Empty:
+        case internal::CellKind::Formula:
+            break;
+    }
+    return std::monostate{};
+}
+
+} // namespace
+
 // ========================================
 // FormulaEngine 构造和初始化
 // ========================================
@@ -282,12 +311,8 @@ double FormulaEngine::to_number(const FormulaResult& result) const {
     } else if (std::holds_alternative<bool>(result)) {
         return std::get<bool>(result) ? 1.0 : 0.0;
     } else if (std::holds_alternative<std::string>(result)) {
-        const auto& str = std::get<std::string>(result);
-        try {
-            return std::stod(str);
-        } catch (...) {
-            return 0.0; // Excel行为：无法转换的字符串视为0
-        }
+        // Excel行为：无法转换的字符串视为0
+        return internal::utils::NumberCodec::parse_number(std::get<std::string>(result)).value_or(0.0);
     }
     return 0.0; // monostate
 }
@@ -296,7 +321,7 @@ std::string FormulaEngine::to_string(const FormulaResult& result) const {
     if (std::holds_alternative<std::string>(result)) {
         return std::get<std::string>(result);
     } else if (std::holds_alternative<double>(result)) {
-        return std::to_string(std::get<double>(result));
+        return internal::utils::NumberCodec::format_number(std::get<double>(result));
     } else if (std::holds_alternative<bool>(result)) {
         return std::get<bool>(result) ? "TRUE" : "FALSE";
     }
@@ -324,21 +349,7 @@ FormulaResult FormulaEngine::get_cell_value(const std::string& cell_ref, const s
         auto coord = ::tinakit::internal::utils::CoordinateUtils::string_to_coordinate(cell_ref);
         auto& worksheet_impl = workbook_impl_->get_worksheet_impl_public(sheet_name);
 
-        if (worksheet_impl.has_cell_data(coord)) {
-            auto cell_data_obj = worksheet_impl.get_cell_data(coord);
-
-            if (std::holds_alternative<std::string>(cell_data_obj.value)) {
-                return std::get<std::string>(cell_data_obj.value);
-            } else if (std::holds_alternative<double>(cell_data_obj.value)) {
-                return std::get<double>(cell_data_obj.value);
-            } else if (std::holds_alternative<int>(cell_data_obj.value)) {
-                return static_cast<double>(std::get<int>(cell_data_obj.value));
-            } else if (std::holds_alternative<bool>(cell_data_obj.value)) {
-                return std::get<bool>(cell_data_obj.value);
-            }
-        }
-
-        return std::monostate{}; // 空单元格
+        return to_formula_result(worksheet_impl.get_cell(coord), *workbook_impl_);
     } catch (...) {
         throw FormulaException("Invalid cell reference: " + cell_ref);
     }
@@ -354,24 +365,7 @@ std::vector<FormulaResult> FormulaEngine::get_range_values(const std::string& ra
         for (std::size_t row = range_addr.start.row; row <= range_addr.end.row; ++row) {
             for (std::size_t col = range_addr.start.column; col <= range_addr.end.column; ++col) {
                 core::Coordinate coord(row, col);
-
-                if (worksheet_impl.has_cell_data(coord)) {
-                    auto cell_data_obj = worksheet_impl.get_cell_data(coord);
-
-                    if (std::holds_alternative<std::string>(cell_data_obj.value)) {
-                        values.push_back(std::get<std::string>(cell_data_obj.value));
-                    } else if (std::holds_alternative<double>(cell_data_obj.value)) {
-                        values.push_back(std::get<double>(cell_data_obj.value));
-                    } else if (std::holds_alternative<int>(cell_data_obj.value)) {
-                        values.push_back(static_cast<double>(std::get<int>(cell_data_obj.value)));
-                    } else if (std::holds_alternative<bool>(cell_data_obj.value)) {
-                        values.push_back(std::get<bool>(cell_data_obj.value));
-                    } else {
-                        values.push_back(std::monostate{});
-                    }
-                } else {
-                    values.push_back(std::monostate{});
-                }
+                values.push_back(to_formula_result(worksheet_impl.get_cell(coord), *workbook_impl_));
             }
         }
 
@@ -0,0 +1,261 @@
+/**
+ * @file row_stream.cpp
+ * @brief 只进式流式行读取器实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/excel/row_stream.hpp"
+#include "tinakit/excel/shared_strings.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include "tinakit/internal/number_codec.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include "tinakit/core/xml_parser.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include <charconv>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+namespace tinakit::excel {
+
+namespace {
+
+/**
+ * @brief 从单元格引用（如 "AB12"）中取出列号，无法解析时返回 0
+ */
+std::size_t column_from_reference(std::string_view reference) {
+    std::size_t column = 0;
+    for (char c : reference) {
+        if (c >= 'A' && c <= 'Z') {
+            column = column * 26 + static_cast<std::size_t>(c - 'A' + 1);
+        } else if (c >= 'a' && c <= 'z') {
+            column = column * 26 + static_cast<std::size_t>(c - 'a' + 1);
+        } else {
+            break;
+        }
+    }
+    return column;
+}
+
+/**
+ * @brief 按 OpenXML 数字单元格规则转换文本：整数优先，其次浮点数，都失败时保留原文
+ */
+void assign_number(Cell::CellValue& value, const std::string& text) {
+    using internal::utils::NumberCodec;
+    if (auto integer = NumberCodec::parse_integer(text)) {
+        value = *integer;
+    } else if (auto number = NumberCodec::parse_number(text)) {
+        value = *number;
+    } else {
+        value = text;
+    }
+}
+
+} // namespace
+
+// ========================================
+// RowStream::Impl
+// ========================================
+
+struct RowStream::Impl {
+    // 解析器引用流，必须先于解析器声明
+    std::unique_ptr<std::istream> stream;
+    std::unique_ptr<core::XmlParser> parser;
+    core::XmlParser::iterator it;
+    core::XmlParser::iterator end;
+
+    std::shared_ptr<const SharedStrings> shared_strings;
+
+    // 行缓冲区：只增长不收缩，元素在各行之间复用
+    std::vector<StreamedCell> cells;
+    std::size_t cell_count = 0;
+    std::size_t row = 0;
+    std::size_t rows_read = 0;
+
+    std::string cell_text;
+
+    bool at_end() const { return !parser || it == end; }
+
+    void read_row();
+    void read_cell();
+    void read_inline_string();
+};
+
+void RowStream::Impl::read_row() {
+    // 上一行的属性和文本视图已不再使用，归还解析分配区
+    parser->release_arena();
+
+    // 没有 r 属性的行号沿用上一行加一
+    std::size_t next_row = row + 1;
+    if (auto r = it.attribute_view("r")) {
+        std::size_t parsed = 0;
+        if (auto [ptr, ec] = std::from_chars(r->data(), r->data() + r->size(), parsed);
+            ec == std::errc() && parsed != 0) {
+            next_row = parsed;
+        }
+    }
+    row = next_row;
+    cell_count = 0;
+
+    ++it;
+    while (it != end && !(it.is_end_element() && it.name() == "row")) {
+        if (it.is_start_element() && it.name() == "c") {
+            read_cell();
+        }
+        ++it;
+    }
+    ++rows_read;
+}
+
+void RowStream::Impl::read_cell() {
+    const std::size_t previous_column = cell_count > 0 ? cells[cell_count - 1].column : 0;
+    if (cell_count == cells.size()) {
+        cells.emplace_back();
+    }
+    StreamedCell& cell = cells[cell_count++];
+
+    auto reference = it.attribute_view("r");
+    const std::size_t column = reference ? column_from_reference(*reference) : 0;
+    cell.column = column != 0 ? column : previous_column + 1;
+
+    cell.style_id = 0;
+    if (auto style = it.attribute_view("s")) {
+        std::from_chars(style->data(), style->data() + style->size(), cell.style_id);
+    }
+    const std::string_view type = it.attribute_view("t").value_or(std::string_view());
+
+    cell.formula.reset();
+    cell_text.clear();
+    bool has_text = false;
+
+    ++it;
+    while (it != end && !(it.is_end_element() && it.name() == "c")) {
+        if (it.is_start_element()) {
+            const std::string& name = it.name();
+            if (name == "v") {
+                cell_text.assign(it.text_view());
+                has_text = true;
+                continue;
+            }
+            if (name == "is") {
+                read_inline_string();
+                has_text = true;
+                continue;
+            }
+            if (name == "f") {
+                cell.formula = std::string(it.text_view());
+                continue;
+            }
+        }
+        ++it;
+    }
+
+    if (!has_text) {
+        cell.value = std::monostate{};
+    } else if (type == "s") {
+        std::uint32_t index = 0;
+        auto [ptr, ec] = std::from_chars(cell_text.data(), cell_text.data() + cell_text.size(), index);
+        if (ec == std::errc() && shared_strings && index < shared_strings->count()) {
+            cell.value = shared_strings->get_string(index);
+        } else {
+            // 索引无效时保留原始文本
+            cell.value = cell_text;
+        }
+    } else if (type == "b") {
+        cell.value = (cell_text == "1");
+    } else if (type.empty() || type == "n") {
+        assign_number(cell.value, cell_text);
+    } else {
+        // inlineStr、str、e 等类型按文本处理
+        cell.value = cell_text;
+    }
+}
+
+void RowStream::Impl::read_inline_string() {
+    // 富文本的各个 <t> 片段按顺序拼接，跳过注音 <rPh>
+    std::size_t phonetic_depth = 0;
+    ++it;
+    while (it != end && !(it.is_end_element() && it.name() == "is")) {
+        if (it.is_start_element()) {
+            const std::string& name = it.name();
+            if (name == "rPh") {
+                ++phonetic_depth;
+            } else if (name == "t" && phonetic_depth == 0) {
+                cell_text += it.text_view();
+            }
+        } else if (it.is_end_element() && it.name() == "rPh") {
+            --phonetic_depth;
+        }
+        ++it;
+    }
+}
+
+// ========================================
+// RowStream
+// ========================================
+
+RowStream::RowStream(std::shared_ptr<internal::workbook_impl> workbook_impl,
+                     const std::string& sheet_name,
+                     std::size_t buffer_size)
+    : impl_(std::make_unique<Impl>()) {
+    if (!workbook_impl || !workbook_impl->has_worksheet(sheet_name)) {
+        throw WorksheetNotFoundException(sheet_name);
+    }
+
+    auto part_path = workbook_impl->locate_worksheet_part(sheet_name);
+    if (!part_path) {
+        // 从未保存过的工作表
+        return;
+    }
+
+    impl_->shared_strings = workbook_impl->get_shared_strings();
+    impl_->stream = async::sync_wait(workbook_impl->get_archiver()->open_entry_stream(*part_path, buffer_size));
+    impl_->parser = std::make_unique<core::XmlParser>(*impl_->stream, *part_path);
+    impl_->parser->set_error_recovery(true);
+    impl_->it = impl_->parser->begin();
+    impl_->end = impl_->parser->end();
+}
+
+RowStream::~RowStream() = default;
+
+RowStream::RowStream(RowStream&& other) noexcept = default;
+
+RowStream& RowStream::operator=(RowStream&& other) noexcept = default;
+
+bool RowStream::next() {
+    auto& impl = *impl_;
+    while (!impl.at_end()) {
+        if (impl.it.is_start_element()) {
+            const std::string& name = impl.it.name();
+            if (name == "row") {
+                impl.read_row();
+                ++impl.it;
+                return true;
+            }
+            if (impl.row != 0 && name != "sheetData") {
+                // sheetData 之后不会再有行，不必解析工作表的其余部分
+                break;
+            }
+        }
+        ++impl.it;
+    }
+    impl.cell_count = 0;
+    impl.parser.reset();
+    impl.stream.reset();
+    return false;
+}
+
+std::size_t RowStream::row_index() const noexcept {
+    return impl_->row;
+}
+
+std::span<const StreamedCell> RowStream::cells() const noexcept {
+    return {impl_->cells.data(), impl_->cell_count};
+}
+
+std::size_t RowStream::rows_read() const noexcept {
+    return impl_->rows_read;
+}
+
+} // namespace tinakit::excel
@@ -0,0 +1,191 @@
+/**
+ * @file row_writer.cpp
+ * @brief 只追加式流式行写入器实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/excel/row_writer.hpp"
+#include "tinakit/excel/openxml_namespaces.hpp"
+#include "tinakit/excel/shared_strings.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include "tinakit/internal/coordinate_utils.hpp"
+#include "tinakit/internal/number_codec.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include "tinakit/core/xml_parser.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include "tinakit/internal/compact_cell.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tinakit::excel {
+
+// ========================================
+// RowWriter::Impl
+// ========================================
+
+struct RowWriter::Impl {
+    std::shared_ptr<internal::workbook_impl> workbook;
+    // 保持归档器存活，直到条目关闭
+    std::shared_ptr<core::OpenXmlArchiver> archiver;
+    std::unique_ptr<core::EntryOutputStream> out;
+    std::unique_ptr<core::XmlSerializer> serializer;
+
+    std::size_t rows_written = 0;
+
+    // 引用和数字写入复用的缓冲区，不为每个单元格分配
+    std::string cell_ref;
+    std::string number;
+    internal::utils::CoordinateUtils::CoordinateBuffer coordinate;
+    internal::utils::NumberCodec::NumberBuffer digits;
+
+    void write_cell(std::size_t column, const Cell::CellValue& value, std::uint32_t style_id);
+};
+
+void RowWriter::Impl::write_cell(std::size_t column, const Cell::CellValue& value, std::uint32_t style_id) {
+    if (std::holds_alternative<std::monostate>(value) && style_id == 0) {
+        return;
+    }
+
+    using internal::utils::NumberCodec;
+
+    serializer->start_element(openxml_ns::main, "c");
+    serializer->attribute("r", cell_ref.assign(internal::utils::CoordinateUtils::format_coordinate(rows_written, column, coordinate)));
+    if (style_id != 0) {
+        serializer->attribute("s", number.assign(NumberCodec::format_integer(style_id, digits)));
+    }
+
+    std::visit([&](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            serializer->attribute("t", "inlineStr");
+            serializer->start_element(openxml_ns::main, "is");
+            serializer->start_element(openxml_ns::main, "t");
+            if (SharedStrings::needs_space_preserve(v)) {
+                serializer->attribute(openxml_ns::xml, "space", "preserve");
+            }
+            serializer->characters(v);
+            serializer->end_element(); // t
+            serializer->end_element(); // is
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (!std::isfinite(v)) {
+                // 与单元格存储一致，非有限数字写为 #NUM! 错误
+                serializer->attribute("t", "e");
+                serializer->element_with_namespace(openxml_ns::main, "v",
+                    number.assign(internal::cell_error_text(internal::CellError::Num)));
+            } else {
+                // 最短往返表示，不丢失精度
+                serializer->element_with_namespace(openxml_ns::main, "v", number.assign(NumberCodec::format_number(v, digits)));
+            }
+        } else if constexpr (std::is_same_v<T, int>) {
+            serializer->element_with_namespace(openxml_ns::main, "v", number.assign(NumberCodec::format_integer(v, digits)));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            serializer->attribute("t", "b");
+            serializer->element_with_namespace(openxml_ns::main, "v", v ? "1" : "0");
+        }
+    }, value);
+
+    serializer->end_element(); // c
+}
+
+// ========================================
+// RowWriter
+// ========================================
+
+RowWriter::RowWriter(std::shared_ptr<internal::workbook_impl> workbook_impl,
+                     const std::string& sheet_name,
+                     std::size_t buffer_size)
+    : impl_(std::make_unique<Impl>()) {
+    if (!workbook_impl) {
+        throw TinaKitException("Workbook is not available", "RowWriter::RowWriter");
+    }
+
+    impl_->out = workbook_impl->begin_streaming_worksheet(sheet_name, buffer_size);
+    impl_->archiver = workbook_impl->get_archiver();
+    impl_->workbook = std::move(workbook_impl);
+
+    // 不缩进：流式输出的工作表通常很大，空白只会增加压缩负担
+    impl_->serializer = std::make_unique<core::XmlSerializer>(*impl_->out, sheet_name, 0);
+    impl_->serializer->xml_declaration("1.0", "UTF-8", "yes");
+    impl_->serializer->start_element(openxml_ns::main, "worksheet");
+    impl_->serializer->namespace_declaration(openxml_ns::main, "");
+    impl_->serializer->namespace_declaration(openxml_ns::rel, openxml_ns::r_prefix);
+    impl_->serializer->start_element(openxml_ns::main, "sheetData");
+}
+
+RowWriter::~RowWriter() {
+    if (impl_ && impl_->out) {
+        try {
+            close();
+        } catch (...) {
+            // 析构时无法报告错误
+        }
+    }
+}
+
+RowWriter::RowWriter(RowWriter&& other) noexcept = default;
+
+RowWriter& RowWriter::operator=(RowWriter&& other) noexcept {
+    if (this != &other) {
+        if (impl_ && impl_->out) {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+        impl_ = std::move(other.impl_);
+    }
+    return *this;
+}
+
+void RowWriter::append_row(std::span<const Cell::CellValue> values, std::uint32_t style_id) {
+    if (!is_open()) {
+        throw TinaKitException("RowWriter is closed", "RowWriter::append_row");
+    }
+
+    auto& impl = *impl_;
+    // 超出 Excel 行列上限的工作表无法打开，在写入任何内容前拒绝
+    using internal::utils::CoordinateUtils;
+    if (impl.rows_written >= CoordinateUtils::MAX_ROWS || values.size() > CoordinateUtils::MAX_COLUMNS) {
+        const std::size_t row = std::min(impl.rows_written + 1, CoordinateUtils::MAX_ROWS + 1);
+        const std::size_t column = std::min(values.size(), CoordinateUtils::MAX_COLUMNS + 1);
+        throw InvalidCellAddressException(std::string(CoordinateUtils::format_coordinate(row, std::max<std::size_t>(column, 1), impl.coordinate)));
+    }
+    ++impl.rows_written;
+
+    impl.serializer->start_element(openxml_ns::main, "row");
+    impl.serializer->attribute("r", impl.number.assign(internal::utils::NumberCodec::format_integer(impl.rows_written, impl.digits)));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        impl.write_cell(i + 1, values[i], style_id);
+    }
+    impl.serializer->end_element(); // row
+}
+
+void RowWriter::append_row(std::initializer_list<Cell::CellValue> values, std::uint32_t style_id) {
+    append_row(std::span<const Cell::CellValue>(values.begin(), values.size()), style_id);
+}
+
+std::size_t RowWriter::rows_written() const noexcept {
+    return impl_ ? impl_->rows_written : 0;
+}
+
+bool RowWriter::is_open() const noexcept {
+    return impl_ && impl_->out;
+}
+
+void RowWriter::close() {
+    if (!is_open()) {
+        return;
+    }
+
+    auto& impl = *impl_;
+    auto out = std::move(impl.out);
+    auto serializer = std::move(impl.serializer);
+
+    serializer->end_element(); // sheetData
+    serializer->end_element(); // worksheet
+    serializer.reset();
+    out->close();
+}
+
+} // namespace tinakit::excel
@@ -11,13 +11,139 @@
 #include <iostream>
 
 #include "tinakit/core/xml_parser.hpp"
-#include "tinakit/core/xml_parser.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include "tinakit/internal/sheet_data_scanner.hpp"
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
 namespace tinakit::excel {
 
+namespace {
+
+constexpr std::string_view WHITESPACE = " \t\n\r";
+
+std::string_view trim(std::string_view text) {
+    const auto start = text.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(start, text.find_last_not_of(WHITESPACE) - start + 1);
+}
+
+/**
+ * @brief <si> 的内容是否只有一个 <t> 元素（或为空）
+ */
+bool is_plain_item(std::string_view content) {
+    content = trim(content);
+    if (content.empty()) {
+        return true;
+    }
+    if (content.size() < 4 || content.substr(0, 2) != "<t" ||
+        (content[2] != '>' && content[2] != ' ' && content[2] != '/')) {
+        return false;
+    }
+    const auto open_end = content.find('>');
+    if (open_end == std::string_view::npos) {
+        return false;
+    }
+    if (content[open_end - 1] == '/') {
+        return open_end + 1 == content.size();
+    }
+    // 文本中的 '<' 必须转义，下一个 '<' 就是 <t> 的结束标签
+    const auto close = content.find('<', open_end);
+    return close != std::string_view::npos && content.substr(close) == "</t>";
+}
+
+/**
+ * @brief 富文本内容能否原样写回：元素名带前缀时依赖原文档的命名空间声明，只能按纯文本保存
+ */
+bool is_preservable_item(std::string_view content) {
+    for (auto pos = content.find('<'); pos != std::string_view::npos; pos = content.find('<', pos + 1)) {
+        auto name_start = pos + 1;
+        if (name_start < content.size() && content[name_start] == '/') {
+            ++name_start;
+        }
+        const auto name_end = content.find_first_of(" \t\n\r/>", name_start);
+        if (content.substr(name_start, name_end - name_start).find(':') != std::string_view::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 收集当前 <si> 中单元格文本（<si> 或 <r> 下的 <t>），跳过 rPh 等注音，保留首尾空白
+ *
+ * 与 internal::decode_rich_text() 的结果一致；返回时迭代器停在 </si> 上。
+ */
+std::string collect_item_text(core::XmlParser::iterator& it) {
+    std::string text;
+    int depth = 0;
+    bool in_run = false;
+    int text_depth = 0;  // 当前 <t> 所在的层级，0 表示不在 <t> 内
+    for (++it; !it.is_eof(); ++it) {
+        if (it.is_start_element()) {
+            // 未读取的属性（如 xml:space）会让解析器在下一个事件报错
+            (void)it.attributes();
+            ++depth;
+            in_run = in_run || (depth == 1 && it.name() == "r");
+            if (text_depth == 0 && it.name() == "t" && (depth == 1 || (depth == 2 && in_run))) {
+                text_depth = depth;
+            }
+        } else if (it.is_end_element()) {
+            if (depth == 0) {
+                break;
+            }
+            text_depth = depth == text_depth ? 0 : text_depth;
+            in_run = in_run && depth != 1;
+            --depth;
+        } else if (text_depth != 0 && it.is_characters()) {
+            text += it.value();
+        }
+    }
+    return text;
+}
+
+/**
+ * @brief 用通用解析器解码单个 <si> 的内容
+ */
+std::string parse_item(std::string_view content) {
+    std::string xml = "<si xmlns=\"" + OpenXmlNamespaces::spreadsheet_main() + "\">";
+    xml.append(content);
+    xml += "</si>";
+
+    std::string text;
+    core::XmlParser parser(std::string_view(xml), "sharedStrings.xml");
+    parser.for_each_element("si", [&text](core::XmlParser::iterator& it) {
+        text = collect_item_text(it);
+    });
+    return text;
+}
+
+void append_escaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '\r': out += "&#13;"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+} // namespace
+
+bool SharedStrings::needs_space_preserve(std::string_view text) noexcept {
+    return !text.empty() && (WHITESPACE.find(text.front()) != std::string_view::npos ||
+                             WHITESPACE.find(text.back()) != std::string_view::npos);
+}
+
 std::uint32_t SharedStrings::add_string(const std::string& str) {
+    build_index();
+    release_source();
+
     // 检查字符串是否已存在
     auto it = string_to_index_.find(str);
     if (it != string_to_index_.end()) {
@@ -33,6 +159,7 @@ std::uint32_t SharedStrings::add_string(const std::string& str) {
 }
 
 std::optional<std::uint32_t> SharedStrings::get_index(const std::string& str) const {
+    build_index();
     auto it = string_to_index_.find(str);
     if (it != string_to_index_.end()) {
         return it->second;
@@ -44,143 +171,172 @@ const std::string& SharedStrings::get_string(std::uint32_t index) const {
     if (index >= strings_.size()) {
         throw std::out_of_range("SharedStrings: index out of range: " + std::to_string(index));
     }
+    if (index < items_.size() && !decoded_[index].load(std::memory_order_acquire)) {
+        decode(index);
+    }
     return strings_[index];
 }
 
-void SharedStrings::clear() {
-    strings_.clear();
-    string_to_index_.clear();
+bool SharedStrings::is_decoded(std::uint32_t index) const noexcept {
+    if (index >= strings_.size()) {
+        return false;
+    }
+    return index >= items_.size() || decoded_[index].load(std::memory_order_acquire);
 }
 
-std::string SharedStrings::generate_xml() const {
-    std::ostringstream oss;
-    core::XmlSerializer serializer(oss, "sharedStrings.xml");
-
-    // XML声明
-    serializer.xml_declaration("1.0", "UTF-8", "yes");
-
-    // 开始sst元素（使用命名空间）
-    serializer.start_element(excel::openxml_ns::main, "sst");
-
-    // 声明命名空间
-    serializer.namespace_declaration(excel::openxml_ns::main, "");
-
-    // 添加count和uniqueCount属性
-    serializer.attribute("count", std::to_string(strings_.size()));
-    serializer.attribute("uniqueCount", std::to_string(strings_.size()));
-
-    // 为每个字符串生成 <si> 元素
-    for (const auto& str : strings_) {
-        serializer.start_element(excel::openxml_ns::main, "si");
-
-        // 添加 <t> 元素包含文本内容
-        // XmlSerializer会自动处理XML转义
-        serializer.element_with_namespace(excel::openxml_ns::main, "t", str);
-
-        serializer.end_element(); // si
+void SharedStrings::decode(std::uint32_t index) const {
+    std::lock_guard lock(decode_mutexes_[index % decode_mutexes_.size()]);
+    if (decoded_[index].load(std::memory_order_relaxed)) {
+        return;
     }
-
-    serializer.end_element(); // sst
-
-    // 获取生成的XML内容
-    std::string xml_content = oss.str();
-
-    return xml_content;
+    if (!internal::decode_rich_text(items_[index], strings_[index])) {
+        // 快速解码不支持的内容（<t> 内的注释等）交给通用解析器，格式错误时抛出 ParseException
+        strings_[index] = parse_item(items_[index]);
+    }
+    decoded_[index].store(true, std::memory_order_release);
 }
 
-void SharedStrings::load_from_xml(const std::string& xml_data) {
-    clear();
-    
-    std::istringstream stream(xml_data);
-    core::XmlParser parser(stream, "sharedStrings.xml");
-    
-    // 首先找到 sst 元素并获取 uniqueCount
-    for (auto it = parser.begin(); it != parser.end(); ++it) {
-        if (it.is_start_element() && it.name() == "sst") {
-            // 尝试获取 uniqueCount 以预分配内存
-            auto count_attr = it.attribute("uniqueCount");
-            if (count_attr) {
-                try {
-                    std::size_t unique_count = std::stoull(*count_attr);
-                    reserve(unique_count);
-                } catch (...) {
-                    // 忽略解析错误
-                }
-            }
-            break;
-        }
+void SharedStrings::build_index() const {
+    if (index_built_) {
+        return;
     }
-    
-    // 重新解析以提取字符串
-    stream.clear();
-    stream.seekg(0);
-    core::XmlParser parser2(stream, "sharedStrings.xml");
-    
-    // 使用改进的 API 解析每个 si 元素
-    parser2.for_each_element("si", [this](core::XmlParser::iterator& it) {
-        // si 元素可能包含 <t> 子元素或其他富文本元素
-        std::string text = it.text_content();
-
-        // 去除前后的空白字符（包括换行符、制表符、空格等）
-        if (!text.empty()) {
-            // 去除前面的空白字符
-            auto start = text.find_first_not_of(" \t\n\r");
-            if (start == std::string::npos) {
-                // 字符串全是空白字符
-                return;
-            }
-
-            // 去除后面的空白字符
-            auto end = text.find_last_not_of(" \t\n\r");
-            text = text.substr(start, end - start + 1);
-
-            if (!text.empty()) {
-                add_string(text);
-            }
+    // 单元格按位置引用 si，重复字符串保留第一次出现的索引；富文本在释放原文前保存其原始内容
+    string_to_index_.reserve(strings_.size());
+    for (std::uint32_t i = 0; i < strings_.size(); ++i) {
+        if (i < items_.size() && !is_plain_item(items_[i]) && is_preservable_item(items_[i])) {
+            rich_text_.try_emplace(i, trim(items_[i]));
+            get_string(i);
+            continue;
         }
-    });
+        string_to_index_.try_emplace(get_string(i), i);
+    }
+    index_built_ = true;
 }
 
-void SharedStrings::reserve(std::size_t size) {
-    strings_.reserve(size);
-    string_to_index_.reserve(size);
+void SharedStrings::release_source() {
+    // 全部字符串都已解码，不再需要 XML 原文
+    if (!items_.empty()) {
+        std::vector<std::string_view>().swap(items_);
+        decoded_.reset();
+        std::string().swap(source_);
+    }
 }
 
-bool SharedStrings::should_use_shared_string(const std::string& str) {
-    // 智能决策规则：
-    // 1. 空字符串使用内联
-    if (str.empty()) {
-        return false;
+std::optional<std::vector<std::uint32_t>> SharedStrings::compact(const std::vector<bool>& referenced) {
+    const std::size_t size = strings_.size();
+    if (referenced.size() >= size && std::all_of(referenced.begin(), referenced.begin() + size,
+                                                 [](bool used) { return used; })) {
+        return std::nullopt;
     }
 
-    // 2. 很短的字符串（1-2个字符）使用内联
-    if (str.length() <= 2) {
-        return false;
+    build_index();
+    release_source();
+
+    // 按原顺序保留被引用的字符串；新表容量固定，不会重新分配
+    std::vector<std::uint32_t> mapping(size, INVALID_INDEX);
+    std::vector<std::string> strings;
+    strings.reserve(size);
+    std::unordered_map<std::uint32_t, std::string> rich_text;
+    std::unordered_map<std::string, std::uint32_t> string_to_index;
+    string_to_index.reserve(size);
+    for (std::uint32_t i = 0; i < size; ++i) {
+        if (i >= referenced.size() || !referenced[i]) {
+            continue;
+        }
+        const auto next = static_cast<std::uint32_t>(strings.size());
+        if (auto rich = rich_text_.find(i); rich != rich_text_.end()) {
+            rich_text.emplace(next, std::move(rich->second));
+            strings.push_back(std::move(strings_[i]));
+            mapping[i] = next;
+            continue;
+        }
+        auto [it, inserted] = string_to_index.try_emplace(strings_[i], next);
+        if (inserted) {
+            strings.push_back(std::move(strings_[i]));
+        }
+        mapping[i] = it->second;
     }
 
-    // 3. 很长的字符串（>100字符）使用内联（避免共享字符串表过大）
-    if (str.length() > 100) {
-        return false;
+    strings_ = std::move(strings);
+    rich_text_ = std::move(rich_text);
+    string_to_index_ = std::move(string_to_index);
+    return mapping;
+}
+
+void SharedStrings::clear() {
+    items_.clear();
+    decoded_.reset();
+    source_.clear();
+    strings_.clear();
+    rich_text_.clear();
+    string_to_index_.clear();
+    index_built_ = false;
+}
+
+std::string SharedStrings::generate_xml(std::optional<std::size_t> reference_count) const {
+    // 富文本内容要原样写入，序列化器不支持写入 XML 片段，因此直接拼接
+    build_index();
+
+    std::string xml;
+    xml += "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+    xml += "<sst xmlns=\"";
+    xml += excel::openxml_ns::main;
+    xml += "\"";
+    if (reference_count) {
+        xml += " count=\"" + std::to_string(*reference_count) + "\"";
+    }
+    xml += " uniqueCount=\"" + std::to_string(strings_.size()) + "\">";
+
+    for (std::uint32_t i = 0; i < strings_.size(); ++i) {
+        xml += "<si>";
+        if (auto rich = rich_text_.find(i); rich != rich_text_.end()) {
+            xml += rich->second;
+        } else {
+            const std::string& text = get_string(i);
+            // 首尾空白需要 xml:space="preserve" 才能保留
+            xml += needs_space_preserve(text) ? "<t xml:space=\"preserve\">" : "<t>";
+            append_escaped(xml, text);
+            xml += "</t>";
+        }
+        xml += "</si>";
     }
+    xml += "</sst>";
+    return xml;
+}
 
-    // 4. 包含特殊字符或数字的字符串倾向于使用内联
-    bool has_digit = std::any_of(str.begin(), str.end(), ::isdigit);
-    if (has_digit && str.length() < 10) {
-        return false;
+void SharedStrings::load_from_xml(std::string xml_data) {
+    clear();
+    source_ = std::move(xml_data);
+
+    // 单次扫描只记录每个 <si> 的位置，文本在首次访问时才解码
+    const bool utf8 = core::simd::find_invalid_utf8(source_) == std::string_view::npos;
+    if (utf8 && internal::scan_shared_string_items(source_, items_)) {
+        strings_.resize(items_.size());
+        decoded_ = std::make_unique<std::atomic<bool>[]>(items_.size());
+        return;
     }
 
-    // 5. 常见的标题、标签类文本使用共享
-    // 包含中文、英文单词的文本倾向于共享
-    return true;
+    // UTF-16 文档或扫描器不支持的语法交给通用解析器（非法 UTF-8 在这里报错）
+    items_.clear();
+    const std::string xml = std::move(source_);
+    source_.clear();
+    load_with_parser(xml);
 }
 
-void SharedStrings::record_string_usage(const std::string& str) {
-    usage_count_[str]++;
+void SharedStrings::load_with_parser(const std::string& xml_data) {
+    core::XmlParser parser(std::string_view(xml_data), "sharedStrings.xml");
+
+    // 单元格按位置引用 si，空字符串和重复字符串也要占据各自的索引
+    parser.for_each_element("si", [this](core::XmlParser::iterator& it) {
+        strings_.push_back(collect_item_text(it));
+    });
 }
 
-std::size_t SharedStrings::get_usage_count(const std::string& str) const {
-    auto it = usage_count_.find(str);
-    return it != usage_count_.end() ? it->second : 0;
+void SharedStrings::reserve(std::size_t size) {
+    strings_.reserve(size);
+    if (index_built_) {
+        string_to_index_.reserve(size);
+    }
 }
 
 } // namespace tinakit::excel
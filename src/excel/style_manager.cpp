@@ -567,8 +567,7 @@ void StyleManager::load_from_xml(const std::string& xml_data) {
         // 清空现有样式，从XML中完全解析
         clear();
 
-        std::istringstream stream(xml_data);
-        core::XmlParser parser(stream, "styles.xml");
+        core::XmlParser parser(std::string_view(xml_data), "styles.xml");
 
         // 解析样式XML
         bool in_fonts = false;
@@ -7,12 +7,30 @@
 
 #include "tinakit/excel/workbook.hpp"
 #include "tinakit/excel/worksheet.hpp"
+#include "tinakit/excel/row_writer.hpp"
+#include "tinakit/excel/workbook_stream.hpp"
 #include "tinakit/internal/workbook_impl.hpp"
 #include "tinakit/core/exceptions.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
 #include <stdexcept>
 
 namespace tinakit::excel {
 
+namespace {
+
+/**
+ * @brief 执行 save_async() 中阻塞保存的线程池
+ *
+ * 保存过程会同步等待 I/O 完成，而完成后的协程在 I/O 执行器上恢复；保存若占用 I/O 执行器的线程，
+ * 并发保存数达到其线程数时就没有线程处理完成，因此使用独立的线程池。
+ */
+async::ThreadPoolExecutor& blocking_save_executor() {
+    static async::ThreadPoolExecutor executor;
+    return executor;
+}
+
+} // namespace
+
 // ========================================
 // 构造函数和析构函数
 // ========================================
@@ -34,9 +52,25 @@ Workbook Workbook::load(const std::filesystem::path& file_path) {
     return Workbook(impl);
 }
 
+Workbook Workbook::load(const std::filesystem::path& file_path, const Config& config) {
+    const std::size_t load_threads = config.enable_async ? config.thread_pool_size : 1;
+    auto impl = std::make_shared<internal::workbook_impl>(file_path, load_threads);
+    return Workbook(impl);
+}
+
 async::Task<Workbook> Workbook::load_async(const std::filesystem::path& file_path) {
-    // 在后台线程中执行加载操作
-    co_return load(file_path);
+    // 文件内容通过 I/O 后端读入，等待磁盘期间不占用调用线程；读完后在 I/O 执行器上解析
+    auto archiver = std::make_shared<core::OpenXmlArchiver>(
+        co_await core::OpenXmlArchiver::open_from_file(file_path.string(), core::SourceMode::Read));
+    co_return Workbook(std::make_shared<internal::workbook_impl>(file_path, std::move(archiver)));
+}
+
+WorkbookStream Workbook::load_many(std::vector<std::filesystem::path> paths, const LoadManyOptions& options) {
+    return WorkbookStream(std::move(paths), options);
+}
+
+WorkbookStream Workbook::load_many(std::vector<std::filesystem::path> paths) {
+    return WorkbookStream(std::move(paths), LoadManyOptions{});
 }
 
 Workbook Workbook::create() {
@@ -45,6 +79,12 @@ Workbook Workbook::create() {
     return Workbook(impl);
 }
 
+Workbook Workbook::create(const std::filesystem::path& file_path) {
+    auto impl = std::make_shared<internal::workbook_impl>();
+    impl->set_file_path(file_path);
+    return Workbook(impl);
+}
+
 // ========================================
 // 工作表访问
 // ========================================
@@ -89,6 +129,10 @@ Worksheet Workbook::create_worksheet(const std::string& name) {
     return impl_->create_worksheet(name);  // create_worksheet已经返回正确的worksheet对象
 }
 
+RowWriter Workbook::create_streaming_worksheet(const std::string& name) {
+    return RowWriter(impl_, name);
+}
+
 void Workbook::remove_worksheet(const std::string& name) {
     impl_->remove_worksheet(name);
 }
@@ -132,10 +176,20 @@ void Workbook::save(const std::filesystem::path& file_path) {
     }
 }
 
+void Workbook::save(const std::filesystem::path& file_path, const Config& config) {
+    const std::size_t deflate_threads = config.enable_async ? config.thread_pool_size : 1;
+    if (file_path.empty()) {
+        impl_->save(deflate_threads, config.write_profile, config.file_write_policy, config.shared_string_policy);
+    } else {
+        impl_->save(file_path, deflate_threads, config.write_profile, config.file_write_policy,
+                    config.shared_string_policy);
+    }
+}
+
 async::Task<void> Workbook::save_async(const std::filesystem::path& file_path) {
-    // TODO: 实现异步保存
+    // 保存在独立线程池上进行，调用线程不阻塞；输出文件在后台写入，与压缩重叠
+    co_await async::schedule_on(blocking_save_executor());
     save(file_path);
-    co_return;
 }
 
 // ========================================
@@ -0,0 +1,248 @@
+/**
+ * @file workbook_stream.cpp
+ * @brief 批量并发加载工作簿的结果流实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/excel/workbook_stream.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include "tinakit/core/async.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace tinakit::excel {
+
+namespace {
+
+/**
+ * @brief 创建后立即运行、结束时自行销毁的协程，协程体负责捕获所有异常
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+std::size_t resolve_thread_count(const Config& config) {
+    std::size_t threads = config.enable_async ? config.thread_pool_size : 1;
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+} // namespace
+
+// ========================================
+// LoadResult
+// ========================================
+
+Workbook& LoadResult::value() {
+    if (!workbook) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        throw TinaKitException("Workbook was not loaded", path.string());
+    }
+    return *workbook;
+}
+
+// ========================================
+// WorkbookStream::State
+// ========================================
+
+struct WorkbookStream::State : std::enable_shared_from_this<State> {
+    State(std::vector<std::filesystem::path> files, const LoadManyOptions& options)
+        : paths(std::move(files)),
+          memory_budget(options.config.max_memory_usage),
+          preserve_order(options.preserve_order),
+          executor(resolve_thread_count(options.config)) {
+        max_open = options.max_open_archives != 0 ? options.max_open_archives : resolve_thread_count(options.config);
+        max_ready = options.max_ready_results != 0 ? options.max_ready_results : max_open;
+
+        // 读取模式下整个归档常驻内存，按文件大小计入预算；无法获取大小的文件在打开时报错
+        charges.reserve(paths.size());
+        for (const auto& path : paths) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            charges.push_back(ec ? 0 : static_cast<std::uint64_t>(size));
+        }
+    }
+
+    /**
+     * @brief 领取所有可以开始加载的文件（调用时必须持有 mutex）
+     */
+    std::vector<std::size_t> admit() {
+        std::vector<std::size_t> indices;
+        while (!cancelled && next_to_start < paths.size() &&
+               in_flight < max_open && ready.size() < max_ready) {
+            const std::uint64_t charge = charges[next_to_start];
+            // 没有正在加载的文件和待取结果时总是放行，避免单个大文件或调用方保留的工作簿让流停滞
+            const bool idle = in_flight == 0 && ready.empty();
+            if (!idle && memory_in_use + charge > memory_budget) {
+                break;
+            }
+            memory_in_use += charge;
+            ++in_flight;
+            indices.push_back(next_to_start++);
+        }
+        return indices;
+    }
+
+    void launch(const std::vector<std::size_t>& indices) {
+        for (std::size_t index : indices) {
+            load(index);
+        }
+    }
+
+    /**
+     * @brief 归还预算并开始因预算不足而等待的文件
+     */
+    void release(std::uint64_t charge) {
+        std::vector<std::size_t> indices;
+        {
+            std::lock_guard lock(mutex);
+            memory_in_use -= charge;
+            indices = admit();
+        }
+        launch(indices);
+    }
+
+    DetachedTask load(std::size_t index) {
+        // 不在调用 next() 的线程上打开文件
+        co_await async::schedule_on(executor);
+
+        LoadResult result;
+        result.index = index;
+        result.path = paths[index];
+        try {
+            // 文件通过 I/O 后端读入，完成后回到本流的线程池上解析
+            auto archiver = std::make_shared<core::OpenXmlArchiver>(
+                co_await core::OpenXmlArchiver::open_from_file(result.path.string(), core::SourceMode::Read));
+            co_await async::schedule_on(executor);
+
+            // 工作簿及其所有副本销毁后才归还预算；流已销毁时不再需要归还
+            auto release_budget = [weak = weak_from_this(), charge = charges[index]](internal::workbook_impl* impl) {
+                delete impl;
+                if (auto state = weak.lock()) {
+                    state->release(charge);
+                }
+            };
+            std::shared_ptr<internal::workbook_impl> impl(
+                new internal::workbook_impl(result.path, std::move(archiver)), release_budget);
+            result.workbook = Workbook(std::move(impl));
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+        finish(std::move(result));
+    }
+
+    void finish(LoadResult result) {
+        const bool loaded = result.ok();
+        std::unique_lock lock(mutex);
+        if (!loaded) {
+            memory_in_use -= charges[result.index];
+        }
+        if (cancelled) {
+            // 工作簿的删除器会加锁归还预算，必须在锁外销毁
+            lock.unlock();
+            result = LoadResult{};
+            lock.lock();
+        } else {
+            ready.emplace(result.index, std::move(result));
+        }
+        --in_flight;
+        auto indices = admit();
+        changed.notify_all();
+        lock.unlock();
+        launch(indices);
+    }
+
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::uint64_t> charges;
+    std::uint64_t memory_budget;
+    std::size_t max_open = 1;
+    std::size_t max_ready = 1;
+    bool preserve_order;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t next_to_start = 0;
+    std::size_t emitted = 0;
+    std::size_t in_flight = 0;
+    std::uint64_t memory_in_use = 0;
+    std::map<std::size_t, LoadResult> ready;
+    bool cancelled = false;
+
+    // 最后声明、最先销毁：先等待工作线程退出，再销毁它们可能访问的成员
+    async::ThreadPoolExecutor executor;
+};
+
+// ========================================
+// WorkbookStream
+// ========================================
+
+WorkbookStream::WorkbookStream(std::vector<std::filesystem::path> paths, const LoadManyOptions& options)
+    : state_(std::make_shared<State>(std::move(paths), options)) {
+    std::vector<std::size_t> indices;
+    {
+        std::lock_guard lock(state_->mutex);
+        indices = state_->admit();
+    }
+    state_->launch(indices);
+}
+
+WorkbookStream::~WorkbookStream() {
+    if (!state_) {
+        return;
+    }
+    std::unique_lock lock(state_->mutex);
+    state_->cancelled = true;
+    state_->changed.wait(lock, [this] { return state_->in_flight == 0; });
+}
+
+WorkbookStream::WorkbookStream(WorkbookStream&& other) noexcept = default;
+
+WorkbookStream& WorkbookStream::operator=(WorkbookStream&& other) noexcept {
+    if (this != &other) {
+        WorkbookStream discarded(std::move(*this));
+        state_ = std::move(other.state_);
+    }
+    return *this;
+}
+
+std::optional<LoadResult> WorkbookStream::next() {
+    auto& state = *state_;
+    std::unique_lock lock(state.mutex);
+    while (state.emitted < state.paths.size()) {
+        auto it = state.preserve_order ? state.ready.find(state.emitted) : state.ready.begin();
+        if (it != state.ready.end()) {
+            LoadResult result = std::move(it->second);
+            state.ready.erase(it);
+            ++state.emitted;
+            auto indices = state.admit();
+            lock.unlock();
+            state.launch(indices);
+            return result;
+        }
+        state.changed.wait(lock);
+    }
+    return std::nullopt;
+}
+
+std::size_t WorkbookStream::size() const noexcept {
+    return state_->paths.size();
+}
+
+} // namespace tinakit::excel
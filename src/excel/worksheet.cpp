@@ -291,6 +291,11 @@ namespace tinakit::excel
         return RowRange(*this, 1, max_row());
     }
 
+    RowStream Worksheet::stream_rows(std::size_t buffer_size) const
+    {
+        return RowStream(workbook_impl_, sheet_name_, buffer_size);
+    }
+
     Range Worksheet::range(const std::string& range_str)
     {
         auto range_addr = internal::utils::CoordinateUtils::string_to_range_address(range_str);
@@ -0,0 +1,545 @@
+/**
+ * @file cell_store.cpp
+ * @brief 行块列式单元格存储实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/cell_store.hpp"
+#include "tinakit/internal/coordinate_utils.hpp"
+#include "tinakit/core/exceptions.hpp"
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace tinakit::internal {
+
+namespace {
+
+/**
+ * @brief 超出 Excel 行列上限的坐标无法保存，写入前拒绝
+ */
+void check_bounds(std::size_t row, std::size_t column) {
+    if (row > utils::CoordinateUtils::MAX_ROWS || column > utils::CoordinateUtils::MAX_COLUMNS) {
+        utils::CoordinateUtils::CoordinateBuffer buffer;
+        throw InvalidCellAddressException(std::string(utils::CoordinateUtils::format_coordinate(row, column, buffer)));
+    }
+}
+
+} // namespace
+
+// ========================================
+// 构造函数和析构函数
+// ========================================
+
+CellStore::CellStore(core::StringPool& strings, FormulaArena* formulas, const excel::SharedStrings* shared_strings)
+    : strings_(strings),
+      owned_formulas_(formulas ? nullptr : std::make_unique<FormulaArena>()),
+      formulas_(formulas ? formulas : owned_formulas_.get()),
+      shared_strings_(shared_strings) {
+}
+
+CellStore::~CellStore() {
+    // 共享的公式表比存储活得更久，归还本存储占用的表项
+    if (!owned_formulas_) {
+        release_formulas(0, std::numeric_limits<std::size_t>::max());
+    }
+}
+
+CellStore::CellStore(CellStore&&) noexcept = default;
+
+// ========================================
+// 单元格访问
+// ========================================
+
+std::optional<CompactCell> CellStore::cell(const core::Coordinate& pos) const {
+    const std::size_t b = block_index(pos.row);
+    if (b >= blocks_.size() || !blocks_[b]) {
+        return std::nullopt;
+    }
+    const auto* chunk = find_chunk(*blocks_[b], pos.column);
+    const std::size_t offset = row_offset(pos.row);
+    if (!chunk || !chunk->present.test(offset)) {
+        return std::nullopt;
+    }
+    return read_cell(*chunk, offset);
+}
+
+std::optional<cell_data> CellStore::get(const core::Coordinate& pos) const {
+    auto cell = view(pos);
+    if (!cell) {
+        return std::nullopt;
+    }
+    return cell->to_cell_data();
+}
+
+std::optional<CellView> CellStore::view(const core::Coordinate& pos) const {
+    auto compact = cell(pos);
+    if (!compact) {
+        return std::nullopt;
+    }
+    return resolve(*compact);
+}
+
+bool CellStore::contains(const core::Coordinate& pos) const {
+    const std::size_t b = block_index(pos.row);
+    if (b >= blocks_.size() || !blocks_[b]) {
+        return false;
+    }
+    const auto* chunk = find_chunk(*blocks_[b], pos.column);
+    return chunk && chunk->present.test(row_offset(pos.row));
+}
+
+void CellStore::set(const core::Coordinate& pos, const cell_data& data) {
+    check_bounds(pos.row, pos.column);
+    write_cell(pos, make_cell(data));
+}
+
+void CellStore::set(const core::Coordinate& pos, const CellView& view) {
+    check_bounds(pos.row, pos.column);
+    write_cell(pos, make_cell(view));
+}
+
+bool CellStore::erase(const core::Coordinate& pos) {
+    const std::size_t b = block_index(pos.row);
+    if (b >= blocks_.size() || !blocks_[b]) {
+        return false;
+    }
+    auto& block = *blocks_[b];
+    auto it = std::lower_bound(block.columns.begin(), block.columns.end(), pos.column,
+        [](const ColumnChunk& chunk, std::size_t column) { return chunk.column < column; });
+    const std::size_t offset = row_offset(pos.row);
+    if (it == block.columns.end() || it->column != pos.column || !it->present.test(offset)) {
+        return false;
+    }
+
+    if (it->kinds[offset] == CellKind::Formula) {
+        formulas_->release(it->ids[offset]);
+    }
+    it->present.reset(offset);
+    it->booleans.reset(offset);
+    it->kinds[offset] = CellKind::Empty;
+    if (it->style_ids) {
+        it->style_ids[offset] = 0;
+    }
+
+    --block.row_counts[offset];
+    --block.cell_count;
+    --cell_count_;
+
+    // 列块已空则释放，行块已空则释放
+    if (it->present.none()) {
+        block.columns.erase(it);
+    }
+    if (block.cell_count == 0) {
+        blocks_[b].reset();
+        while (!blocks_.empty() && !blocks_.back()) {
+            blocks_.pop_back();
+        }
+    }
+    return true;
+}
+
+void CellStore::clear() {
+    release_formulas(0, std::numeric_limits<std::size_t>::max());
+    blocks_.clear();
+    blocks_.shrink_to_fit();
+    cell_count_ = 0;
+}
+
+std::size_t CellStore::memory_usage() const noexcept {
+    std::size_t bytes = sizeof(*this) + blocks_.capacity() * sizeof(std::unique_ptr<RowBlock>);
+    for (const auto& block : blocks_) {
+        if (!block) {
+            continue;
+        }
+        bytes += sizeof(RowBlock) + block->columns.capacity() * sizeof(ColumnChunk);
+        for (const auto& chunk : block->columns) {
+            if (chunk.numbers) bytes += BLOCK_ROWS * sizeof(double);
+            if (chunk.ids) bytes += BLOCK_ROWS * sizeof(std::uint32_t);
+            if (chunk.style_ids) bytes += BLOCK_ROWS * sizeof(std::uint32_t);
+        }
+    }
+    return bytes;
+}
+
+std::optional<core::range_address> CellStore::bounds() const {
+    if (cell_count_ == 0) {
+        return std::nullopt;
+    }
+
+    std::size_t min_row = std::numeric_limits<std::size_t>::max();
+    std::size_t max_row = 0;
+    std::size_t min_col = std::numeric_limits<std::size_t>::max();
+    std::size_t max_col = 0;
+
+    for (std::size_t b = 0; b < blocks_.size(); ++b) {
+        const auto* block = blocks_[b].get();
+        if (!block || block->cell_count == 0) {
+            continue;
+        }
+        for (std::size_t offset = 0; offset < BLOCK_ROWS; ++offset) {
+            if (block->row_counts[offset] != 0) {
+                min_row = std::min(min_row, (b << BLOCK_SHIFT) | offset);
+                max_row = std::max(max_row, (b << BLOCK_SHIFT) | offset);
+            }
+        }
+        // 列块按列号有序，且只保留非空列块
+        min_col = std::min(min_col, block->columns.front().column);
+        max_col = std::max(max_col, block->columns.back().column);
+    }
+
+    return core::range_address(core::Coordinate(min_row, min_col), core::Coordinate(max_row, max_col));
+}
+
+// ========================================
+// 行列移动
+// ========================================
+
+void CellStore::insert_rows(std::size_t row, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // 最后一行下移后不能超出上限
+    if (auto range = bounds(); range && range->end.row >= row) {
+        const std::size_t last = range->end.row;
+        check_bounds(count > utils::CoordinateUtils::MAX_ROWS - last ? utils::CoordinateUtils::MAX_ROWS + 1 : last + count,
+                     range->end.column);
+    }
+    for (auto& [pos, cell] : drain()) {
+        if (pos.row >= row) {
+            pos.row += count;
+        }
+        write_cell(pos, cell);
+    }
+}
+
+void CellStore::delete_rows(std::size_t row, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    for (auto& [pos, cell] : drain()) {
+        if (pos.row >= row && pos.row < row + count) {
+            if (cell.has_formula()) {
+                formulas_->release(cell.payload.id);
+            }
+            continue;
+        }
+        if (pos.row >= row + count) {
+            pos.row -= count;
+        }
+        write_cell(pos, cell);
+    }
+}
+
+void CellStore::insert_columns(std::size_t column, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    // 最后一列右移后不能超出上限
+    if (auto range = bounds(); range && range->end.column >= column) {
+        const std::size_t last = range->end.column;
+        check_bounds(range->end.row,
+                     count > utils::CoordinateUtils::MAX_COLUMNS - last ? utils::CoordinateUtils::MAX_COLUMNS + 1 : last + count);
+    }
+    // 列块自带列号，直接平移即可，顺序不变
+    for (auto& block : blocks_) {
+        if (!block) {
+            continue;
+        }
+        for (auto& chunk : block->columns) {
+            if (chunk.column >= column) {
+                chunk.column += count;
+            }
+        }
+    }
+}
+
+void CellStore::delete_columns(std::size_t column, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    release_formulas(column, column + count - 1);
+    for (std::size_t b = 0; b < blocks_.size(); ++b) {
+        auto& block = blocks_[b];
+        if (!block) {
+            continue;
+        }
+        auto& columns = block->columns;
+        auto removed = std::remove_if(columns.begin(), columns.end(), [&](const ColumnChunk& chunk) {
+            if (chunk.column < column || chunk.column >= column + count) {
+                return false;
+            }
+            for (std::size_t offset = 0; offset < BLOCK_ROWS; ++offset) {
+                if (chunk.present.test(offset)) {
+                    --block->row_counts[offset];
+                }
+            }
+            const std::size_t cells = chunk.present.count();
+            block->cell_count -= cells;
+            cell_count_ -= cells;
+            return true;
+        });
+        columns.erase(removed, columns.end());
+
+        for (auto& chunk : columns) {
+            if (chunk.column >= column + count) {
+                chunk.column -= count;
+            }
+        }
+        if (block->cell_count == 0) {
+            block.reset();
+        }
+    }
+    while (!blocks_.empty() && !blocks_.back()) {
+        blocks_.pop_back();
+    }
+}
+
+// ========================================
+// 共享字符串
+// ========================================
+
+void CellStore::mark_shared_strings(std::vector<bool>& referenced) const {
+    for_each_cell([&referenced](const core::Coordinate&, const CompactCell& cell) {
+        if (cell.kind != CellKind::SharedString) {
+            return;
+        }
+        if (cell.payload.id >= referenced.size()) {
+            referenced.resize(cell.payload.id + 1);
+        }
+        referenced[cell.payload.id] = true;
+    });
+}
+
+void CellStore::remap_shared_strings(const std::vector<std::uint32_t>& mapping) {
+    for (auto& block : blocks_) {
+        if (!block) {
+            continue;
+        }
+        for (auto& chunk : block->columns) {
+            for (std::size_t offset = 0; offset < BLOCK_ROWS; ++offset) {
+                if (chunk.present.test(offset) && chunk.kinds[offset] == CellKind::SharedString) {
+                    chunk.ids[offset] = mapping[chunk.ids[offset]];
+                }
+            }
+        }
+    }
+}
+
+// ========================================
+// 私有方法
+// ========================================
+
+const CellStore::ColumnChunk* CellStore::find_chunk(const RowBlock& block, std::size_t column) const {
+    auto it = std::lower_bound(block.columns.begin(), block.columns.end(), column,
+        [](const ColumnChunk& chunk, std::size_t col) { return chunk.column < col; });
+    if (it == block.columns.end() || it->column != column) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+CellStore::ColumnChunk& CellStore::get_or_create_chunk(RowBlock& block, std::size_t column) {
+    auto it = std::lower_bound(block.columns.begin(), block.columns.end(), column,
+        [](const ColumnChunk& chunk, std::size_t col) { return chunk.column < col; });
+    if (it != block.columns.end() && it->column == column) {
+        return *it;
+    }
+    return *block.columns.emplace(it, column);
+}
+
+CompactCell CellStore::make_cell(const cell_data& data) {
+    CompactCell cell;
+    std::visit([&cell, this](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            cell.kind = CellKind::String;
+            cell.payload.id = strings_.intern(value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (std::isfinite(value)) {
+                cell.kind = CellKind::Number;
+                cell.payload.number = value;
+            } else {
+                // 非有限数字无法写入 <v>，与 Excel 一样表示为 #NUM!
+                cell.kind = CellKind::Error;
+                cell.payload.error = CellError::Num;
+            }
+        } else if constexpr (std::is_same_v<T, int>) {
+            cell.kind = CellKind::Integer;
+            cell.payload.number = static_cast<double>(value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            cell.kind = CellKind::Boolean;
+            cell.payload.boolean = value;
+        }
+    }, data.value);
+
+    if (data.formula) {
+        cell.payload.id = formulas_->add(strings_.intern(*data.formula), cell.kind, cell.payload);
+        cell.kind = CellKind::Formula;
+    }
+    cell.style_id = data.style_id;
+    return cell;
+}
+
+CompactCell CellStore::make_cell(const CellView& view) {
+    CompactCell cell;
+    cell.kind = view.kind;
+    switch (view.kind) {
+    case CellKind::String:
+        if (view.shared_index && shared_strings_ && !view.formula) {
+            // 共享字符串只保存索引，不驻留文本；公式的缓存结果仍驻留到字符串池
+            cell.kind = CellKind::SharedString;
+            cell.payload.id = *view.shared_index;
+        } else {
+            cell.payload.id = strings_.intern(view.text);
+        }
+        break;
+    case CellKind::Number:
+        if (!std::isfinite(view.number)) {
+            cell.kind = CellKind::Error;
+            cell.payload.error = CellError::Num;
+            break;
+        }
+        cell.payload.number = view.number;
+        break;
+    case CellKind::Integer:
+        cell.payload.number = view.number;
+        break;
+    case CellKind::Boolean:
+        cell.payload.boolean = view.boolean;
+        break;
+    case CellKind::Error:
+        cell.payload.error = view.error;
+        break;
+    case CellKind::Empty:
+    case CellKind::Formula:
+    case CellKind::SharedString:
+        cell.kind = CellKind::Empty;
+        break;
+    }
+
+    if (view.formula) {
+        cell.payload.id = formulas_->add(strings_.intern(*view.formula), cell.kind, cell.payload);
+        cell.kind = CellKind::Formula;
+    }
+    cell.style_id = view.style_id;
+    return cell;
+}
+
+CompactCell CellStore::read_cell(const ColumnChunk& chunk, std::size_t offset) {
+    CompactCell cell;
+    cell.kind = chunk.kinds[offset];
+    switch (cell.kind) {
+        case CellKind::Number:
+        case CellKind::Integer:
+            cell.payload.number = chunk.numbers[offset];
+            break;
+        case CellKind::Boolean:
+            cell.payload.boolean = chunk.booleans.test(offset);
+            break;
+        case CellKind::String:
+        case CellKind::SharedString:
+        case CellKind::Formula:
+            cell.payload.id = chunk.ids[offset];
+            break;
+        case CellKind::Error:
+            cell.payload.error = static_cast<CellError>(chunk.ids[offset]);
+            break;
+        case CellKind::Empty:
+            break;
+    }
+    if (chunk.style_ids) {
+        cell.style_id = chunk.style_ids[offset];
+    }
+    return cell;
+}
+
+void CellStore::write_cell(const core::Coordinate& pos, const CompactCell& cell) {
+    // 行块数组按行号分配，调用者必须先拒绝超出 Excel 上限的行号
+    assert(pos.row <= utils::CoordinateUtils::MAX_ROWS);
+    const std::size_t b = block_index(pos.row);
+    if (b >= blocks_.size()) {
+        blocks_.resize(b + 1);
+    }
+    if (!blocks_[b]) {
+        blocks_[b] = std::make_unique<RowBlock>();
+    }
+    auto& block = *blocks_[b];
+    auto& chunk = get_or_create_chunk(block, pos.column);
+    const std::size_t offset = row_offset(pos.row);
+
+    if (!chunk.present.test(offset)) {
+        chunk.present.set(offset);
+        ++block.row_counts[offset];
+        ++block.cell_count;
+        ++cell_count_;
+    } else if (chunk.kinds[offset] == CellKind::Formula) {
+        // 覆盖公式单元格时归还原来的公式表项
+        formulas_->release(chunk.ids[offset]);
+    }
+
+    chunk.kinds[offset] = cell.kind;
+    chunk.booleans.set(offset, cell.kind == CellKind::Boolean && cell.payload.boolean);
+
+    switch (cell.kind) {
+        case CellKind::Number:
+        case CellKind::Integer:
+            if (!chunk.numbers) chunk.numbers = std::make_unique<double[]>(BLOCK_ROWS);
+            chunk.numbers[offset] = cell.payload.number;
+            break;
+        case CellKind::String:
+        case CellKind::SharedString:
+        case CellKind::Formula:
+        case CellKind::Error: {
+            if (!chunk.ids) chunk.ids = std::make_unique<std::uint32_t[]>(BLOCK_ROWS);
+            chunk.ids[offset] = cell.kind == CellKind::Error ? static_cast<std::uint32_t>(cell.payload.error)
+                                                             : cell.payload.id;
+            break;
+        }
+        case CellKind::Boolean:
+        case CellKind::Empty:
+            break;
+    }
+
+    if (cell.style_id != 0 && !chunk.style_ids) {
+        chunk.style_ids = std::make_unique<std::uint32_t[]>(BLOCK_ROWS);
+    }
+    if (chunk.style_ids) {
+        chunk.style_ids[offset] = cell.style_id;
+    }
+}
+
+void CellStore::release_formulas(std::size_t first_column, std::size_t last_column) {
+    visit(0, std::numeric_limits<std::size_t>::max(), first_column, last_column,
+          [this](const core::Coordinate&, const ColumnChunk& chunk, std::size_t offset) {
+              if (chunk.kinds[offset] == CellKind::Formula) {
+                  formulas_->release(chunk.ids[offset]);
+              }
+          });
+}
+
+std::vector<std::pair<core::Coordinate, CompactCell>> CellStore::drain() {
+    std::vector<std::pair<core::Coordinate, CompactCell>> cells;
+    cells.reserve(cell_count_);
+    for (std::size_t b = 0; b < blocks_.size(); ++b) {
+        const auto* block = blocks_[b].get();
+        if (!block) {
+            continue;
+        }
+        for (const auto& chunk : block->columns) {
+            for (std::size_t offset = 0; offset < BLOCK_ROWS; ++offset) {
+                if (chunk.present.test(offset)) {
+                    cells.emplace_back(core::Coordinate((b << BLOCK_SHIFT) | offset, chunk.column),
+                                       read_cell(chunk, offset));
+                }
+            }
+        }
+    }
+    // 公式表项随单元格转移，不能经 clear() 归还
+    blocks_.clear();
+    cell_count_ = 0;
+    return cells;
+}
+
+} // namespace tinakit::internal
@@ -0,0 +1,143 @@
+/**
+ * @file compact_cell.cpp
+ * @brief 紧凑单元格、公式表和单元格视图的实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/compact_cell.hpp"
+#include "tinakit/excel/shared_strings.hpp"
+#include <array>
+
+namespace tinakit::internal {
+
+namespace {
+
+constexpr std::array<std::string_view, 8> ERROR_TEXTS = {
+    "#NULL!", "#DIV/0!", "#VALUE!", "#REF!", "#NAME?", "#NUM!", "#N/A", "#GETTING_DATA"
+};
+
+} // namespace
+
+// ========================================
+// 错误值
+// ========================================
+
+std::string_view cell_error_text(CellError error) noexcept {
+    const auto index = static_cast<std::size_t>(error);
+    return index < ERROR_TEXTS.size() ? ERROR_TEXTS[index] : std::string_view("#N/A");
+}
+
+std::optional<CellError> parse_cell_error(std::string_view text) noexcept {
+    for (std::size_t i = 0; i < ERROR_TEXTS.size(); ++i) {
+        if (ERROR_TEXTS[i] == text) {
+            return static_cast<CellError>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+// ========================================
+// FormulaArena
+// ========================================
+
+FormulaArena::FormulaId FormulaArena::add(core::StringPool::StringId text, CellKind result_kind, CellPayload result) {
+    Entry entry;
+    entry.text = text;
+    entry.result_kind = result_kind;
+    entry.result = result;
+
+    if (!free_.empty()) {
+        const FormulaId id = free_.back();
+        free_.pop_back();
+        entries_[id] = entry;
+        return id;
+    }
+    entries_.push_back(entry);
+    return static_cast<FormulaId>(entries_.size() - 1);
+}
+
+void FormulaArena::release(FormulaId id) {
+    entries_[id] = Entry{};
+    free_.push_back(id);
+}
+
+// ========================================
+// CellView
+// ========================================
+
+cell_data CellView::to_cell_data() const {
+    cell_data data;
+    switch (kind) {
+        case CellKind::Number:
+            data.value = number;
+            break;
+        case CellKind::Integer:
+            data.value = static_cast<int>(number);
+            break;
+        case CellKind::Boolean:
+            data.value = boolean;
+            break;
+        case CellKind::String:
+            data.value = std::string(text);
+            break;
+        case CellKind::Error:
+            data.value = std::string(cell_error_text(error));
+            break;
+        case CellKind::Empty:
+        case CellKind::Formula:
+        case CellKind::SharedString:
+            break;
+    }
+    if (formula) {
+        data.formula = std::string(*formula);
+    }
+    data.style_id = style_id;
+    return data;
+}
+
+CellView resolve_cell(const CompactCell& cell, const core::StringPool& strings, const FormulaArena& formulas,
+                      const excel::SharedStrings* shared_strings) {
+    CellView view;
+    view.style_id = cell.style_id;
+
+    CellKind kind = cell.kind;
+    CellPayload payload = cell.payload;
+    if (kind == CellKind::Formula) {
+        const auto& entry = formulas.get(cell.payload.id);
+        view.formula = strings.get_string(entry.text);
+        kind = entry.result_kind;
+        payload = entry.result;
+    }
+
+    view.kind = kind;
+    switch (kind) {
+        case CellKind::Number:
+        case CellKind::Integer:
+            view.number = payload.number;
+            break;
+        case CellKind::Boolean:
+            view.boolean = payload.boolean;
+            break;
+        case CellKind::String:
+            view.text = strings.get_string(payload.id);
+            break;
+        case CellKind::SharedString:
+            // 文本在这里才从共享字符串表中取出（首次访问时解码）
+            view.kind = CellKind::String;
+            view.shared_index = payload.id;
+            if (shared_strings) {
+                view.text = shared_strings->get_string(payload.id);
+            }
+            break;
+        case CellKind::Error:
+            view.error = payload.error;
+            break;
+        case CellKind::Empty:
+        case CellKind::Formula:
+            break;
+    }
+    return view;
+}
+
+} // namespace tinakit::internal
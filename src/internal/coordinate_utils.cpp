@@ -11,6 +11,7 @@
 #include <regex>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 
 namespace tinakit::internal::utils {
 
@@ -40,7 +41,7 @@ core::Coordinate CoordinateUtils::string_to_coordinate(std::string_view str) {
         throw InvalidCellAddressException(std::string(str));
     }
 
-    if (row == 0) {
+    if (row == 0 || row > MAX_ROWS || column > MAX_COLUMNS) {
         throw InvalidCellAddressException(std::string(str));
     }
     
@@ -52,8 +53,26 @@ std::string CoordinateUtils::coordinate_to_string(const core::Coordinate& coord)
         throw InvalidCellAddressException("Invalid coordinate: row and column must be greater than 0");
     }
     
-    std::string col_letters = column_number_to_letters(coord.column);
-    return col_letters + std::to_string(coord.row);
+    CoordinateBuffer buffer;
+    return std::string(format_coordinate(coord.row, coord.column, buffer));
+}
+
+std::string_view CoordinateUtils::format_coordinate(std::size_t row, std::size_t column, CoordinateBuffer& buffer) noexcept {
+    // 列字母从低位到高位生成，先倒序写入临时区再正序拷贝
+    char letters[16];
+    std::size_t count = 0;
+    while (column > 0) {
+        --column;  // 转换为0-based
+        letters[count++] = static_cast<char>('A' + column % 26);
+        column /= 26;
+    }
+
+    char* out = buffer.data();
+    while (count > 0) {
+        *out++ = letters[--count];
+    }
+    auto [end, ec] = std::to_chars(out, buffer.data() + buffer.size(), row);
+    return std::string_view(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
 }
 
 // ========================================
@@ -120,9 +139,10 @@ std::string CoordinateUtils::column_number_to_letters(std::size_t column_number)
     std::string result;
     while (column_number > 0) {
         column_number--;  // 转换为0-based
-        result = char('A' + (column_number % 26)) + result;
+        result.push_back(char('A' + (column_number % 26)));
         column_number /= 26;
     }
+    std::reverse(result.begin(), result.end());
     
     return result;
 }
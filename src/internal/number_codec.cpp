@@ -0,0 +1,47 @@
+/**
+ * @file number_codec.cpp
+ * @brief 数字编解码工具实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/number_codec.hpp"
+#include <cmath>
+
+namespace tinakit::internal::utils {
+
+std::string_view NumberCodec::format_number(double value, NumberBuffer& buffer) noexcept {
+    // 不指定格式时 to_chars 输出最短往返表示，并在定点和科学计数法中取较短者
+    auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return std::string_view(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
+}
+
+std::string NumberCodec::format_number(double value) {
+    NumberBuffer buffer;
+    return std::string(format_number(value, buffer));
+}
+
+std::optional<int> NumberCodec::parse_integer(std::string_view text) noexcept {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    int value = 0;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc() || ptr != last) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<double> NumberCodec::parse_number(std::string_view text) noexcept {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    // from_chars 接受 "inf"、"nan" 等，单元格中不存在非有限数字
+    if (ec != std::errc() || ptr != last || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace tinakit::internal::utils
@@ -0,0 +1,608 @@
+/**
+ * @file sheet_data_scanner.cpp
+ * @brief sheetData 专用的零拷贝扫描器实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/sheet_data_scanner.hpp"
+#include "tinakit/internal/coordinate_utils.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include <charconv>
+
+namespace tinakit::internal {
+
+namespace simd = core::simd;
+
+namespace {
+
+bool is_xml_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool is_name_end(char c) noexcept {
+    return is_xml_space(c) || c == '>' || c == '/';
+}
+
+/**
+ * @brief 依次回调开始标签中的每个属性（属性值不做实体解码）
+ */
+template <typename Fn>
+void for_each_attribute(std::string_view attributes, Fn&& fn) {
+    std::size_t i = 0;
+    const std::size_t size = attributes.size();
+    while (true) {
+        while (i < size && is_xml_space(attributes[i])) ++i;
+        if (i >= size) {
+            return;
+        }
+        const std::size_t name_begin = i;
+        while (i < size && attributes[i] != '=' && !is_xml_space(attributes[i])) ++i;
+        const std::string_view name = attributes.substr(name_begin, i - name_begin);
+        while (i < size && is_xml_space(attributes[i])) ++i;
+        if (i >= size || attributes[i] != '=') {
+            return;
+        }
+        ++i;
+        while (i < size && is_xml_space(attributes[i])) ++i;
+        if (i >= size || (attributes[i] != '"' && attributes[i] != '\'')) {
+            return;
+        }
+        const char quote = attributes[i++];
+        const std::size_t value_end = attributes.find(quote, i);
+        if (value_end == std::string_view::npos) {
+            return;
+        }
+        fn(name, attributes.substr(i, value_end - i));
+        i = value_end + 1;
+    }
+}
+
+template <typename T>
+bool parse_unsigned(std::string_view text, T& value) noexcept {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+void append_utf8(std::string& out, std::uint32_t code_point) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+/**
+ * @brief 把解码后的文本追加到 out
+ */
+bool append_decoded(std::string_view raw, std::string& out) {
+    std::size_t i = 0;
+    while (i < raw.size()) {
+        const std::size_t special = simd::find_any(raw, "&\r", i);
+        if (special == std::string_view::npos) {
+            out.append(raw.substr(i));
+            return true;
+        }
+        out.append(raw.substr(i, special - i));
+
+        if (raw[special] == '\r') {
+            // XML 换行规范化：\r\n 和单独的 \r 都视为 \n
+            out.push_back('\n');
+            i = special + 1;
+            if (i < raw.size() && raw[i] == '\n') {
+                ++i;
+            }
+            continue;
+        }
+
+        const std::size_t semicolon = raw.find(';', special);
+        if (semicolon == std::string_view::npos) {
+            return false;
+        }
+        const std::string_view entity = raw.substr(special + 1, semicolon - special - 1);
+        if (entity == "lt") {
+            out.push_back('<');
+        } else if (entity == "gt") {
+            out.push_back('>');
+        } else if (entity == "amp") {
+            out.push_back('&');
+        } else if (entity == "quot") {
+            out.push_back('"');
+        } else if (entity == "apos") {
+            out.push_back('\'');
+        } else if (entity.size() > 1 && entity[0] == '#') {
+            std::uint32_t code_point = 0;
+            const bool hex = entity[1] == 'x';
+            const std::string_view digits = entity.substr(hex ? 2 : 1);
+            auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), code_point, hex ? 16 : 10);
+            if (ec != std::errc() || ptr != digits.data() + digits.size() || code_point > 0x10FFFF) {
+                return false;
+            }
+            append_utf8(out, code_point);
+        } else {
+            return false;
+        }
+        i = semicolon + 1;
+    }
+    return true;
+}
+
+enum class TagScan { Tag, NoTag, Incomplete, Unsupported };
+
+struct RawTag {
+    bool closing = false;
+    bool empty = false;
+    std::string_view name;        ///< 本地名（去掉前缀）
+    std::string_view attributes;  ///< 元素名之后到 '>' 之前的内容
+};
+
+/**
+ * @brief 从 pos 开始查找并读取下一个标签
+ *
+ * 成功时 pos 移到标签之后；没有更多标签时 pos 移到末尾；标签不完整或是
+ * CDATA、注释、处理指令时 pos 停在 '<' 处。
+ */
+TagScan scan_tag(std::string_view xml, std::size_t& pos, RawTag& tag) {
+    pos = simd::find_any(xml, "<", pos);
+    if (pos == std::string_view::npos) {
+        pos = xml.size();
+        return TagScan::NoTag;
+    }
+    if (pos + 1 >= xml.size()) {
+        return TagScan::Incomplete;
+    }
+
+    const char first = xml[pos + 1];
+    if (first == '!' || first == '?') {
+        return TagScan::Unsupported;
+    }
+    const bool closing = first == '/';
+
+    std::size_t i = pos + (closing ? 2 : 1);
+    const std::size_t name_begin = i;
+    while (i < xml.size() && !is_name_end(xml[i])) ++i;
+    std::string_view name = xml.substr(name_begin, i - name_begin);
+    if (const std::size_t colon = name.rfind(':'); colon != std::string_view::npos) {
+        name.remove_prefix(colon + 1);
+    }
+
+    // 属性值中允许出现 '>'，需要跳过引号内的内容
+    const std::size_t attributes_begin = i;
+    while (true) {
+        i = simd::find_any(xml, ">\"'", i);
+        if (i == std::string_view::npos) {
+            return TagScan::Incomplete;
+        }
+        if (xml[i] == '>') {
+            break;
+        }
+        i = xml.find(xml[i], i + 1);
+        if (i == std::string_view::npos) {
+            return TagScan::Incomplete;
+        }
+        ++i;
+    }
+
+    const bool empty = !closing && i > attributes_begin && xml[i - 1] == '/';
+    tag.closing = closing;
+    tag.empty = empty;
+    tag.name = name;
+    tag.attributes = xml.substr(attributes_begin, (empty ? i - 1 : i) - attributes_begin);
+    pos = i + 1;
+    return TagScan::Tag;
+}
+
+/**
+ * @brief 跳过刚读到开始标签的元素，pos 移到其结束标签之后
+ */
+bool skip_raw_element(std::string_view xml, std::size_t& pos) {
+    std::size_t depth = 1;
+    RawTag tag;
+    while (depth > 0) {
+        if (scan_tag(xml, pos, tag) != TagScan::Tag) {
+            return false;
+        }
+        if (tag.closing) {
+            --depth;
+        } else if (!tag.empty) {
+            ++depth;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool decode_xml_text(std::string_view raw, std::string& buffer, std::string_view& out) {
+    if (simd::find_any(raw, "&\r") == std::string_view::npos) {
+        out = raw;
+        return true;
+    }
+    buffer.clear();
+    if (!append_decoded(raw, buffer)) {
+        return false;
+    }
+    out = buffer;
+    return true;
+}
+
+// ========================================
+// SheetDataScanner
+// ========================================
+
+bool SheetDataScanner::fail() noexcept {
+    if (truncated_) {
+        // 内容不完整引起的失败，补充内容后重新扫描
+        return false;
+    }
+    failed_ = true;
+    pos_ = xml_.size();
+    return false;
+}
+
+bool SheetDataScanner::need_input() noexcept {
+    if (streaming_ && !input_done_) {
+        truncated_ = true;
+        return false;
+    }
+    return fail();
+}
+
+void SheetDataScanner::feed(std::string_view chunk) {
+    window_.erase(0, pos_);
+    window_.append(chunk);
+    xml_ = window_;
+    pos_ = 0;
+}
+
+bool SheetDataScanner::read_tag(Tag& tag) {
+    RawTag raw;
+    switch (scan_tag(xml_, pos_, raw)) {
+        case TagScan::Tag:
+            break;
+        case TagScan::NoTag:
+            truncated_ = streaming_ && !input_done_;
+            return false;
+        case TagScan::Incomplete:
+            return need_input();
+        case TagScan::Unsupported:
+            // CDATA、注释和处理指令交给通用解析器
+            return fail();
+    }
+    tag.kind = raw.closing ? TagKind::End : (raw.empty ? TagKind::Empty : TagKind::Start);
+    tag.name = raw.name;
+    tag.attributes = raw.attributes;
+    return true;
+}
+
+bool SheetDataScanner::skip_element() {
+    std::size_t depth = 1;
+    Tag tag;
+    while (depth > 0) {
+        if (!read_tag(tag)) {
+            return fail();
+        }
+        if (tag.kind == TagKind::Start) {
+            ++depth;
+        } else if (tag.kind == TagKind::End) {
+            --depth;
+        }
+    }
+    return true;
+}
+
+bool SheetDataScanner::read_text(std::string_view element, std::string_view& raw) {
+    const std::size_t end = simd::find_any(xml_, "<", pos_);
+    if (end == std::string_view::npos) {
+        return need_input();
+    }
+    raw = xml_.substr(pos_, end - pos_);
+    pos_ = end;
+
+    Tag tag;
+    if (!read_tag(tag)) {
+        return fail();
+    }
+    if (tag.kind != TagKind::End || tag.name != element) {
+        // 文本元素中出现子元素，不属于本扫描器支持的语法
+        return fail();
+    }
+    return true;
+}
+
+bool SheetDataScanner::read_inline_string(ScannedCell& cell) {
+    // 只有一个不含实体的 <t> 时直接引用原文，否则拼接到缓冲区
+    bool buffered = false;
+    std::size_t runs = 0;
+    std::size_t depth = 0;
+    Tag tag;
+    while (true) {
+        if (!read_tag(tag)) {
+            return fail();
+        }
+        if (tag.kind == TagKind::End) {
+            if (depth == 0) {
+                return tag.name == "is" ? true : fail();
+            }
+            --depth;
+            continue;
+        }
+        if (tag.kind == TagKind::Empty) {
+            continue;
+        }
+
+        if (tag.name == "t") {
+            std::string_view raw;
+            if (!read_text(tag.name, raw)) {
+                return false;
+            }
+            if (runs == 0 && simd::find_any(raw, "&\r") == std::string_view::npos) {
+                cell.text = raw;
+            } else {
+                if (!buffered) {
+                    text_buffer_.assign(cell.text);
+                    buffered = true;
+                }
+                if (!append_decoded(raw, text_buffer_)) {
+                    return fail();
+                }
+                cell.text = text_buffer_;
+            }
+            ++runs;
+        } else if (tag.name == "r") {
+            // 富文本片段：继续查找其中的 <t>
+            ++depth;
+        } else if (!skip_element()) {
+            // rPr、rPh 等不包含单元格文本
+            return false;
+        }
+    }
+}
+
+bool SheetDataScanner::read_cell(const Tag& tag, ScannedCell& cell) {
+    cell.row = row_;
+    cell.column = 0;
+    cell.style_id = 0;
+    cell.type = {};
+    cell.text = {};
+    cell.formula = {};
+    cell.has_formula = false;
+
+    for_each_attribute(tag.attributes, [&](std::string_view name, std::string_view value) {
+        if (name == "r") {
+            std::size_t column = 0;
+            for (char c : value) {
+                // 超出上限后停止累加，避免溢出
+                if (c < 'A' || c > 'Z' || column > utils::CoordinateUtils::MAX_COLUMNS) break;
+                column = column * 26 + static_cast<std::size_t>(c - 'A' + 1);
+            }
+            cell.column = column;
+        } else if (name == "t") {
+            cell.type = value;
+        } else if (name == "s") {
+            parse_unsigned(value, cell.style_id);
+        }
+    });
+    // 没有 r 属性的单元格紧跟在上一个单元格之后
+    if (cell.column == 0) {
+        cell.column = column_ + 1;
+    }
+    // 超出 Excel 列数上限的列号交给通用解析器报错
+    if (cell.column > utils::CoordinateUtils::MAX_COLUMNS) {
+        return fail();
+    }
+    column_ = cell.column;
+
+    if (tag.kind == TagKind::Empty) {
+        return true;
+    }
+
+    Tag child;
+    while (true) {
+        if (!read_tag(child)) {
+            return fail();
+        }
+        if (child.kind == TagKind::End) {
+            return child.name == "c" ? true : fail();
+        }
+
+        if (child.name == "v") {
+            if (child.kind == TagKind::Start) {
+                std::string_view raw;
+                if (!read_text(child.name, raw) || !decode_xml_text(raw, text_buffer_, cell.text)) {
+                    return fail();
+                }
+            }
+        } else if (child.name == "f") {
+            cell.has_formula = true;
+            if (child.kind == TagKind::Start) {
+                std::string_view raw;
+                if (!read_text(child.name, raw) || !decode_xml_text(raw, formula_buffer_, cell.formula)) {
+                    return fail();
+                }
+            }
+        } else if (child.name == "is") {
+            if (child.kind == TagKind::Start && !read_inline_string(cell)) {
+                return false;
+            }
+        } else if (child.kind == TagKind::Start && !skip_element()) {
+            return false;
+        }
+    }
+}
+
+bool SheetDataScanner::next(ScannedCell& cell) {
+    if (ended_) {
+        return false;
+    }
+    truncated_ = false;
+
+    Tag tag;
+    while (true) {
+        // 增量模式下元素不完整时回到元素开头，补充内容后重新扫描
+        const std::size_t tag_begin = pos_;
+        if (!read_tag(tag)) {
+            if (truncated_) {
+                pos_ = tag_begin;
+            }
+            return false;
+        }
+
+        if (tag.kind == TagKind::End) {
+            if (tag.name == "sheetData") {
+                ended_ = true;
+                pos_ = tag_begin;
+                return false;
+            }
+            continue;
+        }
+
+        if (tag.name == "row") {
+            // 没有 r 属性的行号沿用上一行加一
+            std::size_t row = row_ + 1;
+            bool valid = true;
+            for_each_attribute(tag.attributes, [&row, &valid](std::string_view name, std::string_view value) {
+                if (name == "r") {
+                    valid = parse_unsigned(value, row);
+                }
+            });
+            // 无法解析（含溢出）或超出 Excel 行数上限的行号交给通用解析器报错
+            if (!valid || row > utils::CoordinateUtils::MAX_ROWS) {
+                return fail();
+            }
+            row_ = row;
+            column_ = 0;
+        } else if (tag.name == "c") {
+            const std::size_t column = column_;
+            if (read_cell(tag, cell)) {
+                return true;
+            }
+            if (truncated_) {
+                pos_ = tag_begin;
+                column_ = column;
+            }
+            return false;
+        } else if (tag.name != "sheetData" && tag.kind == TagKind::Start && !skip_element()) {
+            if (truncated_) {
+                pos_ = tag_begin;
+            }
+            return false;
+        }
+    }
+}
+
+// ========================================
+// 共享字符串表
+// ========================================
+
+bool scan_shared_string_items(std::string_view xml, std::vector<std::string_view>& items) {
+    items.clear();
+    std::size_t pos = 0;
+    RawTag tag;
+    while (true) {
+        switch (scan_tag(xml, pos, tag)) {
+            case TagScan::Tag:
+                break;
+            case TagScan::NoTag:
+                return true;
+            case TagScan::Incomplete:
+                return false;
+            case TagScan::Unsupported: {
+                // <si> 之外的 XML 声明、处理指令和注释直接跳过，其他语法（DOCTYPE 等）交给通用解析器
+                const bool instruction = xml[pos + 1] == '?';
+                if (!instruction && xml.compare(pos, 4, "<!--") != 0) {
+                    return false;
+                }
+                const std::size_t end = xml.find(instruction ? "?>" : "-->", pos + 2);
+                if (end == std::string_view::npos) {
+                    return false;
+                }
+                pos = end + (instruction ? 2 : 3);
+                continue;
+            }
+        }
+
+        if (tag.closing) {
+            continue;
+        }
+        if (tag.name == "sst") {
+            // uniqueCount 只用于预分配，缺失或无效时忽略
+            for_each_attribute(tag.attributes, [&items](std::string_view name, std::string_view value) {
+                std::size_t unique_count = 0;
+                if (name == "uniqueCount" && parse_unsigned(value, unique_count)) {
+                    items.reserve(unique_count);
+                }
+            });
+        } else if (tag.name == "si") {
+            if (tag.empty) {
+                items.emplace_back();
+                continue;
+            }
+            // 只确定 <si> 的边界，内容在首次访问时由 decode_rich_text() 解码
+            const std::size_t begin = pos;
+            if (!skip_raw_element(xml, pos)) {
+                return false;
+            }
+            const std::size_t end = xml.rfind('<', pos - 1);
+            items.push_back(xml.substr(begin, end - begin));
+        } else if (!tag.empty && !skip_raw_element(xml, pos)) {
+            // sst 下的扩展元素（extLst 等）
+            return false;
+        }
+    }
+}
+
+bool decode_rich_text(std::string_view content, std::string& out) {
+    out.clear();
+    std::size_t pos = 0;
+    std::size_t depth = 0;
+    RawTag tag;
+    while (true) {
+        const TagScan result = scan_tag(content, pos, tag);
+        if (result == TagScan::NoTag) {
+            return depth == 0;
+        }
+        if (result != TagScan::Tag) {
+            return false;
+        }
+        if (tag.closing) {
+            if (depth == 0) {
+                return false;
+            }
+            --depth;
+            continue;
+        }
+        if (tag.empty) {
+            continue;
+        }
+
+        if (tag.name == "t") {
+            const std::size_t end = simd::find_any(content, "<", pos);
+            if (end == std::string_view::npos || !append_decoded(content.substr(pos, end - pos), out)) {
+                return false;
+            }
+            pos = end;
+            if (scan_tag(content, pos, tag) != TagScan::Tag || !tag.closing || tag.name != "t") {
+                return false;
+            }
+        } else if (tag.name == "r") {
+            // 富文本片段：继续查找其中的 <t>
+            ++depth;
+        } else if (!skip_raw_element(content, pos)) {
+            // rPr、rPh、phoneticPr 等不包含单元格文本
+            return false;
+        }
+    }
+}
+
+} // namespace tinakit::internal
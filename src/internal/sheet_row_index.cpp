@@ -0,0 +1,227 @@
+/**
+ * @file sheet_row_index.cpp
+ * @brief 工作表 XML 行块索引实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/sheet_row_index.hpp"
+#include "tinakit/internal/coordinate_utils.hpp"
+#include <algorithm>
+#include <string>
+
+namespace tinakit::internal {
+
+namespace {
+
+bool is_xml_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool is_name_end(char c) noexcept {
+    return is_xml_space(c) || c == '>' || c == '/';
+}
+
+/**
+ * @brief 在开始标签 [begin, end) 中查找属性值（不做实体解码）
+ */
+std::optional<std::string_view> find_attribute(std::string_view tag, std::string_view name) {
+    std::size_t i = 0;
+    // 跳过元素名
+    while (i < tag.size() && !is_name_end(tag[i])) ++i;
+
+    while (i < tag.size()) {
+        while (i < tag.size() && is_xml_space(tag[i])) ++i;
+        const std::size_t name_begin = i;
+        while (i < tag.size() && tag[i] != '=' && !is_name_end(tag[i])) ++i;
+        const std::string_view attr_name = tag.substr(name_begin, i - name_begin);
+        while (i < tag.size() && is_xml_space(tag[i])) ++i;
+        if (i >= tag.size() || tag[i] != '=') {
+            return std::nullopt;
+        }
+        ++i;
+        while (i < tag.size() && is_xml_space(tag[i])) ++i;
+        if (i >= tag.size() || (tag[i] != '"' && tag[i] != '\'')) {
+            return std::nullopt;
+        }
+        const char quote = tag[i++];
+        const std::size_t value_begin = i;
+        while (i < tag.size() && tag[i] != quote) ++i;
+        if (i >= tag.size()) {
+            return std::nullopt;
+        }
+        if (attr_name == name) {
+            return tag.substr(value_begin, i - value_begin);
+        }
+        ++i;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t> parse_row_number(std::string_view text) {
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    std::size_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        value = value * 10 + static_cast<std::size_t>(c - '0');
+        // 超出 Excel 行数上限的行号视为格式错误，逐位检查同时避免溢出
+        if (value > utils::CoordinateUtils::MAX_ROWS) {
+            return std::nullopt;
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+std::optional<SheetRowIndex> SheetRowIndex::build(std::string_view xml, std::size_t block_shift) {
+    SheetRowIndex index;
+
+    // 定位根元素（跳过 XML 声明、注释和 DOCTYPE）
+    std::size_t pos = 0;
+    while (true) {
+        pos = xml.find('<', pos);
+        if (pos == std::string_view::npos || pos + 1 >= xml.size()) {
+            return std::nullopt;
+        }
+        const char next = xml[pos + 1];
+        if (next != '?' && next != '!') {
+            break;
+        }
+        ++pos;
+    }
+    const std::size_t root_end = xml.find('>', pos);
+    if (root_end == std::string_view::npos) {
+        return std::nullopt;
+    }
+    index.root_tag_begin_ = pos;
+    index.root_tag_end_ = root_end + 1;
+    index.root_name_begin_ = pos + 1;
+    index.root_name_end_ = index.root_name_begin_;
+    while (index.root_name_end_ < root_end && !is_name_end(xml[index.root_name_end_])) {
+        ++index.root_name_end_;
+    }
+
+    std::string_view prefix;
+    bool self_closing = false;
+    const auto sheet_data_begin = find_sheet_data(xml.substr(index.root_tag_end_), prefix, self_closing);
+    if (!sheet_data_begin) {
+        return std::nullopt;
+    }
+    index.sheet_data_begin_ = index.root_tag_end_ + *sheet_data_begin;
+    if (self_closing) {
+        // <sheetData/>：没有任何行
+        index.sheet_data_end_ = index.sheet_data_begin_;
+        return index;
+    }
+
+    const std::string close_tag = "</" + std::string(prefix) + "sheetData";
+    const std::size_t close = xml.find(close_tag, index.sheet_data_begin_);
+    if (close == std::string_view::npos) {
+        return std::nullopt;
+    }
+    index.sheet_data_end_ = close;
+
+    const std::string_view content = xml.substr(index.sheet_data_begin_, close - index.sheet_data_begin_);
+    if (content.find("<!") != std::string_view::npos) {
+        // 注释或 CDATA 中可能出现伪造的 <row，不做切分
+        return std::nullopt;
+    }
+
+    const std::string row_tag = "<" + std::string(prefix) + "row";
+    std::size_t previous_row = 0;
+    std::size_t cursor = 0;
+    while (true) {
+        cursor = content.find(row_tag, cursor);
+        if (cursor == std::string_view::npos) {
+            break;
+        }
+        const std::size_t after = cursor + row_tag.size();
+        if (after >= content.size() || !is_name_end(content[after])) {
+            cursor = after;
+            continue;
+        }
+        const std::size_t tag_end = content.find('>', after);
+        if (tag_end == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        // 没有 r 属性的行号沿用上一行加一
+        std::size_t row = previous_row + 1;
+        if (auto r = find_attribute(content.substr(cursor + 1, tag_end - cursor - 1), "r")) {
+            auto parsed = parse_row_number(*r);
+            if (!parsed) {
+                return std::nullopt;
+            }
+            row = *parsed;
+        }
+        if (row <= previous_row) {
+            return std::nullopt;
+        }
+        previous_row = row;
+
+        const std::size_t block = row >> block_shift;
+        const std::size_t offset = index.sheet_data_begin_ + cursor;
+        if (index.spans_.empty() || index.spans_.back().block != block) {
+            if (!index.spans_.empty()) {
+                index.spans_.back().end = offset;
+            }
+            Span span;
+            span.block = block;
+            span.first_row = row;
+            span.begin = offset;
+            index.spans_.push_back(span);
+        }
+        index.spans_.back().last_row = row;
+        cursor = tag_end + 1;
+    }
+
+    if (!index.spans_.empty()) {
+        index.spans_.back().end = index.sheet_data_end_;
+    }
+    return index;
+}
+
+std::optional<std::size_t> SheetRowIndex::find_sheet_data(std::string_view xml, std::string_view& prefix,
+                                                          bool& self_closing) {
+    // sheetData 可能带命名空间前缀
+    std::size_t sheet_data = 0;
+    while (true) {
+        sheet_data = xml.find("sheetData", sheet_data);
+        if (sheet_data == std::string_view::npos) {
+            return std::nullopt;
+        }
+        const std::size_t after = sheet_data + 9;
+        if (sheet_data > 0 && after < xml.size() && is_name_end(xml[after])) {
+            if (xml[sheet_data - 1] == '<') {
+                prefix = {};
+                break;
+            }
+            if (xml[sheet_data - 1] == ':') {
+                const std::size_t lt = xml.rfind('<', sheet_data);
+                if (lt != std::string_view::npos && xml[lt + 1] != '/') {
+                    prefix = xml.substr(lt + 1, sheet_data - lt - 1);
+                    break;
+                }
+            }
+        }
+        sheet_data = after;
+    }
+
+    const std::size_t open_end = xml.find('>', sheet_data);
+    if (open_end == std::string_view::npos) {
+        return std::nullopt;
+    }
+    self_closing = xml[open_end - 1] == '/';
+    return open_end + 1;
+}
+
+bool SheetRowIndex::fully_loaded() const noexcept {
+    return std::all_of(spans_.begin(), spans_.end(), [](const Span& span) { return span.loaded; });
+}
+
+} // namespace tinakit::internal
@@ -0,0 +1,32 @@
+/**
+ * @file string_storage_plan.cpp
+ * @brief 保存时字符串存储决策的实现
+ * @author TinaKit Team
+ * @date 2025-6-20
+ */
+
+#include "tinakit/internal/string_storage_plan.hpp"
+
+namespace tinakit::internal {
+
+void StringStoragePlan::count(const CellStore& cells) {
+    // 0 和 1 不依赖出现次数
+    if (min_repeats_ < 2) {
+        return;
+    }
+    cells.for_each_cell([this](const core::Coordinate&, const CompactCell& cell) {
+        if (cell.kind == CellKind::String) {
+            ++repeats_[cell.payload.id];
+        }
+    });
+}
+
+bool StringStoragePlan::share(core::StringPool::StringId id) const {
+    if (min_repeats_ < 2) {
+        return min_repeats_ == 1;
+    }
+    auto it = repeats_.find(id);
+    return it != repeats_.end() && it->second >= min_repeats_;
+}
+
+} // namespace tinakit::internal
@@ -17,12 +17,32 @@
 
 #include "tinakit/excel/openxml_namespaces.hpp"
 #include <algorithm>
+#include <functional>
+#include <set>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <thread>
 
 namespace tinakit::internal {
 
+namespace {
+
+std::vector<std::byte> to_bytes(const std::string& text) {
+    const auto* data = reinterpret_cast<const std::byte*>(text.data());
+    return std::vector<std::byte>(data, data + text.size());
+}
+
+/**
+ * @brief 切换到执行器后运行 work
+ */
+async::Task<void> run_on(async::Executor& executor, std::function<void()> work) {
+    co_await async::schedule_on(executor);
+    work();
+}
+
+} // namespace
+
 // ========================================
 // 构造函数和析构函数
 // ========================================
@@ -31,19 +51,31 @@ workbook_impl::workbook_impl()
     : style_manager_(std::make_shared<excel::StyleManager>()),
       shared_strings_(std::make_shared<excel::SharedStrings>()),
       string_pool_(std::make_unique<core::StringPool>()),
-      cell_data_pool_(std::make_unique<core::MemoryPool<cell_data>>()),
+      formula_arena_(std::make_unique<FormulaArena>()),
       formula_engine_(std::make_unique<excel::FormulaEngine>(this)) {
     // 不在构造函数中创建默认结构，延迟到需要时创建
 }
 
-workbook_impl::workbook_impl(const std::filesystem::path& file_path)
+workbook_impl::workbook_impl(const std::filesystem::path& file_path, std::size_t load_threads)
     : file_path_(file_path),
       style_manager_(std::make_shared<excel::StyleManager>()),
       shared_strings_(std::make_shared<excel::SharedStrings>()),
       string_pool_(std::make_unique<core::StringPool>()),
-      cell_data_pool_(std::make_unique<core::MemoryPool<cell_data>>()),
+      formula_arena_(std::make_unique<FormulaArena>()),
       formula_engine_(std::make_unique<excel::FormulaEngine>(this)) {
-    load_from_file();
+    load_from_file(load_threads);
+}
+
+workbook_impl::workbook_impl(const std::filesystem::path& file_path, std::shared_ptr<core::OpenXmlArchiver> archiver,
+                             std::size_t load_threads)
+    : file_path_(file_path),
+      archiver_(std::move(archiver)),
+      style_manager_(std::make_shared<excel::StyleManager>()),
+      shared_strings_(std::make_shared<excel::SharedStrings>()),
+      string_pool_(std::make_unique<core::StringPool>()),
+      formula_arena_(std::make_unique<FormulaArena>()),
+      formula_engine_(std::make_unique<excel::FormulaEngine>(this)) {
+    load_from_file(load_threads);
 }
 
 workbook_impl::~workbook_impl() = default;
@@ -86,7 +118,8 @@ std::uint32_t workbook_impl::get_sheet_id(const std::string& name) const {
 
 void workbook_impl::ensure_has_worksheet() {
     if (worksheets_.empty()) {
-        create_worksheet("Sheet1");
+        // 可能在构造期间调用，此时不能创建需要 shared_from_this 的句柄
+        add_worksheet("Sheet1", LoadState::FullyLoaded);
         if (active_sheet_name_.empty()) {
             active_sheet_name_ = "Sheet1";
         }
@@ -98,6 +131,15 @@ excel::Worksheet workbook_impl::create_worksheet(const std::string& name) {
         throw DuplicateWorksheetNameException(name);
     }
 
+    // 新建的工作表没有需要从归档加载的数据
+    add_worksheet(name, LoadState::FullyLoaded);
+    is_dirty_ = true;
+
+    // 返回工作表对象
+    return excel::Worksheet(shared_from_this(), get_sheet_id(name), name);
+}
+
+worksheet_impl& workbook_impl::add_worksheet(const std::string& name, LoadState initial_state) {
     // 分配新的sheet_id
     std::uint32_t sheet_id = next_sheet_id_++;
 
@@ -105,7 +147,8 @@ excel::Worksheet workbook_impl::create_worksheet(const std::string& name) {
     sheet_name_to_id_[name] = sheet_id;
     sheet_id_to_name_[sheet_id] = name;
 
-    auto worksheet = std::make_unique<worksheet_impl>(name, *this);
+    auto worksheet = std::make_unique<worksheet_impl>(name, *this, initial_state);
+    auto& result = *worksheet;
     worksheets_[name] = std::move(worksheet);
     worksheet_order_.push_back(name);
 
@@ -114,10 +157,96 @@ excel::Worksheet workbook_impl::create_worksheet(const std::string& name) {
         active_sheet_name_ = name;
     }
 
+    return result;
+}
+
+std::optional<std::string> workbook_impl::worksheet_part_path(const std::string& sheet_name) const {
+    auto it = sheet_part_paths_.find(sheet_name);
+    if (it == sheet_part_paths_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<std::string> workbook_impl::locate_worksheet_part(const std::string& sheet_name) const {
+    if (!archiver_) {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> possible_paths;
+    if (auto part_path = worksheet_part_path(sheet_name)) {
+        possible_paths.push_back(*part_path);
+    } else if (!sheet_part_paths_.empty()) {
+        // 关系文件可用但没有该工作表：加载后新建的工作表，归档中没有它的部件
+        return std::nullopt;
+    } else {
+        // 根据工作表在工作簿中的位置推断路径
+        auto it = std::find(worksheet_order_.begin(), worksheet_order_.end(), sheet_name);
+        std::size_t sheet_index = (it != worksheet_order_.end()) ?
+            std::distance(worksheet_order_.begin(), it) + 1 : 1;
+
+        possible_paths.push_back("xl/worksheets/sheet" + std::to_string(sheet_index) + ".xml");
+        possible_paths.push_back("xl/worksheets/sheet1.xml");
+        possible_paths.push_back("xl/worksheets/" + sheet_name + ".xml");
+    }
+
+    for (const auto& path : possible_paths) {
+        if (async::sync_wait(archiver_->has_file(path))) {
+            return path;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string workbook_impl::worksheet_save_path(const std::string& sheet_name) const {
+    auto it = std::find(worksheet_order_.begin(), worksheet_order_.end(), sheet_name);
+    if (it == worksheet_order_.end()) {
+        throw WorksheetNotFoundException(sheet_name);
+    }
+    return "xl/worksheets/sheet" + std::to_string(std::distance(worksheet_order_.begin(), it) + 1) + ".xml";
+}
+
+bool workbook_impl::can_copy_worksheet_part(const std::string& sheet_name) const {
+    const auto& worksheet = *worksheets_.at(sheet_name);
+    if (worksheet.is_dirty() || worksheet.is_streamed()) {
+        return false;
+    }
+    auto part_path = locate_worksheet_part(sheet_name);
+    return part_path && *part_path == worksheet_save_path(sheet_name);
+}
+
+std::unique_ptr<core::EntryOutputStream> workbook_impl::begin_streaming_worksheet(const std::string& name,
+                                                                                  std::size_t buffer_size) {
+    if (has_worksheet(name)) {
+        throw DuplicateWorksheetNameException(name);
+    }
+    if (!archiver_) {
+        // 已知保存路径时边写边落盘，之后只能保存到该路径
+        archiver_ = std::make_shared<core::OpenXmlArchiver>(
+            file_path_.empty() ? core::OpenXmlArchiver::create_in_memory_writer()
+                               : core::OpenXmlArchiver::create_file_writer(file_path_.string()));
+    } else {
+        // 条目直接写入写入器后原始条目不可再读，先补齐未加载的工作表
+        for (auto& [sheet_name, worksheet] : worksheets_) {
+            worksheet->load_all();
+        }
+    }
+
+    // 新工作表排在最后，先打开条目，失败时工作簿保持不变
+    std::string part_path = "xl/worksheets/sheet" + std::to_string(worksheet_order_.size() + 1) + ".xml";
+    auto out = std::make_unique<core::EntryOutputStream>(*archiver_, part_path, buffer_size);
+
+    add_worksheet(name, LoadState::FullyLoaded).mark_streamed(std::move(part_path));
     is_dirty_ = true;
+    return out;
+}
 
-    // 返回工作表对象
-    return excel::Worksheet(shared_from_this(), sheet_id, name);
+LoadState workbook_impl::worksheet_load_state(const std::string& sheet_name) const {
+    auto it = worksheets_.find(sheet_name);
+    if (it == worksheets_.end()) {
+        throw WorksheetNotFoundException(sheet_name);
+    }
+    return it->second->load_state();
 }
 
 void workbook_impl::remove_worksheet(const std::string& name) {
@@ -130,6 +259,8 @@ void workbook_impl::remove_worksheet(const std::string& name) {
     }
     
     worksheets_.erase(name);
+    sheet_part_paths_.erase(name);
+    sheet_name_to_rel_id_.erase(name);
     worksheet_order_.erase(
         std::remove(worksheet_order_.begin(), worksheet_order_.end(), name),
         worksheet_order_.end()
@@ -161,6 +292,13 @@ void workbook_impl::rename_worksheet(const std::string& old_name, const std::str
     sheet_name_to_id_[new_name] = sheet_id;
     sheet_id_to_name_[sheet_id] = new_name;  // 更新反向映射
 
+    // 部件路径跟随工作表
+    auto part = sheet_part_paths_.find(old_name);
+    if (part != sheet_part_paths_.end()) {
+        sheet_part_paths_[new_name] = part->second;
+        sheet_part_paths_.erase(old_name);
+    }
+
     // 更新顺序列表
     auto it = std::find(worksheet_order_.begin(), worksheet_order_.end(), old_name);
     if (it != worksheet_order_.end()) {
@@ -175,7 +313,7 @@ void workbook_impl::rename_worksheet(const std::string& old_name, const std::str
 // ========================================
 
 cell_data workbook_impl::get_cell_data(const std::string& sheet_name, const core::Coordinate& pos) {
-    ensure_worksheet_loaded(sheet_name);
+    // worksheet_impl 按行块按需加载，这里无需加载整张工作表
     auto& worksheet = get_worksheet_impl(sheet_name);
     return worksheet.get_cell_data(pos);
 }
@@ -193,26 +331,20 @@ cell_data workbook_impl::get_cell_data(std::uint32_t sheet_id, const core::Coord
     return get_cell_data(sheet_name, pos);
 }
 
+std::optional<CompactCell> workbook_impl::get_cell(std::uint32_t sheet_id, const core::Coordinate& pos) {
+    return get_worksheet_impl(get_sheet_name(sheet_id)).get_cell(pos);
+}
+
+CellView workbook_impl::resolve_cell(const CompactCell& cell) const {
+    return internal::resolve_cell(cell, *string_pool_, *formula_arena_, shared_strings_.get());
+}
+
 void workbook_impl::set_cell_value(const std::string& sheet_name, const core::Coordinate& pos,
                                   const cell_data::CellValue& value) {
-    ensure_worksheet_loaded(sheet_name);
     auto& worksheet = get_worksheet_impl(sheet_name);
 
-    cell_data data;
-
-    // 性能优化：对字符串值使用全局字符串缓存
-    if (std::holds_alternative<std::string>(value)) {
-        const auto& str_value = std::get<std::string>(value);
-        // 使用CacheManager的字符串缓存
-        auto& string_cache = core::CacheManager::instance().string_cache();
-        auto string_id = string_cache.intern_string(str_value);
-        auto optimized_str = string_cache.get_string(string_id);
-        data.value = std::string(optimized_str);
-    } else {
-        data.value = value;
-    }
-
-    worksheet.set_cell_data(pos, data);
+    // 字符串由单元格存储驻留到本工作簿的字符串池，不经过进程级的字符串缓存
+    worksheet.set_cell_data(pos, cell_data(value));
     mark_worksheet_dirty(sheet_name);
 }
 
@@ -224,7 +356,6 @@ void workbook_impl::set_cell_value(std::uint32_t sheet_id, const core::Coordinat
 
 void workbook_impl::set_cell_formula(const std::string& sheet_name, const core::Coordinate& pos,
                                     const std::string& formula) {
-    ensure_worksheet_loaded(sheet_name);
     auto& worksheet = get_worksheet_impl(sheet_name);
 
     auto data = worksheet.get_cell_data(pos);
@@ -242,7 +373,6 @@ void workbook_impl::set_cell_formula(std::uint32_t sheet_id, const core::Coordin
 
 void workbook_impl::set_cell_style(const std::string& sheet_name, const core::Coordinate& pos,
                                   std::uint32_t style_id) {
-    ensure_worksheet_loaded(sheet_name);
     auto& worksheet = get_worksheet_impl(sheet_name);
 
     auto data = worksheet.get_cell_data(pos);
@@ -262,28 +392,11 @@ void workbook_impl::set_cell_style(std::uint32_t sheet_id, const core::Coordinat
 
 void workbook_impl::batch_set_cell_values(const std::string& sheet_name,
                                          const std::vector<std::tuple<core::Coordinate, cell_data::CellValue>>& operations) {
-    ensure_worksheet_loaded(sheet_name);
     auto& worksheet = get_worksheet_impl(sheet_name);
 
-    // 使用全局缓存管理器
-    auto& cache_manager = core::CacheManager::instance();
-    auto& string_cache = cache_manager.string_cache();
-
     // 性能优化：批量处理，减少重复的查找和验证
     for (const auto& [pos, value] : operations) {
-        cell_data data;
-
-        // 使用全局字符串缓存优化字符串存储
-        if (std::holds_alternative<std::string>(value)) {
-            const auto& str_value = std::get<std::string>(value);
-            auto string_id = string_cache.intern_string(str_value);
-            auto optimized_str = string_cache.get_string(string_id);
-            data.value = std::string(optimized_str);
-        } else {
-            data.value = value;
-        }
-
-        worksheet.set_cell_data(pos, data);
+        worksheet.set_cell_data(pos, cell_data(value));
     }
 
     mark_worksheet_dirty(sheet_name);
@@ -294,14 +407,18 @@ workbook_impl::PerformanceStats workbook_impl::get_performance_stats() const {
 
     // 使用CacheManager获取统计信息
     auto& cache_manager = core::CacheManager::instance();
-    auto& string_cache = cache_manager.string_cache();
     auto& cell_cache = cache_manager.cell_cache();
 
-    stats.string_pool_size = string_cache.string_pool_.size();
+    stats.string_pool_size = string_pool_->size();
     stats.cell_cache_hits = 0;  // cell_cache.hit_count(); // 需要添加这个方法
     stats.cell_cache_misses = 0; // cell_cache.miss_count(); // 需要添加这个方法
     stats.cache_hit_ratio = 0.0; // cell_cache.hit_ratio(); // 需要添加这个方法
 
+    stats.cell_store_bytes = 0;
+    for (const auto& [name, worksheet] : worksheets_) {
+        stats.cell_store_bytes += worksheet->memory_usage();
+    }
+
     return stats;
 }
 
@@ -329,18 +446,25 @@ const excel::SharedStrings& workbook_impl::shared_strings() const {
 // 文件操作
 // ========================================
 
-void workbook_impl::save(const std::filesystem::path& file_path) {
+void workbook_impl::save(const std::filesystem::path& file_path, std::size_t deflate_threads,
+                         const core::WriteProfile& profile, const core::FileWritePolicy& file_policy,
+                         const core::SharedStringPolicy& string_policy) {
+    if (archiver_ && archiver_->writes_through() && file_path != file_path_) {
+        throw TinaKitException("Streamed worksheets are already being written to " + file_path_.string(),
+                               "workbook_impl::save");
+    }
     file_path_ = file_path;
-    save();
+    save(deflate_threads, profile, file_policy, string_policy);
 }
 
-void workbook_impl::save() {
+void workbook_impl::save(std::size_t deflate_threads, const core::WriteProfile& profile,
+                         const core::FileWritePolicy& file_policy, const core::SharedStringPolicy& string_policy) {
     if (file_path_.empty()) {
         throw std::invalid_argument("No file path specified");
     }
 
     ensure_has_worksheet();  // 确保至少有一个工作表
-    save_to_archiver();
+    save_to_archiver(deflate_threads, profile, file_policy, string_policy);
     is_dirty_ = false;
 
     // 清除所有工作表的修改标志
@@ -353,6 +477,10 @@ const std::filesystem::path& workbook_impl::file_path() const {
     return file_path_;
 }
 
+void workbook_impl::set_file_path(const std::filesystem::path& file_path) {
+    file_path_ = file_path;
+}
+
 // ========================================
 // 内部状态管理
 // ========================================
@@ -363,8 +491,8 @@ void workbook_impl::ensure_worksheet_loaded(const std::string& sheet_name) {
     }
 
     auto& worksheet = get_worksheet_impl(sheet_name);
-    if (worksheet.load_state() == LoadState::NotLoaded) {
-        // 触发惰性加载
+    if (worksheet.load_state() != LoadState::FullyLoaded) {
+        // 触发惰性加载（包括补齐部分加载的行块）
         worksheet.load_all();
     }
 }
@@ -388,21 +516,27 @@ worksheet_impl& workbook_impl::get_worksheet_impl(const std::string& sheet_name)
 // 私有方法
 // ========================================
 
-void workbook_impl::load_from_file() {
+void workbook_impl::load_from_file(std::size_t load_threads) {
     try {
-        // 使用 OpenXmlArchiver 打开文件
-        archiver_ = std::make_shared<core::OpenXmlArchiver>(
-            async::sync_wait(core::OpenXmlArchiver::open_from_file(file_path_.string())));
+        // 使用 OpenXmlArchiver 打开文件（调用方已经打开时直接使用）
+        if (!archiver_) {
+            archiver_ = std::make_shared<core::OpenXmlArchiver>(
+                async::sync_wait(core::OpenXmlArchiver::open_from_file(file_path_.string())));
+        }
 
         // 解析工作簿结构
         parse_workbook_xml();
         parse_workbook_rels();
 
-        // 加载样式信息
-        load_styles_xml();
+        if (load_threads == 1) {
+            // 加载样式信息
+            load_styles_xml();
 
-        // 加载共享字符串
-        load_shared_strings_xml();
+            // 加载共享字符串
+            load_shared_strings_xml();
+        } else {
+            load_parts_parallel(load_threads);
+        }
 
         // 标记为未修改
         is_dirty_ = false;
@@ -416,7 +550,8 @@ void workbook_impl::load_from_file() {
 void workbook_impl::create_default_structure() {
     // 只有在没有工作表时才创建默认工作表
     if (worksheets_.empty()) {
-        create_worksheet("Sheet1");
+        // 可能在构造期间调用，此时不能创建需要 shared_from_this 的句柄
+        add_worksheet("Sheet1", LoadState::FullyLoaded);
         // 设置活动工作表
         if (active_sheet_name_.empty()) {
             active_sheet_name_ = "Sheet1";
@@ -449,13 +584,16 @@ void workbook_impl::parse_workbook_xml() {
                 // 尝试不同的r:id属性格式
                 auto r_id = it.attribute("r:id");
                 if (!r_id) {
-                    r_id = it.attribute(excel::OpenXmlNamespaces::relationship_attr("id"));
+                    r_id = it.attribute(xml::qname(excel::OpenXmlNamespaces::relationships(), "id"));
                 }
 
                 if (name && !name->empty()) {
-                    // 创建工作表（如果不存在）
+                    // 注册工作表（如果不存在），单元格数据延迟到首次访问时加载
                     if (!has_worksheet(*name)) {
-                        create_worksheet(*name);
+                        add_worksheet(*name, LoadState::NotLoaded);
+                    }
+                    if (r_id && !r_id->empty()) {
+                        sheet_name_to_rel_id_[*name] = *r_id;
                     }
                 }
             });
@@ -495,9 +633,14 @@ void workbook_impl::parse_workbook_rels() {
                 auto target = it.attribute("Target");
 
                 // 检查是否是工作表关系
-                if (type && target && type->find("worksheet") != std::string::npos && !target->empty()) {
-                    // 存储关系映射（可以用于后续的工作表加载）
-                    // 这里可以建立 rId 到工作表文件路径的映射
+                if (id && type && target && type->find("worksheet") != std::string::npos && !target->empty()) {
+                    // 目标路径相对于 xl/，以 / 开头时为包内绝对路径
+                    std::string part_path = (*target)[0] == '/' ? target->substr(1) : "xl/" + *target;
+                    for (const auto& [sheet_name, rel_id] : sheet_name_to_rel_id_) {
+                        if (rel_id == *id) {
+                            sheet_part_paths_[sheet_name] = part_path;
+                        }
+                    }
                 }
             });
         }
@@ -509,25 +652,25 @@ void workbook_impl::parse_workbook_rels() {
 void workbook_impl::load_styles_xml() {
     if (!archiver_) return;
 
+    bool present = false;
     try {
         // 检查是否有 styles.xml 文件
-        if (async::sync_wait(archiver_->has_file("xl/styles.xml"))) {
-            auto xml_data = async::sync_wait(archiver_->read_file("xl/styles.xml"));
-
-            // 将字节数据转换为字符串
-            std::string xml_content(
-                reinterpret_cast<const char*>(xml_data.data()),
-                xml_data.size()
-            );
+        present = async::sync_wait(archiver_->has_file("xl/styles.xml"));
+    } catch (const std::exception&) {
+    }
+    load_styles_part(present);
+}
 
+void workbook_impl::load_styles_part(bool present) {
+    try {
+        if (present) {
             // 使用 StyleManager 加载样式
-            style_manager_->load_from_xml(xml_content);
-
+            style_manager_->load_from_xml(read_part_text("xl/styles.xml"));
         } else {
             // 如果没有样式文件，确保有默认样式
             style_manager_->initialize_defaults();
         }
-    } catch (const std::exception& e) {
+    } catch (const std::exception&) {
         // 如果加载失败，使用默认样式
         style_manager_->clear();
         style_manager_->initialize_defaults();
@@ -537,25 +680,96 @@ void workbook_impl::load_styles_xml() {
 void workbook_impl::load_shared_strings_xml() {
     if (!archiver_) return;
 
+    bool present = false;
     try {
         // 检查是否有 sharedStrings.xml 文件
-        if (async::sync_wait(archiver_->has_file("xl/sharedStrings.xml"))) {
-            auto xml_data = async::sync_wait(archiver_->read_file("xl/sharedStrings.xml"));
+        present = async::sync_wait(archiver_->has_file("xl/sharedStrings.xml"));
+    } catch (const std::exception&) {
+    }
+    load_shared_strings_part(present);
+}
 
-            // 将字节数据转换为字符串
-            std::string xml_content(
-                reinterpret_cast<const char*>(xml_data.data()),
-                xml_data.size()
-            );
+void workbook_impl::load_shared_strings_part(bool present) {
+    if (!present) {
+        return;
+    }
+    try {
+        // 加载共享字符串数据
+        shared_strings_->load_from_xml(read_part_text("xl/sharedStrings.xml"));
+        archived_shared_string_count_ = shared_strings_->count();
+    } catch (const std::exception&) {
+    }
+}
 
-            // 加载共享字符串数据
-            shared_strings_->load_from_xml(xml_content);
+std::string workbook_impl::read_part_text(const std::string& part_path) const {
+    // 每个条目流使用独立的解压器，可以在多个线程上同时读取
+    auto stream = async::sync_wait(archiver_->open_entry_stream(part_path));
+    if (const auto* entry = archiver_->find_entry(part_path)) {
+        // 按目录中的未压缩大小一次分配，避免边读边扩容
+        std::string content(static_cast<std::size_t>(entry->uncompressed_size), '\0');
+        if (!stream->read(content.data(), static_cast<std::streamsize>(content.size()))) {
+            throw TinaKitException("Failed to read part: " + part_path, "workbook_impl::read_part_text");
+        }
+        return content;
+    }
+    std::ostringstream content;
+    content << stream->rdbuf();
+    return std::move(content).str();
+}
+
+void workbook_impl::load_parts_parallel(std::size_t thread_count) {
+    // 条目查找会修改归档器的缓存，先在当前线程确定所有要读取的部件
+    const bool has_styles = async::sync_wait(archiver_->has_file("xl/styles.xml"));
+    const bool has_shared_strings = async::sync_wait(archiver_->has_file("xl/sharedStrings.xml"));
+
+    std::vector<worksheet_impl*> sheets;
+    std::vector<std::string> part_paths;
+    for (const auto& name : worksheet_order_) {
+        if (auto path = locate_worksheet_part(name)) {
+            sheets.push_back(worksheets_.at(name).get());
+            part_paths.push_back(std::move(*path));
+        }
+    }
 
+    std::vector<PreparedSheet> prepared(sheets.size());
+    {
+        const std::size_t task_count = sheets.size() + 2;
+        if (thread_count == 0) {
+            thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
         }
-    } catch (const std::exception& e) {
+        // 单个大工作表也会拆分为多个分块，线程数不受部件数量限制
+        async::ThreadPoolExecutor pool(thread_count);
+
+        std::vector<async::Task<void>> tasks;
+        tasks.reserve(task_count);
+        tasks.push_back(run_on(pool, [this, has_styles] { load_styles_part(has_styles); }));
+        tasks.push_back(run_on(pool, [this, has_shared_strings] { load_shared_strings_part(has_shared_strings); }));
+        for (std::size_t i = 0; i < sheets.size(); ++i) {
+            tasks.push_back(prepare_worksheet(pool, part_paths[i], prepared[i], thread_count));
+        }
+        async::sync_wait(async::when_all(std::move(tasks)));
+    }
+
+    // 按工作表顺序写入单元格存储，字符串池 ID 与线程调度无关
+    for (std::size_t i = 0; i < sheets.size(); ++i) {
+        sheets[i]->adopt(prepared[i]);
+        prepared[i] = PreparedSheet{};
     }
 }
 
+async::Task<void> workbook_impl::prepare_worksheet(async::Executor& executor, std::string part_path,
+                                                   PreparedSheet& prepared, std::size_t max_chunks) {
+    co_await async::schedule_on(executor);
+    std::string xml;
+    try {
+        xml = read_part_text(part_path);
+    } catch (const std::exception&) {
+        // 读取失败的工作表保持未加载，首次访问时按原路径处理
+        co_return;
+    }
+    co_await worksheet_impl::prepare(executor, std::move(xml), prepared, max_chunks);
+}
+
 void workbook_impl::generate_workbook_xml() {
     std::ostringstream oss;
     core::XmlSerializer serializer(oss, "workbook.xml");
@@ -593,11 +807,7 @@ void workbook_impl::generate_workbook_xml() {
 
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
-    }
-    async::sync_wait(archiver_->add_file("xl/workbook.xml", std::move(xml_bytes)));
+    async::sync_wait(archiver_->add_file("xl/workbook.xml", to_bytes(xml_content)));
 }
 
 void workbook_impl::generate_workbook_rels() {
@@ -645,11 +855,7 @@ void workbook_impl::generate_workbook_rels() {
     std::string xml_content = oss.str();
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
-    }
-    async::sync_wait(archiver_->add_file("xl/_rels/workbook.xml.rels", std::move(xml_bytes)));
+    async::sync_wait(archiver_->add_file("xl/_rels/workbook.xml.rels", to_bytes(xml_content)));
 }
 
 void workbook_impl::generate_content_types() {
@@ -710,11 +916,7 @@ void workbook_impl::generate_content_types() {
 
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
-    }
-    async::sync_wait(archiver_->add_file("[Content_Types].xml", std::move(xml_bytes)));
+    async::sync_wait(archiver_->add_file("[Content_Types].xml", to_bytes(xml_content)));
 }
 
 void workbook_impl::generate_main_rels() {
@@ -743,11 +945,7 @@ void workbook_impl::generate_main_rels() {
     std::string xml_content = oss.str();
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
-    }
-    async::sync_wait(archiver_->add_file("_rels/.rels", std::move(xml_bytes)));
+    async::sync_wait(archiver_->add_file("_rels/.rels", to_bytes(xml_content)));
 }
 
 void workbook_impl::generate_styles_xml() {
@@ -757,21 +955,22 @@ void workbook_impl::generate_styles_xml() {
 
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
-    }
-    async::sync_wait(archiver_->add_file("xl/styles.xml", std::move(xml_bytes)));
+    async::sync_wait(archiver_->add_file("xl/styles.xml", to_bytes(xml_content)));
 }
 
-void workbook_impl::generate_shared_strings_xml() {
+void workbook_impl::generate_shared_strings_xml(bool table_changed, std::optional<std::size_t> reference_count) {
+    // 没有压缩也没有新增字符串时原始部件仍然有效，由归档器原样复制
+    if (!table_changed && archived_shared_string_count_ == shared_strings_->count()) {
+        return;
+    }
+
     // 使用共享字符串管理器生成XML
     std::string xml_content;
 
 
 
     if (shared_strings_ && shared_strings_->count() > 0) {
-        xml_content = shared_strings_->generate_xml();
+        xml_content = shared_strings_->generate_xml(reference_count);
     } else {
         // 如果没有共享字符串，使用序列化器生成空的共享字符串表
         std::ostringstream oss;
@@ -788,18 +987,48 @@ void workbook_impl::generate_shared_strings_xml() {
     }
 
     // 保存到归档器
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
+    async::sync_wait(archiver_->add_file("xl/sharedStrings.xml", to_bytes(xml_content)));
+}
+
+bool workbook_impl::compact_shared_strings() {
+    // 标记各工作表引用的索引，删除无人引用的字符串（被编辑覆盖、清除的单元格留下的）
+    std::vector<bool> referenced(shared_strings_->count());
+    for (const auto& [name, worksheet] : worksheets_) {
+        worksheet->mark_shared_strings(referenced);
+    }
+    auto mapping = shared_strings_->compact(referenced);
+    if (!mapping) {
+        return false;
+    }
+    for (auto& [name, worksheet] : worksheets_) {
+        worksheet->remap_shared_strings(*mapping);
     }
-    async::sync_wait(archiver_->add_file("xl/sharedStrings.xml", std::move(xml_bytes)));
+    return true;
 }
 
-void workbook_impl::save_to_archiver() {
+void workbook_impl::save_to_archiver(std::size_t deflate_threads, const core::WriteProfile& profile,
+                                     const core::FileWritePolicy& file_policy,
+                                     const core::SharedStringPolicy& string_policy) {
     if (!archiver_) {
-        // 创建新的归档器
-        auto temp_archiver = core::OpenXmlArchiver::create_in_memory_writer();
+        // 创建新的归档器，条目写完即写入目标文件
+        auto temp_archiver = core::OpenXmlArchiver::create_file_writer(file_path_.string(), file_policy);
         archiver_ = std::make_shared<core::OpenXmlArchiver>(std::move(temp_archiver));
+    } else {
+        // 流式写入的工作表已经在内存写入器中时无法切换，仍在内存中组装（已加载的工作簿）
+        archiver_->set_output_file(file_path_.string(), file_policy);
+    }
+    archiver_->set_deflate_threads(deflate_threads);
+    archiver_->set_write_profile(profile);
+
+    // 0. 未修改的工作表沿用原始部件；归档器进入写模式后无法再读取原始条目，
+    //    需要重新生成的工作表先补齐未加载的部分
+    std::set<std::string> copied_sheets;
+    for (auto& [name, worksheet] : worksheets_) {
+        if (can_copy_worksheet_part(name)) {
+            copied_sheets.insert(name);
+        } else {
+            worksheet->load_all();
+        }
     }
 
     // 1. 生成 [Content_Types].xml
@@ -815,16 +1044,35 @@ void workbook_impl::save_to_archiver() {
     // 4. 生成样式文件
     generate_styles_xml();
 
-    // 5. 先保存所有工作表（这会填充共享字符串表）
+    // 5. 原样复制的工作表按原始索引引用共享字符串，只有全部工作表都重新生成时才能压缩
+    const bool compacted = copied_sheets.empty() && compact_shared_strings();
+
+    // 6. 统计重新生成的工作表中每个字符串的出现次数，决定哪些字符串写入共享字符串表
+    StringStoragePlan string_plan(string_policy);
     for (auto& [name, worksheet] : worksheets_) {
-        worksheet->save_to_archiver(*archiver_);
+        if (!copied_sheets.count(name)) {
+            worksheet->count_strings(string_plan);
+        }
     }
 
-    // 6. 最后生成共享字符串文件（包含所有字符串）
-    generate_shared_strings_xml();
+    // 7. 保存所有工作表（这会填充共享字符串表并统计引用数）
+    std::size_t shared_string_references = 0;
+    for (auto& [name, worksheet] : worksheets_) {
+        if (!copied_sheets.count(name)) {
+            shared_string_references += worksheet->save_to_archiver(*archiver_, string_plan);
+        }
+    }
+
+    // 8. 最后生成共享字符串文件（包含所有字符串）；复制的工作表中的引用数未知，此时省略 count
+    std::optional<std::size_t> reference_count;
+    if (copied_sheets.empty()) {
+        reference_count = shared_string_references;
+    }
+    generate_shared_strings_xml(compacted, reference_count);
 
-    // 7. 保存到文件
+    // 9. 保存到文件
     async::sync_wait(archiver_->save_to_file(file_path_.string()));
+    archived_shared_string_count_ = shared_strings_->count();
 }
 
 // ========================================
@@ -886,7 +1134,7 @@ worksheet_impl& workbook_impl::get_worksheet_impl_public(const std::string& shee
 void workbook_impl::set_range_values(const std::string& sheet_name,
                                      const core::range_address& range_addr,
                                      const std::vector<std::vector<cell_data::CellValue>>& values) {
-    ensure_worksheet_loaded(sheet_name);
+    get_worksheet_impl(sheet_name).ensure_range_loaded(range_addr);
 
     // 计算范围大小
     std::size_t rows = range_addr.end.row - range_addr.start.row + 1;
@@ -906,7 +1154,7 @@ template<typename T>
 void workbook_impl::set_range_value_uniform(const std::string& sheet_name,
                                            const core::range_address& range_addr,
                                            const T& value) {
-    ensure_worksheet_loaded(sheet_name);
+    get_worksheet_impl(sheet_name).ensure_range_loaded(range_addr);
 
     // 批量设置相同值
     for (std::size_t r = range_addr.start.row; r <= range_addr.end.row; ++r) {
@@ -926,7 +1174,7 @@ template void workbook_impl::set_range_value_uniform<bool>(const std::string&, c
 void workbook_impl::set_range_style(const std::string& sheet_name,
                                    const core::range_address& range_addr,
                                    std::uint32_t style_id) {
-    ensure_worksheet_loaded(sheet_name);
+    get_worksheet_impl(sheet_name).ensure_range_loaded(range_addr);
 
     // 批量设置样式
     for (std::size_t r = range_addr.start.row; r <= range_addr.end.row; ++r) {
@@ -939,7 +1187,7 @@ void workbook_impl::set_range_style(const std::string& sheet_name,
 
 void workbook_impl::clear_range(const std::string& sheet_name,
                                const core::range_address& range_addr) {
-    ensure_worksheet_loaded(sheet_name);
+    get_worksheet_impl(sheet_name).ensure_range_loaded(range_addr);
 
     // 批量清除内容
     for (std::size_t r = range_addr.start.row; r <= range_addr.end.row; ++r) {
@@ -957,6 +1205,12 @@ std::vector<std::vector<cell_data::CellValue>> workbook_impl::get_range_values(
 
     std::vector<std::vector<cell_data::CellValue>> result;
 
+    // 只加载范围覆盖的行块
+    auto it = worksheets_.find(sheet_name);
+    if (it != worksheets_.end()) {
+        it->second->ensure_range_loaded(range_addr);
+    }
+
     // 计算范围大小
     std::size_t rows = range_addr.end.row - range_addr.start.row + 1;
     std::size_t cols = range_addr.end.column - range_addr.start.column + 1;
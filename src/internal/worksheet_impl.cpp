@@ -7,6 +7,9 @@
 
 #include "tinakit/internal/worksheet_impl.hpp"
 #include "tinakit/internal/coordinate_utils.hpp"
+#include "tinakit/internal/number_codec.hpp"
+#include "tinakit/internal/sheet_data_scanner.hpp"
+#include "tinakit/excel/shared_strings.hpp"
 #include "tinakit/excel/range.hpp"
 #include "tinakit/core/exceptions.hpp"
 #include "tinakit/core/async.hpp"
@@ -14,6 +17,7 @@
 #include "tinakit/core/xml_parser.hpp"
 #include "tinakit/excel/openxml_namespaces.hpp"
 #include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <sstream>
 #include <limits>
@@ -21,14 +25,21 @@
 
 namespace tinakit::internal {
 
+namespace {
+
+/// 整表流式加载时每次解压的块大小
+constexpr std::size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
+} // namespace
+
 using namespace utils;
 
 // ========================================
 // 构造函数和析构函数
 // ========================================
 
-worksheet_impl::worksheet_impl(const std::string& name, workbook_impl& workbook)
-    : name_(name), workbook_(workbook) {
+worksheet_impl::worksheet_impl(const std::string& name, workbook_impl& workbook, LoadState initial_state)
+    : name_(name), workbook_(workbook), load_state_(initial_state), cells_(workbook.string_pool(), &workbook.formula_arena(), &workbook.shared_strings()) {
 }
 
 worksheet_impl::~worksheet_impl() = default;
@@ -55,27 +66,12 @@ std::size_t worksheet_impl::max_column() const {
 }
 
 excel::Range worksheet_impl::get_used_range() const {
-    if (cells_.empty()) {
-        return excel::Range(); // 返回空范围
-    }
-
     // 找到最小和最大的行列
-    std::size_t min_row = std::numeric_limits<std::size_t>::max();
-    std::size_t max_row = 0;
-    std::size_t min_col = std::numeric_limits<std::size_t>::max();
-    std::size_t max_col = 0;
-
-    for (const auto& [pos, data] : cells_) {
-        min_row = std::min(min_row, pos.row);
-        max_row = std::max(max_row, pos.row);
-        min_col = std::min(min_col, pos.column);
-        max_col = std::max(max_col, pos.column);
+    auto bounds = cells_.bounds();
+    if (!bounds) {
+        return excel::Range(); // 返回空范围
     }
-
-    // 创建范围地址
-    core::Coordinate top_left(min_row, min_col);
-    core::Coordinate bottom_right(max_row, max_col);
-    core::range_address range_addr(top_left, bottom_right);
+    const core::range_address& range_addr = *bounds;
 
     // 创建Range对象，需要workbook_impl的shared_ptr
     // 通过workbook_引用获取shared_ptr
@@ -87,51 +83,57 @@ LoadState worksheet_impl::load_state() const {
     return load_state_;
 }
 
+std::size_t worksheet_impl::memory_usage() const {
+    return cells_.memory_usage();
+}
+
 // ========================================
 // 单元格数据访问
 // ========================================
 
+std::optional<CompactCell> worksheet_impl::get_cell(const core::Coordinate& pos) const {
+    // 按需加载不改变逻辑状态
+    const_cast<worksheet_impl*>(this)->ensure_loaded(pos);
+    return cells_.cell(pos);
+}
+
 cell_data worksheet_impl::get_cell_data(const core::Coordinate& pos) {
     ensure_loaded(pos);
 
-    auto it = cells_.find(pos);
-    if (it != cells_.end()) {
-        return it->second;
-    }
-
-    // 返回空的单元格数据
-    return cell_data();
+    // 不存在时返回空的单元格数据
+    return cells_.get(pos).value_or(cell_data());
 }
 
 cell_data worksheet_impl::get_cell_data(const core::Coordinate& pos) const {
-    auto it = cells_.find(pos);
-    if (it != cells_.end()) {
-        return it->second;
-    }
+    // 按需加载不改变逻辑状态
+    const_cast<worksheet_impl*>(this)->ensure_loaded(pos);
 
-    // 返回空的单元格数据
-    return cell_data();
+    // 不存在时返回空的单元格数据
+    return cells_.get(pos).value_or(cell_data());
 }
 
 void worksheet_impl::set_cell_data(const core::Coordinate& pos, const cell_data& data) {
-    cells_[pos] = data;
+    // 先加载所在行块，避免之后加载时覆盖新写入的数据
+    ensure_loaded(pos);
+    cells_.set(pos, data);
     update_dimensions(pos);
     mark_dirty();
 }
 
 void worksheet_impl::clear_cell_data(const core::Coordinate& pos) {
-    auto it = cells_.find(pos);
-    if (it != cells_.end()) {
-        cells_.erase(it);
+    ensure_loaded(pos);
+    if (cells_.erase(pos)) {
         mark_dirty();
     }
 }
 
 bool worksheet_impl::has_cell_data(const core::Coordinate& pos) const {
-    return cells_.find(pos) != cells_.end();
+    const_cast<worksheet_impl*>(this)->ensure_loaded(pos);
+    return cells_.contains(pos);
 }
 
 void worksheet_impl::remove_cell_data(const core::Coordinate& pos) {
+    ensure_loaded(pos);
     cells_.erase(pos);
     mark_dirty();
 }
@@ -139,17 +141,11 @@ void worksheet_impl::remove_cell_data(const core::Coordinate& pos) {
 std::map<core::Coordinate, cell_data> worksheet_impl::get_range_data(const core::range_address& range) {
     ensure_range_loaded(range);
     
+    // 只遍历实际存在的单元格，而不是逐个探测范围内的每个坐标
     std::map<core::Coordinate, cell_data> result;
-    
-    for (std::size_t row = range.start.row; row <= range.end.row; ++row) {
-        for (std::size_t col = range.start.column; col <= range.end.column; ++col) {
-            core::Coordinate pos(row, col);
-            auto it = cells_.find(pos);
-            if (it != cells_.end()) {
-                result[pos] = it->second;
-            }
-        }
-    }
+    cells_.for_each_in_range(range, [&result](const core::Coordinate& pos, const CellView& cell) {
+        result.emplace_hint(result.end(), pos, cell.to_cell_data());
+    });
     
     return result;
 }
@@ -185,25 +181,34 @@ void worksheet_impl::set_range_data(const core::range_address& range,
 // 惰性加载管理
 // ========================================
 
-void worksheet_impl::ensure_loaded(const core::Coordinate& /* pos */) {
+void worksheet_impl::ensure_loaded(const core::Coordinate& pos) {
     if (load_state_ == LoadState::NotLoaded) {
-        load_from_xml();
+        build_row_index();
+    }
+    if (load_state_ == LoadState::PartialLoaded) {
+        const std::size_t block = pos.row >> CellStore::BLOCK_SHIFT;
+        load_row_blocks(block, block);
     }
-    // TODO: 实现按需加载特定位置的数据
 }
 
-void worksheet_impl::ensure_range_loaded(const core::range_address& /* range */) {
+void worksheet_impl::ensure_range_loaded(const core::range_address& range) {
     if (load_state_ == LoadState::NotLoaded) {
-        load_from_xml();
+        build_row_index();
+    }
+    if (load_state_ == LoadState::PartialLoaded) {
+        load_row_blocks(range.start.row >> CellStore::BLOCK_SHIFT, range.end.row >> CellStore::BLOCK_SHIFT);
     }
-    // TODO: 实现按需加载特定范围的数据
 }
 
 void worksheet_impl::load_all() {
-    if (load_state_ != LoadState::FullyLoaded) {
-        load_from_xml();
-        load_state_ = LoadState::FullyLoaded;
+    if (load_state_ == LoadState::NotLoaded) {
+        // 整表加载不需要行块索引，边解压边扫描，不保留完整的 XML
+        load_streamed();
+    }
+    if (load_state_ == LoadState::PartialLoaded) {
+        load_row_blocks(0, std::numeric_limits<std::size_t>::max());
     }
+    load_state_ = LoadState::FullyLoaded;
 }
 
 void worksheet_impl::unload() {
@@ -211,6 +216,9 @@ void worksheet_impl::unload() {
     column_widths_.clear();
     row_heights_.clear();
     merged_ranges_.clear();
+    sheet_xml_.clear();
+    sheet_xml_.shrink_to_fit();
+    row_index_.reset();
     max_row_ = 0;
     max_column_ = 0;
     load_state_ = LoadState::NotLoaded;
@@ -221,92 +229,31 @@ void worksheet_impl::unload() {
 // ========================================
 
 void worksheet_impl::insert_rows(std::size_t row, std::size_t count) {
-    // 创建新的单元格映射
-    std::map<core::Coordinate, cell_data> new_cells;
-    
-    for (const auto& [pos, data] : cells_) {
-        if (pos.row >= row) {
-            // 移动到新位置
-            core::Coordinate new_pos(pos.row + count, pos.column);
-            new_cells[new_pos] = data;
-        } else {
-            // 保持原位置
-            new_cells[pos] = data;
-        }
-    }
-    
-    cells_ = std::move(new_cells);
+    load_all();
+    cells_.insert_rows(row, count);
     max_row_ += count;
     mark_dirty();
 }
 
 void worksheet_impl::delete_rows(std::size_t row, std::size_t count) {
-    // 删除指定范围内的行
-    auto it = cells_.begin();
-    while (it != cells_.end()) {
-        if (it->first.row >= row && it->first.row < row + count) {
-            it = cells_.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    // 移动后续行
-    std::map<core::Coordinate, cell_data> new_cells;
-    for (const auto& [pos, data] : cells_) {
-        if (pos.row >= row + count) {
-            core::Coordinate new_pos(pos.row - count, pos.column);
-            new_cells[new_pos] = data;
-        } else {
-            new_cells[pos] = data;
-        }
-    }
-    
-    cells_ = std::move(new_cells);
+    load_all();
+    // 删除指定范围内的行并移动后续行
+    cells_.delete_rows(row, count);
     max_row_ = std::max(0, static_cast<int>(max_row_) - static_cast<int>(count));
     mark_dirty();
 }
 
 void worksheet_impl::insert_columns(std::size_t column, std::size_t count) {
-    std::map<core::Coordinate, cell_data> new_cells;
-    
-    for (const auto& [pos, data] : cells_) {
-        if (pos.column >= column) {
-            core::Coordinate new_pos(pos.row, pos.column + count);
-            new_cells[new_pos] = data;
-        } else {
-            new_cells[pos] = data;
-        }
-    }
-    
-    cells_ = std::move(new_cells);
+    load_all();
+    cells_.insert_columns(column, count);
     max_column_ += count;
     mark_dirty();
 }
 
 void worksheet_impl::delete_columns(std::size_t column, std::size_t count) {
-    // 删除指定范围内的列
-    auto it = cells_.begin();
-    while (it != cells_.end()) {
-        if (it->first.column >= column && it->first.column < column + count) {
-            it = cells_.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    // 移动后续列
-    std::map<core::Coordinate, cell_data> new_cells;
-    for (const auto& [pos, data] : cells_) {
-        if (pos.column >= column + count) {
-            core::Coordinate new_pos(pos.row, pos.column - count);
-            new_cells[new_pos] = data;
-        } else {
-            new_cells[pos] = data;
-        }
-    }
-    
-    cells_ = std::move(new_cells);
+    load_all();
+    // 删除指定范围内的列并移动后续列
+    cells_.delete_columns(column, count);
     max_column_ = std::max(0, static_cast<int>(max_column_) - static_cast<int>(count));
     mark_dirty();
 }
@@ -366,56 +313,302 @@ void worksheet_impl::clear_dirty() {
 // 私有方法
 // ========================================
 
-void worksheet_impl::load_from_xml() {
+std::optional<std::string> worksheet_impl::read_sheet_xml() const {
+    auto part_path = workbook_.locate_worksheet_part(name_);
+    if (!part_path) {
+        return std::nullopt;
+    }
+    auto xml_data = async::sync_wait(workbook_.get_archiver()->read_file(*part_path));
+    return std::string(reinterpret_cast<const char*>(xml_data.data()), xml_data.size());
+}
+
+void worksheet_impl::build_row_index() {
+    std::optional<std::string> xml_content;
     try {
-        // 确定工作表文件路径
-        const auto workbook_names = workbook_.worksheet_names();
-        auto it = std::find(workbook_names.begin(), workbook_names.end(), name_);
-        std::size_t sheet_index = (it != workbook_names.end()) ?
-            std::distance(workbook_names.begin(), it) + 1 : 1;
+        xml_content = read_sheet_xml();
+    } catch (const std::exception&) {
+        // 读取失败时按空工作表处理
+    }
+    if (!xml_content) {
+        load_state_ = LoadState::FullyLoaded;
+        return;
+    }
+    index_sheet_xml(std::move(*xml_content));
+}
 
-        std::string file_path = "xl/worksheets/sheet" + std::to_string(sheet_index) + ".xml";
+void worksheet_impl::load_streamed() {
+    load_state_ = LoadState::FullyLoaded;
+    auto part_path = workbook_.locate_worksheet_part(name_);
+    if (!part_path) {
+        return;
+    }
 
-        // 从归档器中读取工作表XML
+    try {
         auto archiver = workbook_.get_archiver();
-        if (archiver && async::sync_wait(archiver->has_file(file_path))) {
-            auto xml_data = async::sync_wait(archiver->read_file(file_path));
+        auto reader = async::sync_wait(archiver->open_entry_reader(*part_path, STREAM_CHUNK_SIZE));
+        if (!stream_sheet_xml(reader)) {
+            // 快速路径不支持的语法：丢弃已扫描的单元格，由通用解析器重新流式解析
+            cells_.clear();
+            max_row_ = 0;
+            max_column_ = 0;
+            auto stream = async::sync_wait(archiver->open_entry_stream(*part_path, STREAM_CHUNK_SIZE));
+            parse_cell_data(*stream);
+        }
+    } catch (const std::exception&) {
+        // 读取失败时按空工作表处理
+        cells_.clear();
+        max_row_ = 0;
+        max_column_ = 0;
+    }
+}
 
-            // 将字节数据转换为字符串
-            std::string xml_content(
-                reinterpret_cast<const char*>(xml_data.data()),
-                xml_data.size()
-            );
+bool worksheet_impl::stream_sheet_xml(core::EntryReader& reader) {
+    // sheetData 以外的内容（列宽、合并单元格、条件格式等）通常很小，单独收集后交给通用解析器
+    std::string skeleton;
+    std::string_view prefix;
+    bool self_closing = false;
+    std::optional<std::size_t> sheet_data_begin;
+    while (!(sheet_data_begin = SheetRowIndex::find_sheet_data(skeleton, prefix, self_closing))) {
+        const auto chunk = reader.next_chunk();
+        if (chunk.empty()) {
+            break;
+        }
+        skeleton.append(chunk);
+    }
 
-            // 解析单元格数据
-            parse_cell_data(xml_content);
-        } else {
-            // 尝试其他可能的文件路径
-            std::vector<std::string> possible_paths = {
-                "xl/worksheets/sheet1.xml",
-                "xl/worksheets/" + name_ + ".xml"
-            };
-
-            for (const auto& path : possible_paths) {
-                if (archiver && async::sync_wait(archiver->has_file(path))) {
-                    auto xml_data = async::sync_wait(archiver->read_file(path));
-                    std::string xml_content(
-                        reinterpret_cast<const char*>(xml_data.data()),
-                        xml_data.size()
-                    );
-                    parse_cell_data(xml_content);
-                    break;
-                }
+    if (sheet_data_begin && !self_closing) {
+        SheetDataScanner scanner;
+        scanner.feed(std::string_view(skeleton).substr(*sheet_data_begin));
+        skeleton.resize(*sheet_data_begin);
+
+        const auto shared_strings = workbook_.get_shared_strings();
+        ScannedCell cell;
+        while (true) {
+            while (scanner.next(cell)) {
+                store_scanned_cell(cell, shared_strings.get());
+            }
+            if (!scanner.needs_input()) {
+                break;
+            }
+            const auto chunk = reader.next_chunk();
+            if (chunk.empty()) {
+                scanner.finish_input();
+            } else {
+                scanner.feed(chunk);
             }
         }
+        if (!scanner.ended()) {
+            return false;
+        }
+        skeleton.append(scanner.remaining());
+    }
 
-        load_state_ = LoadState::FullyLoaded;
-    } catch (const std::exception&) {
-        // 如果加载失败，标记为已加载但保持空状态
-        load_state_ = LoadState::FullyLoaded;
+    for (auto chunk = reader.next_chunk(); !chunk.empty(); chunk = reader.next_chunk()) {
+        skeleton.append(chunk);
+    }
+    parse_cell_data(skeleton);
+    return true;
+}
+
+void worksheet_impl::index_sheet_xml(std::string xml) {
+    sheet_xml_ = std::move(xml);
+    row_index_ = SheetRowIndex::build(sheet_xml_, CellStore::BLOCK_SHIFT);
+    if (!row_index_) {
+        // 无法安全切分，回退到整表解析
+        parse_cell_data(sheet_xml_);
+        finish_partial_load();
+        return;
+    }
+
+    // 先解析 sheetData 以外的内容（合并单元格、条件格式等），行块留待按需解析
+    parse_sheet_skeleton(sheet_xml_, *row_index_);
+
+    load_state_ = LoadState::PartialLoaded;
+    if (row_index_->fully_loaded()) {
+        finish_partial_load();
+    }
+}
+
+void worksheet_impl::parse_sheet_skeleton(std::string_view xml, const SheetRowIndex& index) {
+    std::string skeleton;
+    skeleton.reserve(index.sheet_data_begin() + xml.size() - index.sheet_data_end());
+    skeleton.append(xml.substr(0, index.sheet_data_begin()));
+    skeleton.append(xml.substr(index.sheet_data_end()));
+    parse_cell_data(skeleton);
+}
+
+namespace {
+
+/**
+ * @brief 扫描连续的若干行块，数值在此处完成转换，共享字符串留待合并时解析
+ */
+void scan_chunk(std::string_view xml, const std::vector<SheetRowIndex::Span>& spans,
+                std::size_t first_span, std::size_t last_span, PreparedSheet::Chunk& chunk) {
+    const auto in_xml = [&xml](std::string_view text) {
+        return text.data() >= xml.data() && text.data() + text.size() <= xml.data() + xml.size();
+    };
+    // 扫描器缓冲区中的解码文本会被下一个单元格覆盖，需要复制出来
+    const auto keep = [&](std::string_view text) -> std::string_view {
+        return text.empty() || in_xml(text) ? text : std::string_view(chunk.decoded.emplace_back(text));
+    };
+
+    for (std::size_t i = first_span; i < last_span; ++i) {
+        SheetDataScanner scanner(xml.substr(spans[i].begin, spans[i].end - spans[i].begin));
+        ScannedCell cell;
+        while (scanner.next(cell)) {
+            if (cell.row == 0) {
+                continue;
+            }
+            auto& out = chunk.cells.emplace_back();
+            out.pos = core::Coordinate(cell.row, cell.column);
+            out.view.style_id = cell.style_id;
+            if (cell.has_formula) {
+                out.view.formula = keep(cell.formula);
+            }
+            if (cell.type == "s") {
+                out.shared_string = true;
+                out.view.text = keep(cell.text);
+            } else {
+                worksheet_impl::convert_cell_value(cell.type, keep(cell.text), nullptr, out.view);
+            }
+        }
+        if (scanner.failed()) {
+            chunk.failed = true;
+            return;
+        }
     }
 }
 
+async::Task<void> scan_chunk_async(async::Executor& executor, std::string_view xml,
+                                   const std::vector<SheetRowIndex::Span>& spans,
+                                   std::size_t first_span, std::size_t last_span, PreparedSheet::Chunk& chunk) {
+    co_await async::schedule_on(executor);
+    scan_chunk(xml, spans, first_span, last_span, chunk);
+}
+
+} // namespace
+
+async::Task<void> worksheet_impl::prepare(async::Executor& executor, std::string xml, PreparedSheet& prepared,
+                                          std::size_t max_chunks, std::size_t min_chunk_bytes) {
+    prepared.available = true;
+    prepared.xml = std::move(xml);
+    prepared.row_index = SheetRowIndex::build(prepared.xml, CellStore::BLOCK_SHIFT);
+    if (!prepared.row_index) {
+        co_return;
+    }
+
+    // 在 <row 边界（行块）上按字节大致均分
+    const auto& spans = prepared.row_index->spans();
+    const std::size_t data_bytes = prepared.row_index->sheet_data_end() - prepared.row_index->sheet_data_begin();
+    const std::size_t chunk_count = std::clamp<std::size_t>(data_bytes / std::max<std::size_t>(min_chunk_bytes, 1),
+                                                            1, std::max<std::size_t>(std::min(max_chunks, spans.size()), 1));
+    const std::size_t target_bytes = data_bytes / chunk_count + 1;
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    std::size_t first = 0;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        bytes += spans[i].end - spans[i].begin;
+        if (bytes >= target_bytes && ranges.size() + 1 < chunk_count) {
+            ranges.emplace_back(first, i + 1);
+            first = i + 1;
+            bytes = 0;
+        }
+    }
+    ranges.emplace_back(first, spans.size());
+
+    const std::string_view xml_view(prepared.xml);
+    prepared.chunks.resize(ranges.size());
+    if (ranges.size() == 1) {
+        scan_chunk(xml_view, spans, ranges[0].first, ranges[0].second, prepared.chunks[0]);
+    } else {
+        std::vector<async::Task<void>> tasks;
+        tasks.reserve(ranges.size());
+        for (std::size_t i = 0; i < ranges.size(); ++i) {
+            tasks.push_back(scan_chunk_async(executor, xml_view, spans, ranges[i].first, ranges[i].second,
+                                             prepared.chunks[i]));
+        }
+        co_await async::when_all(std::move(tasks));
+    }
+
+    prepared.scanned = std::none_of(prepared.chunks.begin(), prepared.chunks.end(),
+                                    [](const PreparedSheet::Chunk& chunk) { return chunk.failed; });
+    if (!prepared.scanned) {
+        prepared.chunks.clear();
+    }
+}
+
+void worksheet_impl::adopt(PreparedSheet& prepared) {
+    if (load_state_ != LoadState::NotLoaded || !prepared.available) {
+        return;
+    }
+    if (!prepared.scanned) {
+        // 快速路径不支持的语法：使用已解压的内容走通用路径
+        index_sheet_xml(std::move(prepared.xml));
+        load_all();
+        return;
+    }
+
+    parse_sheet_skeleton(prepared.xml, *prepared.row_index);
+
+    // 按分块顺序（即行顺序）写入存储，共享字符串在此处解析
+    const auto shared_strings = workbook_.get_shared_strings();
+    for (const auto& chunk : prepared.chunks) {
+        for (const auto& cell : chunk.cells) {
+            if (cell.shared_string) {
+                CellView view = cell.view;
+                convert_cell_value("s", cell.view.text, shared_strings.get(), view);
+                store_view(cell.pos, view);
+            } else {
+                store_view(cell.pos, cell.view);
+            }
+        }
+    }
+    load_state_ = LoadState::FullyLoaded;
+}
+
+void worksheet_impl::load_row_blocks(std::size_t first_block, std::size_t last_block) {
+    if (!row_index_) {
+        return;
+    }
+
+    const std::string_view xml(sheet_xml_);
+    const auto root_tag = row_index_->root_open_tag(xml);
+    const auto root_name = row_index_->root_name(xml);
+
+    auto& spans = row_index_->spans();
+    auto it = std::lower_bound(spans.begin(), spans.end(), first_block,
+        [](const SheetRowIndex::Span& span, std::size_t block) { return span.block < block; });
+    for (; it != spans.end() && it->block <= last_block; ++it) {
+        if (it->loaded) {
+            continue;
+        }
+        it->loaded = true;
+        const auto span_xml = xml.substr(it->begin, it->end - it->begin);
+        if (scan_cell_data(span_xml)) {
+            continue;
+        }
+
+        // 快速路径不支持的语法：用根元素包装行块片段，保留命名空间声明，交给通用解析器
+        std::string fragment;
+        fragment.reserve(root_tag.size() + (it->end - it->begin) + root_name.size() + 3);
+        fragment.append(root_tag);
+        fragment.append(span_xml);
+        fragment.append("</").append(root_name).append(">");
+        parse_cell_data(fragment);
+    }
+
+    if (row_index_->fully_loaded()) {
+        finish_partial_load();
+    }
+}
+
+void worksheet_impl::finish_partial_load() {
+    std::string().swap(sheet_xml_);
+    row_index_.reset();
+    load_state_ = LoadState::FullyLoaded;
+}
+
 void worksheet_impl::update_dimensions(const core::Coordinate& pos) {
     max_row_ = std::max(max_row_, pos.row);
     max_column_ = std::max(max_column_, pos.column);
@@ -423,99 +616,198 @@ void worksheet_impl::update_dimensions(const core::Coordinate& pos) {
 
 void worksheet_impl::parse_cell_data(const std::string& xml_content) {
     try {
-        // 性能监控：记录开始时间
-        auto start_time = std::chrono::high_resolution_clock::now();
-
-        // 使用 XmlParser 解析工作表数据
-        std::istringstream xml_stream(xml_content);
-        core::XmlParser parser(xml_stream, name_ + ".xml");
-
-        // 启用错误恢复模式，以便在遇到未知属性时继续解析
-        parser.set_error_recovery(true);
-
-        // 使用单次遍历解析多种元素类型以提高性能
-        const std::string& main_ns = excel::openxml_ns::main;
-
-        std::map<std::pair<std::string, std::string>, std::function<void(core::XmlParser::iterator&)>> handlers = {
-            // 单元格数据解析（在主命名空间中）
-            {{main_ns, "c"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_single_cell(it, parser);
-            }},
-
-            // 单元格数据解析（无命名空间，因为子元素可能有xmlns=""）
-            {{"", "c"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_single_cell(it, parser);
-            }},
-
-            // 条件格式解析（在主命名空间中）
-            {{main_ns, "conditionalFormatting"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_conditional_formatting(it, parser);
-            }},
-
-            // 条件格式解析（无命名空间）
-            {{"", "conditionalFormatting"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_conditional_formatting(it, parser);
-            }},
-
-            // 合并单元格解析（在主命名空间中）
-            {{main_ns, "mergeCells"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_merged_cells(it, parser);
-            }},
-
-            // 合并单元格解析（无命名空间）
-            {{"", "mergeCells"}, [this, &parser](core::XmlParser::iterator& it) {
-                parse_merged_cells(it, parser);
-            }}
-        };
+        core::XmlParser parser(std::string_view(xml_content), name_ + ".xml");
+        parse_cell_elements(parser);
+    } catch (const std::exception& e) {
+        // 解析失败时忽略错误，但记录日志用于调试
+        std::cerr << "XML解析异常: " << e.what() << std::endl;
+    }
+}
 
-        // 使用优化的单次遍历解析
-        parser.parse_multiple_elements_ns(handlers);
+void worksheet_impl::parse_cell_data(std::istream& stream) {
+    try {
+        core::XmlParser parser(stream, name_ + ".xml");
+        parse_cell_elements(parser);
+    } catch (const std::exception& e) {
+        std::cerr << "XML解析异常: " << e.what() << std::endl;
+    }
+}
 
-        // 检查是否有解析错误
-        if (auto error = parser.get_last_error()) {
-            std::cerr << "XML解析警告: " << error->message
-                     << " at line " << error->line << ", column " << error->column << std::endl;
-        }
+void worksheet_impl::parse_cell_elements(core::XmlParser& parser) {
+    // 性能监控：记录开始时间
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // 启用错误恢复模式，以便在遇到未知属性时继续解析
+    parser.set_error_recovery(true);
+
+    // 使用单次遍历解析多种元素类型以提高性能
+    const std::string& main_ns = excel::openxml_ns::main;
+
+    std::map<std::pair<std::string, std::string>, std::function<void(core::XmlParser::iterator&)>> handlers = {
+        // 单元格数据解析（在主命名空间中）
+        {{main_ns, "c"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_single_cell(it, parser);
+        }},
+
+        // 单元格数据解析（无命名空间，因为子元素可能有xmlns=""）
+        {{"", "c"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_single_cell(it, parser);
+        }},
+
+        // 条件格式解析（在主命名空间中）
+        {{main_ns, "conditionalFormatting"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_conditional_formatting(it, parser);
+        }},
+
+        // 条件格式解析（无命名空间）
+        {{"", "conditionalFormatting"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_conditional_formatting(it, parser);
+        }},
+
+        // 合并单元格解析（在主命名空间中）
+        {{main_ns, "mergeCells"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_merged_cells(it, parser);
+        }},
+
+        // 合并单元格解析（无命名空间）
+        {{"", "mergeCells"}, [this, &parser](core::XmlParser::iterator& it) {
+            parse_merged_cells(it, parser);
+        }}
+    };
+
+    // 使用优化的单次遍历解析
+    parser.parse_multiple_elements_ns(handlers);
+
+    // 检查是否有解析错误
+    if (auto error = parser.get_last_error()) {
+        std::cerr << "XML解析警告: " << error->message
+                 << " at line " << error->line << ", column " << error->column << std::endl;
+    }
+
+    // 性能监控：记录结束时间和统计信息
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    // 在调试模式下输出性能信息
+    #ifdef _DEBUG
+    std::cout << "📊 XML解析性能统计 (" << name_ << "):" << std::endl;
+    std::cout << "  - 解析时间: " << duration.count() << " μs" << std::endl;
+    std::cout << "  - 单元格数量: " << cells_.size() << std::endl;
+    std::cout << "  - 条件格式数量: " << conditional_formats_.size() << std::endl;
+    std::cout << "  - 合并单元格数量: " << merged_ranges_.size() << std::endl;
+    #endif
+}
+
+bool worksheet_impl::scan_cell_data(std::string_view xml) {
+    const auto shared_strings = workbook_.get_shared_strings();
+    SheetDataScanner scanner(xml);
+    ScannedCell cell;
+    while (scanner.next(cell)) {
+        store_scanned_cell(cell, shared_strings.get());
+    }
+    return !scanner.failed();
+}
+
+void worksheet_impl::store_scanned_cell(const ScannedCell& cell, const excel::SharedStrings* shared_strings) {
+    if (cell.row == 0) {
+        return;
+    }
+    std::optional<std::string_view> formula;
+    if (cell.has_formula) {
+        formula = cell.formula;
+    }
+    store_cell(core::Coordinate(cell.row, cell.column), cell.type, cell.text, formula, cell.style_id, shared_strings);
+}
 
-        // 性能监控：记录结束时间和统计信息
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-
-        // 在调试模式下输出性能信息
-        #ifdef _DEBUG
-        std::cout << "📊 XML解析性能统计 (" << name_ << "):" << std::endl;
-        std::cout << "  - 解析时间: " << duration.count() << " μs" << std::endl;
-        std::cout << "  - XML大小: " << xml_content.size() << " bytes" << std::endl;
-        std::cout << "  - 单元格数量: " << cells_.size() << std::endl;
-        std::cout << "  - 条件格式数量: " << conditional_formats_.size() << std::endl;
-        std::cout << "  - 合并单元格数量: " << merged_ranges_.size() << std::endl;
-        if (duration.count() > 0) {
-            std::cout << "  - 处理速度: " << (xml_content.size() * 1000000 / duration.count()) << " bytes/s" << std::endl;
+void worksheet_impl::convert_cell_value(std::string_view type, std::string_view text,
+                                        const excel::SharedStrings* shared_strings, CellView& view) {
+    auto set_string = [&view](std::string_view value) {
+        view.kind = CellKind::String;
+        view.text = value;
+    };
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (type == "s") {
+        // 共享字符串：单元格只保存索引，文本在首次读取时才解码；公式的缓存结果需要文本。
+        // 索引无效时保留原始文本
+        std::uint32_t index = 0;
+        auto [ptr, ec] = std::from_chars(first, last, index);
+        if (ec == std::errc() && ptr == last && shared_strings && index < shared_strings->count()) {
+            view.kind = CellKind::String;
+            view.text = view.formula ? std::string_view(shared_strings->get_string(index)) : std::string_view();
+            view.shared_index = index;
+        } else if (!text.empty()) {
+            set_string(text);
         }
-        #endif
+    } else if (type == "b") {
+        view.kind = CellKind::Boolean;
+        view.boolean = text == "1";
+    } else if (type == "e") {
+        // 未知的错误文本保留为字符串
+        if (auto error = parse_cell_error(text)) {
+            view.kind = CellKind::Error;
+            view.error = *error;
+        } else {
+            set_string(text);
+        }
+    } else if (type.empty() || type == "n") {
+        if (!text.empty()) {
+            // 先按整数解析，失败（含 "1e5"、超出 int 范围的整数）再按浮点数解析，都失败时保留原文
+            if (auto integer = utils::NumberCodec::parse_integer(text)) {
+                view.kind = CellKind::Integer;
+                view.number = *integer;
+            } else if (auto number = utils::NumberCodec::parse_number(text)) {
+                view.kind = CellKind::Number;
+                view.number = *number;
+            } else {
+                set_string(text);
+            }
+        }
+    } else {
+        // inlineStr、str 等都按字符串处理
+        set_string(text);
+    }
+}
 
-    } catch (const std::exception& e) {
-        // 解析失败时忽略错误，但记录日志用于调试
-        std::cerr << "XML解析异常: " << e.what() << std::endl;
+void worksheet_impl::store_cell(const core::Coordinate& pos, std::string_view type, std::string_view text,
+                                std::optional<std::string_view> formula, std::uint32_t style_id,
+                                const excel::SharedStrings* shared_strings) {
+    CellView view;
+    view.formula = formula;
+    view.style_id = style_id;
+    convert_cell_value(type, text, shared_strings, view);
+    store_view(pos, view);
+}
+
+void worksheet_impl::store_view(const core::Coordinate& pos, const CellView& view) {
+    // 只要有值、样式或公式就存储单元格；空字符串不算有值，非字符串值（包括无值）和
+    // 共享字符串（文本尚未解码）都认为有值
+    const bool has_value = view.kind != CellKind::String || view.shared_index || !view.text.empty();
+    if (has_value || view.style_id != 0 || view.formula) {
+        cells_.set(pos, view);
+        update_dimensions(pos);
     }
 }
 
 void worksheet_impl::parse_single_cell(core::XmlParser::iterator& it, core::XmlParser& parser) {
-    // 获取单元格引用（如 A1, B2 等）
-    auto cell_ref = it.attribute("r");
-    auto cell_type = it.attribute("t");
-    auto style_id = it.attribute("s");
+    // 属性值和文本都是解析分配区中的视图，处理器返回后由解析器统一释放
+    auto cell_ref = it.attribute_view("r");
+    auto cell_type = it.attribute_view("t");
+    auto style_attr = it.attribute_view("s");
 
     if (cell_ref && !cell_ref->empty()) {
         // 解析单元格位置
-        auto pos = core::Coordinate::from_address(*cell_ref);
+        auto pos = core::Coordinate::from_address(std::string(*cell_ref));
 
-        // 创建单元格数据
-        cell_data data;
-        data.style_id = style_id ? std::stoul(*style_id) : 0;
+        std::uint32_t style_id = 0;
+        if (style_attr) {
+            std::from_chars(style_attr->data(), style_attr->data() + style_attr->size(), style_id);
+        }
 
         // 查找单元格值
-        std::string cell_value;
+        std::string_view cell_value;
+        std::optional<std::string_view> formula;
 
         // 在当前单元格元素中查找值
         auto current_it = it;
@@ -525,11 +817,11 @@ void worksheet_impl::parse_single_cell(core::XmlParser::iterator& it, core::XmlP
                !(current_it.is_end_element() && current_it.name() == "c")) {
 
             if (current_it.is_start_element() && current_it.name() == "v") {
-                cell_value = current_it.text_content();
+                cell_value = current_it.text_view();
                 break;
             } else if (current_it.is_start_element() && current_it.name() == "f") {
                 // 处理公式
-                data.formula = current_it.text_content();
+                formula = current_it.text_view();
             } else if (current_it.is_start_element() && current_it.name() == "is") {
                 // 处理内联字符串：查找 <is><t>...</t></is> 结构
                 auto is_it = current_it;
@@ -537,7 +829,7 @@ void worksheet_impl::parse_single_cell(core::XmlParser::iterator& it, core::XmlP
                 while (is_it != parser.end() &&
                        !(is_it.is_end_element() && is_it.name() == "is")) {
                     if (is_it.is_start_element() && is_it.name() == "t") {
-                        cell_value = is_it.text_content();
+                        cell_value = is_it.text_view();
                         break;
                     }
                     ++is_it;
@@ -547,61 +839,8 @@ void worksheet_impl::parse_single_cell(core::XmlParser::iterator& it, core::XmlP
             ++current_it;
         }
 
-        // 根据单元格类型设置值
-        if (cell_type && *cell_type == "s") {
-            // 共享字符串：需要从共享字符串表中查找实际文本
-            if (!cell_value.empty()) {
-                try {
-                    std::uint32_t index = std::stoul(cell_value);
-                    auto shared_strings = this->workbook_.get_shared_strings();
-                    if (shared_strings && index < shared_strings->count()) {
-                        data.value = shared_strings->get_string(index);
-                    } else {
-                        // 如果索引无效，使用索引值作为后备
-                        data.value = cell_value;
-                    }
-                } catch (...) {
-                    // 如果解析索引失败，使用原始值
-                    data.value = cell_value;
-                }
-            }
-        } else if (cell_type && *cell_type == "inlineStr") {
-            // 内联字符串
-            data.value = cell_value;
-        } else if (cell_type && *cell_type == "b") {
-            // 布尔值
-            data.value = (cell_value == "1");
-        } else if (!cell_type || cell_type->empty() || *cell_type == "n") {
-            // 数字
-            if (!cell_value.empty()) {
-                try {
-                    if (cell_value.find('.') != std::string::npos) {
-                        data.value = std::stod(cell_value);
-                    } else {
-                        data.value = std::stoi(cell_value);
-                    }
-                } catch (...) {
-                    data.value = cell_value;
-                }
-            }
-        } else {
-            // 其他类型作为字符串处理
-            data.value = cell_value;
-        }
-
-        // 存储单元格数据
-        // 只要有值或者有样式ID就存储单元格
-        bool has_value = false;
-        if (std::holds_alternative<std::string>(data.value)) {
-            has_value = !std::get<std::string>(data.value).empty();
-        } else {
-            has_value = true; // 非字符串值都认为有值
-        }
-
-        if (has_value || data.style_id != 0 || data.formula) {
-            this->cells_[pos] = data;
-            this->update_dimensions(pos);
-        }
+        store_cell(pos, cell_type.value_or(std::string_view()), cell_value, formula,
+                   style_id, this->workbook_.get_shared_strings().get());
     }
 }
 
@@ -744,33 +983,48 @@ void worksheet_impl::parse_merged_cells(core::XmlParser::iterator& it, core::Xml
 
 }
 
-void worksheet_impl::save_to_archiver(core::OpenXmlArchiver& archiver) {
-    // 生成工作表XML并保存到归档器
-    auto xml_content = generate_worksheet_xml();
-
-    // 确定文件路径（基于工作表在工作簿中的位置）
-    auto workbook_names = workbook_.worksheet_names();
-    auto it = std::find(workbook_names.begin(), workbook_names.end(), name_);
-    std::size_t sheet_index = (it != workbook_names.end()) ?
-        std::distance(workbook_names.begin(), it) + 1 : 1;
+void worksheet_impl::count_strings(StringStoragePlan& plan) {
+    load_all();
+    plan.count(cells_);
+}
 
-    std::string file_path = "xl/worksheets/sheet" + std::to_string(sheet_index) + ".xml";
+std::size_t worksheet_impl::save_to_archiver(core::OpenXmlArchiver& archiver, const StringStoragePlan& plan) {
+    const std::string file_path = workbook_.worksheet_save_path(name_);
 
-    // 转换为字节数组
-    std::vector<std::byte> xml_bytes;
-    for (char c : xml_content) {
-        xml_bytes.push_back(static_cast<std::byte>(c));
+    if (streamed_part_path_) {
+        // 内容已由流式写入器直接写入归档
+        if (*streamed_part_path_ != file_path) {
+            throw TinaKitException("Streamed worksheet '" + name_ + "' was moved after writing; its part can no longer be renamed",
+                                   "worksheet_impl::save_to_archiver");
+        }
+        // 流式写入器只写内联字符串
+        return 0;
     }
 
-    // 保存到归档器
-    async::sync_wait(archiver.add_file(file_path, std::move(xml_bytes)));
+    load_all();
+
+    // 边序列化边压缩，不在内存中保留整张工作表的 XML
+    core::EntryOutputStream out(archiver, file_path);
+    const std::size_t references = write_worksheet_xml(out, plan);
+    out.close();
+    return references;
 }
 
+void worksheet_impl::mark_shared_strings(std::vector<bool>& referenced) const {
+    cells_.mark_shared_strings(referenced);
+}
+
+void worksheet_impl::remap_shared_strings(const std::vector<std::uint32_t>& mapping) {
+    cells_.remap_shared_strings(mapping);
+}
 
+void worksheet_impl::mark_streamed(std::string part_path) {
+    streamed_part_path_ = std::move(part_path);
+}
 
-std::string worksheet_impl::generate_worksheet_xml() {
-    std::ostringstream oss;
-    core::XmlSerializer serializer(oss, "worksheet.xml");
+std::size_t worksheet_impl::write_worksheet_xml(std::ostream& out, const StringStoragePlan& plan) {
+    core::XmlSerializer serializer(out, "worksheet.xml");
+    std::size_t shared_string_references = 0;
 
     // XML声明
     serializer.xml_declaration("1.0", "UTF-8", "yes");
@@ -786,93 +1040,136 @@ std::string worksheet_impl::generate_worksheet_xml() {
     if (!cells_.empty()) {
         serializer.start_element(excel::openxml_ns::main, "sheetData");
 
-        // 按行组织单元格数据
-        std::map<std::size_t, std::vector<std::pair<std::size_t, cell_data>>> rows_data;
-        for (const auto& [pos, data] : cells_) {
-            rows_data[pos.row].emplace_back(pos.column, data);
-        }
-
-        // 生成行数据
-        for (auto& [row_num, row_cells] : rows_data) {
-            serializer.start_element(excel::openxml_ns::main, "row");
-            serializer.attribute("r", std::to_string(row_num));
-
-            // 排序列（按列号排序）
-            std::sort(row_cells.begin(), row_cells.end(),
-                     [](const auto& a, const auto& b) { return a.first < b.first; });
-
-            // 生成单元格数据
-            for (const auto& [col_num, cell_data] : row_cells) {
-                // 简单的列名转换（A, B, C...）
-                std::string col_name;
-                std::size_t temp_col = col_num;
-                while (temp_col > 0) {
-                    col_name = char('A' + (temp_col - 1) % 26) + col_name;
-                    temp_col = (temp_col - 1) / 26;
+        auto shared_strings = workbook_.get_shared_strings();
+
+        // 存储按行优先顺序遍历，直接逐行输出，无需先按行分组复制
+        std::size_t current_row = 0;
+        // 序列化器只接受 std::string：引用、数字、字符串和公式都写入复用的缓冲区，不为每个单元格分配
+        std::string text_buffer;
+        std::string ref_buffer;
+        std::string number_buffer;
+        utils::CoordinateUtils::CoordinateBuffer coordinate;
+        utils::NumberCodec::NumberBuffer digits;
+        auto format_integer = [&](auto value) -> const std::string& {
+            return number_buffer.assign(utils::NumberCodec::format_integer(value, digits));
+        };
+        cells_.for_each_cell([&](const core::Coordinate& pos, const CompactCell& compact) {
+            if (pos.row != current_row) {
+                if (current_row != 0) {
+                    serializer.end_element(); // row
                 }
-                std::string cell_ref = col_name + std::to_string(row_num);
+                current_row = pos.row;
+                serializer.start_element(excel::openxml_ns::main, "row");
+                serializer.attribute("r", format_integer(current_row));
+            }
 
-                serializer.start_element(excel::openxml_ns::main, "c");
-                serializer.attribute("r", cell_ref);
+            serializer.start_element(excel::openxml_ns::main, "c");
+            serializer.attribute("r", ref_buffer.assign(utils::CoordinateUtils::format_coordinate(pos.row, pos.column, coordinate)));
 
-                if (cell_data.style_id != 0) {
-                    serializer.attribute("s", std::to_string(cell_data.style_id));
-                }
+            if (compact.style_id != 0) {
+                serializer.attribute("s", format_integer(compact.style_id));
+            }
 
-                // 根据值类型添加类型属性和内容
-                // 为了避免lambda捕获问题，先获取需要的对象
-                auto shared_strings = workbook_.get_shared_strings();
-
-                std::visit([&serializer, shared_strings, this](const auto& value) {
-                    using T = std::decay_t<decltype(value)>;
-                    if constexpr (std::is_same_v<T, std::string>) {
-                        if (!value.empty()) {
-                            // 智能选择字符串存储方式
-                            if (this->should_use_inline_string(value)) {
-                                // 使用内联字符串格式
-                                serializer.attribute("t", "inlineStr");
-                                serializer.start_element(excel::openxml_ns::main, "is");
-                                serializer.element_with_namespace(excel::openxml_ns::main, "t", value);
-                                serializer.end_element(); // is
-                            } else {
-                                // 使用共享字符串格式
-                                if (shared_strings) {
-                                    std::uint32_t index = shared_strings->add_string(value);
-                                    serializer.attribute("t", "s");
-                                    serializer.element_with_namespace(excel::openxml_ns::main, "v", std::to_string(index));
-                                } else {
-                                    // 回退到内联字符串
-                                    serializer.attribute("t", "inlineStr");
-                                    serializer.start_element(excel::openxml_ns::main, "is");
-                                    serializer.element_with_namespace(excel::openxml_ns::main, "t", value);
-                                    serializer.end_element(); // is
-                                }
-                            }
-                        }
-                        // 空字符串不需要特殊处理
-                    } else if constexpr (std::is_same_v<T, double>) {
-                        // 数字类型：使用数值格式
-                        serializer.attribute("t", "n");
-                        serializer.element_with_namespace(excel::openxml_ns::main, "v", std::to_string(value));
-                    } else if constexpr (std::is_same_v<T, int>) {
-                        // 整数类型：使用数值格式
-                        serializer.attribute("t", "n");
-                        serializer.element_with_namespace(excel::openxml_ns::main, "v", std::to_string(value));
-                    } else if constexpr (std::is_same_v<T, bool>) {
-                        // 布尔类型：使用布尔格式
-                        serializer.attribute("t", "b");
-                        serializer.element_with_namespace(excel::openxml_ns::main, "v", value ? "1" : "0");
+            // 公式单元格的值是公式表中缓存的结果；<f> 必须位于 <v> 之前
+            CellKind kind = compact.kind;
+            CellPayload value = compact.payload;
+            std::string_view formula;
+            if (compact.has_formula()) {
+                const auto& entry = workbook_.formula_arena().get(compact.payload.id);
+                formula = workbook_.string_pool().get_string(entry.text);
+                kind = entry.result_kind;
+                value = entry.result;
+            }
+
+            // 根据值类型添加类型属性
+            switch (kind) {
+                case CellKind::String:
+                    if (compact.has_formula()) {
+                        serializer.attribute("t", "str");
                     }
-                }, cell_data.value);
+                    break;
+                case CellKind::Number:
+                case CellKind::Integer:
+                    serializer.attribute("t", "n");
+                    break;
+                case CellKind::SharedString:
+                    serializer.attribute("t", "s");
+                    break;
+                case CellKind::Boolean:
+                    serializer.attribute("t", "b");
+                    break;
+                case CellKind::Error:
+                    serializer.attribute("t", "e");
+                    break;
+                case CellKind::Empty:
+                case CellKind::Formula:
+                    break;
+            }
 
-                // 添加公式（如果有）
-                if (cell_data.formula) {
-                    serializer.element_with_namespace(excel::openxml_ns::main, "f", *cell_data.formula);
-                }
+            if (compact.has_formula()) {
+                text_buffer.assign(formula);
+                serializer.element_with_namespace(excel::openxml_ns::main, "f", text_buffer);
+            }
 
-                serializer.end_element(); // c
+            switch (kind) {
+                case CellKind::String: {
+                    const std::string_view text = workbook_.string_pool().get_string(value.id);
+                    // 空字符串不需要特殊处理
+                    if (text.empty()) {
+                        break;
+                    }
+                    const std::string& text_value = text_buffer.assign(text);
+                    if (compact.has_formula()) {
+                        serializer.element_with_namespace(excel::openxml_ns::main, "v", text_value);
+                    } else if (!shared_strings || !plan.share(value.id)) {
+                        // 按出现次数选择存储方式，没有共享字符串表时回退到内联字符串
+                        serializer.attribute("t", "inlineStr");
+                        serializer.start_element(excel::openxml_ns::main, "is");
+                        serializer.start_element(excel::openxml_ns::main, "t");
+                        if (excel::SharedStrings::needs_space_preserve(text_value)) {
+                            serializer.attribute(excel::openxml_ns::xml, "space", "preserve");
+                        }
+                        serializer.characters(text_value);
+                        serializer.end_element(); // t
+                        serializer.end_element(); // is
+                    } else {
+                        std::uint32_t index = shared_strings->add_string(text_value);
+                        ++shared_string_references;
+                        serializer.attribute("t", "s");
+                        serializer.element_with_namespace(excel::openxml_ns::main, "v", format_integer(index));
+                    }
+                    break;
+                }
+                case CellKind::SharedString:
+                    // 加载时的共享字符串索引原样写回，不再查找或哈希文本
+                    ++shared_string_references;
+                    serializer.element_with_namespace(excel::openxml_ns::main, "v", format_integer(value.id));
+                    break;
+                case CellKind::Number:
+                    // 最短往返表示：std::to_string 固定 6 位小数，会丢失精度
+                    serializer.element_with_namespace(excel::openxml_ns::main, "v",
+                        number_buffer.assign(utils::NumberCodec::format_number(value.number, digits)));
+                    break;
+                case CellKind::Integer:
+                    serializer.element_with_namespace(excel::openxml_ns::main, "v",
+                                                      format_integer(static_cast<int>(value.number)));
+                    break;
+                case CellKind::Boolean:
+                    serializer.element_with_namespace(excel::openxml_ns::main, "v", value.boolean ? "1" : "0");
+                    break;
+                case CellKind::Error:
+                    serializer.element_with_namespace(excel::openxml_ns::main, "v",
+                                                      std::string(cell_error_text(value.error)));
+                    break;
+                case CellKind::Empty:
+                case CellKind::Formula:
+                    break;
             }
 
+            serializer.end_element(); // c
+        });
+
+        if (current_row != 0) {
             serializer.end_element(); // row
         }
 
@@ -927,56 +1224,7 @@ std::string worksheet_impl::generate_worksheet_xml() {
     }
 
     serializer.end_element(); // worksheet
-
-    // 获取生成的XML内容
-    std::string xml_content = oss.str();
-
-
-
-    return xml_content;
-}
-
-bool worksheet_impl::should_use_inline_string(const std::string& str) const {
-    try {
-        // Excel的高效策略：简单规则，快速判断
-
-        // 1. 空字符串使用内联
-        if (str.empty()) {
-            return true;
-        }
-
-        // 2. 很短的字符串（≤3字符）使用内联
-        if (str.length() <= 3) {
-            return true;
-        }
-
-        // 3. 很长的字符串（>50字符）使用内联（避免共享字符串表过大）
-        if (str.length() > 50) {
-            return true;
-        }
-
-        // 4. 简化的数字检测：只检查前几个字符
-        std::size_t check_length = std::min(str.length(), static_cast<std::size_t>(10));
-        std::size_t digit_count = 0;
-
-        for (std::size_t i = 0; i < check_length; ++i) {
-            if (std::isdigit(static_cast<unsigned char>(str[i]))) {
-                digit_count++;
-            }
-        }
-
-        // 如果前面大部分是数字，使用内联
-        if (digit_count * 2 > check_length) {
-            return true;
-        }
-
-        // 5. 其他情况使用共享字符串（Excel的默认行为）
-        return false;
-
-    } catch (...) {
-        // 如果出现任何异常，默认使用内联字符串（更安全）
-        return true;
-    }
+    return shared_string_references;
 }
 
 // ========================================
@@ -1082,7 +1330,7 @@ std::string worksheet_impl::get_cell_text_for_condition(const core::Coordinate&
         if (std::holds_alternative<std::string>(cell_data.value)) {
             return std::get<std::string>(cell_data.value);
         } else if (std::holds_alternative<double>(cell_data.value)) {
-            return std::to_string(std::get<double>(cell_data.value));
+            return utils::NumberCodec::format_number(std::get<double>(cell_data.value));
         } else if (std::holds_alternative<int>(cell_data.value)) {
             return std::to_string(std::get<int>(cell_data.value));
         } else if (std::holds_alternative<bool>(cell_data.value)) {
@@ -0,0 +1,192 @@
+/**
+ * @file test_archive_source.cpp
+ * @brief 归档输入源（内存映射）与直接写入输出测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include "tinakit/core/io.hpp"
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+namespace {
+
+std::vector<std::byte> to_bytes(const std::string& text) {
+    std::vector<std::byte> bytes(text.size());
+    std::memcpy(bytes.data(), text.data(), text.size());
+    return bytes;
+}
+
+void write_sample_archive(const std::string& file_path) {
+    auto archiver = OpenXmlArchiver::create_in_memory_writer();
+    async::sync_wait(archiver.add_file("a.xml", to_bytes("<a/>")));
+    async::sync_wait(archiver.add_file("b.xml", to_bytes(std::string(100000, 'b'))));
+    async::sync_wait(archiver.save_to_file(file_path));
+}
+
+} // namespace
+
+TEST_CASE(ArchiveSource, MappedFileReadsEntries) {
+    const std::string file_path = "test_archive_source_read.zip";
+    write_sample_archive(file_path);
+
+    auto source = SourceBuffer::map_file(file_path);
+    ASSERT_TRUE(source->mapped());
+    ASSERT_EQ(static_cast<std::size_t>(std::filesystem::file_size(file_path)), source->size());
+    ASSERT_THROWS(SourceBuffer::map_file("missing_archive_source.zip"), IOException);
+
+    for (auto mode : {SourceMode::MemoryMap, SourceMode::Read}) {
+        auto archiver = async::sync_wait(OpenXmlArchiver::open_from_file(file_path, mode));
+        ASSERT_TRUE(to_bytes("<a/>") == async::sync_wait(archiver.read_file("a.xml")));
+
+        auto stream = async::sync_wait(archiver.open_entry_stream("b.xml"));
+        std::string text((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+        ASSERT_EQ(std::string(100000, 'b'), text);
+    }
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(ArchiveSource, SaveOverMappedFile) {
+    const std::string file_path = "test_archive_source_save.zip";
+    write_sample_archive(file_path);
+
+    auto archiver = async::sync_wait(OpenXmlArchiver::open_from_file(file_path));
+    // 条目流在保存之后仍然读取原来的映射
+    auto stream = async::sync_wait(archiver.open_entry_stream("b.xml"));
+    async::sync_wait(archiver.add_file("c.xml", to_bytes("<c/>")));
+    async::sync_wait(archiver.save_to_file(file_path));
+
+    std::string text((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(std::size_t{100000}, text.size());
+    ASSERT_TRUE(to_bytes("<c/>") == async::sync_wait(archiver.read_file("c.xml")));
+
+    // 未修改时原样写回
+    auto reopened = async::sync_wait(OpenXmlArchiver::open_from_file(file_path));
+    async::sync_wait(reopened.save_to_file(file_path));
+    auto check = async::sync_wait(OpenXmlArchiver::open_from_file(file_path, SourceMode::Read));
+    ASSERT_TRUE(to_bytes("<a/>") == async::sync_wait(check.read_file("a.xml")));
+    ASSERT_TRUE(to_bytes("<c/>") == async::sync_wait(check.read_file("c.xml")));
+    ASSERT_FALSE(std::filesystem::exists(file_path + ".tinakit-tmp"));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(ArchiveSource, EntryIndexLocatesEntries) {
+    auto writer = OpenXmlArchiver::create_in_memory_writer();
+    async::sync_wait(writer.add_file("a.xml", to_bytes("<a/>")));
+    async::sync_wait(writer.add_file("b.xml", to_bytes(std::string(100000, 'b'))));
+    async::sync_wait(writer.add_file("empty.xml", {}));
+    auto archiver = OpenXmlArchiver::open_from_memory(async::sync_wait(writer.save_to_memory()));
+
+    ASSERT_EQ(std::size_t{3}, archiver.entry_index().size());
+    const ArchiveEntry* entry = archiver.find_entry("b.xml");
+    ASSERT_TRUE(entry != nullptr);
+    ASSERT_EQ(std::uint64_t{100000}, entry->uncompressed_size);
+    ASSERT_TRUE(entry->compressed_size < entry->uncompressed_size);
+    ASSERT_TRUE(archiver.find_entry("missing.xml") == nullptr);
+
+    // 按索引定位读取，空条目也能读取
+    ASSERT_TRUE(async::sync_wait(archiver.read_file("empty.xml")).empty());
+    ASSERT_EQ(std::size_t{100000}, async::sync_wait(archiver.read_file("b.xml")).size());
+    ASSERT_TRUE(to_bytes("<a/>") == async::sync_wait(archiver.read_file("a.xml")));
+    ASSERT_THROWS(async::sync_wait(archiver.read_file("missing.xml")), TinaKitException);
+
+    async::sync_wait(archiver.remove_file("a.xml"));
+    ASSERT_TRUE(archiver.find_entry("a.xml") == nullptr);
+    ASSERT_FALSE(async::sync_wait(archiver.has_file("a.xml")));
+}
+
+TEST_CASE(ArchiveSource, EntryReaderPullsChunks) {
+    auto writer = OpenXmlArchiver::create_in_memory_writer();
+    async::sync_wait(writer.add_file("b.xml", to_bytes(std::string(100000, 'b'))));
+    auto archiver = OpenXmlArchiver::open_from_memory(async::sync_wait(writer.save_to_memory()));
+
+    auto reader = async::sync_wait(archiver.open_entry_reader("b.xml", 4096));
+    ASSERT_EQ(std::uint64_t{100000}, reader.size());
+    std::size_t total = 0;
+    for (auto chunk = reader.next_chunk(); !chunk.empty(); chunk = reader.next_chunk()) {
+        ASSERT_TRUE(chunk.size() <= 4096u);
+        ASSERT_TRUE(chunk.find_first_not_of('b') == std::string_view::npos);
+        total += chunk.size();
+    }
+    ASSERT_EQ(std::size_t{100000}, total);
+
+    // 尚未保存的条目也通过同一接口读取
+    async::sync_wait(archiver.add_file("pending.xml", to_bytes("<p/>")));
+    auto pending = async::sync_wait(archiver.open_entry_reader("pending.xml"));
+    ASSERT_EQ(std::string("<p/>"), std::string(pending.next_chunk()));
+    ASSERT_TRUE(pending.next_chunk().empty());
+    ASSERT_THROWS(async::sync_wait(archiver.open_entry_reader("missing.xml")), TinaKitException);
+}
+
+TEST_CASE(ArchiveSource, FileWriterWritesThrough) {
+    const std::string file_path = "test_archive_source_direct.zip";
+    std::filesystem::remove(file_path);
+    {
+        FileWritePolicy policy;
+        policy.preallocate = 1024 * 1024;
+        policy.sync = true;
+        auto archiver = OpenXmlArchiver::create_file_writer(file_path, policy);
+        ASSERT_TRUE(archiver.writes_through());
+        {
+            EntryOutputStream out(archiver, "streamed.xml");
+            out << std::string(50000, 's');
+        }
+        async::sync_wait(archiver.add_file("a.xml", to_bytes("<a/>")));
+        // 目标文件在保存完成前不会出现
+        ASSERT_FALSE(std::filesystem::exists(file_path));
+        ASSERT_THROWS(async::sync_wait(archiver.save_to_memory()), TinaKitException);
+        async::sync_wait(archiver.save_to_file(file_path));
+        ASSERT_FALSE(archiver.writes_through());
+        ASSERT_FALSE(std::filesystem::exists(file_path + ".tinakit-tmp"));
+        // 保存后从写入的文件继续读取
+        ASSERT_TRUE(to_bytes("<a/>") == async::sync_wait(archiver.read_file("a.xml")));
+    }
+
+    // 预分配的空间在提交时截去
+    auto source = SourceBuffer::map_file(file_path);
+    ASSERT_TRUE(source->size() < 1024u * 1024u);
+    ASSERT_EQ(std::uint64_t{source->size()}, std::filesystem::file_size(file_path));
+
+    // 读取已有归档后修改，写入直接落到原文件
+    {
+        auto archiver = async::sync_wait(OpenXmlArchiver::open_from_file(file_path));
+        ASSERT_TRUE(archiver.set_output_file(file_path));
+        async::sync_wait(archiver.add_file("b.xml", to_bytes("<b/>")));
+        async::sync_wait(archiver.save_to_file(file_path));
+    }
+    auto reader = async::sync_wait(OpenXmlArchiver::open_from_file(file_path, SourceMode::Read));
+    ASSERT_EQ(std::size_t{3}, reader.entry_index().size());
+    ASSERT_EQ(std::size_t{50000}, async::sync_wait(reader.read_file("streamed.xml")).size());
+    ASSERT_TRUE(to_bytes("<b/>") == async::sync_wait(reader.read_file("b.xml")));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(ArchiveSource, StreamWriterFinishesArchive) {
+    std::stringstream stream;
+    stream << "prefix";
+    auto archiver = OpenXmlArchiver::create_stream_writer(stream);
+    async::sync_wait(archiver.add_file("a.xml", to_bytes("<a/>")));
+    {
+        EntryOutputStream out(archiver, "b.xml");
+        out << std::string(10000, 'b');
+    }
+    async::sync_wait(archiver.finish());
+
+    // 归档从流的起始位置开始写入
+    const std::string content = stream.str();
+    ASSERT_EQ(std::string("prefix"), content.substr(0, 6));
+    auto reader = OpenXmlArchiver::open_from_memory(to_bytes(content.substr(6)));
+    ASSERT_TRUE(to_bytes("<a/>") == async::sync_wait(reader.read_file("a.xml")));
+    ASSERT_EQ(std::size_t{10000}, async::sync_wait(reader.read_file("b.xml")).size());
+}
@@ -0,0 +1,275 @@
+/**
+ * @file test_cell_store.cpp
+ * @brief 行块列式单元格存储测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/excel/shared_strings.hpp"
+#include "tinakit/internal/cell_store.hpp"
+#include "tinakit/internal/worksheet_impl.hpp"
+#include <filesystem>
+#include <limits>
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::internal;
+using namespace tinakit::test;
+
+TEST_CASE(CellStore, SetGetAllValueTypes) {
+    StringPool pool;
+    CellStore store(pool);
+
+    store.set(Coordinate(1, 1), cell_data(std::string("文本")));
+    store.set(Coordinate(1, 2), cell_data(3.25));
+    store.set(Coordinate(1, 3), cell_data(42));
+    store.set(Coordinate(1, 4), cell_data(true));
+
+    cell_data with_formula(10);
+    with_formula.formula = "SUM(A1:A2)";
+    with_formula.style_id = 7;
+    store.set(Coordinate(2, 1), with_formula);
+
+    ASSERT_EQ(5u, store.size());
+    ASSERT_EQ(std::string("文本"), std::get<std::string>(store.get(Coordinate(1, 1))->value));
+    ASSERT_EQ(3.25, std::get<double>(store.get(Coordinate(1, 2))->value));
+    ASSERT_EQ(42, std::get<int>(store.get(Coordinate(1, 3))->value));
+    ASSERT_TRUE(std::get<bool>(store.get(Coordinate(1, 4))->value));
+
+    auto loaded = store.get(Coordinate(2, 1));
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(std::string("SUM(A1:A2)"), *loaded->formula);
+    ASSERT_EQ(7u, loaded->style_id);
+
+    ASSERT_FALSE(store.get(Coordinate(3, 3)).has_value());
+    ASSERT_FALSE(store.contains(Coordinate(1, 5)));
+}
+
+TEST_CASE(CellStore, OverwriteAndErase) {
+    StringPool pool;
+    CellStore store(pool);
+
+    store.set(Coordinate(300, 2), cell_data(std::string("old")));
+    store.set(Coordinate(300, 2), cell_data(1.5));
+    ASSERT_EQ(1u, store.size());
+    ASSERT_EQ(1.5, std::get<double>(store.get(Coordinate(300, 2))->value));
+
+    // 样式单独存在时单元格仍然保留
+    cell_data styled;
+    styled.style_id = 3;
+    store.set(Coordinate(300, 3), styled);
+    ASSERT_TRUE(store.contains(Coordinate(300, 3)));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(store.get(Coordinate(300, 3))->value));
+
+    ASSERT_TRUE(store.erase(Coordinate(300, 2)));
+    ASSERT_FALSE(store.erase(Coordinate(300, 2)));
+    ASSERT_TRUE(store.erase(Coordinate(300, 3)));
+    ASSERT_TRUE(store.empty());
+    ASSERT_FALSE(store.bounds().has_value());
+}
+
+TEST_CASE(CellStore, RowMajorIterationAcrossBlocks) {
+    StringPool pool;
+    CellStore store(pool);
+
+    // 跨越多个行块，乱序写入
+    store.set(Coordinate(1000, 1), cell_data(3));
+    store.set(Coordinate(1, 5), cell_data(2));
+    store.set(Coordinate(1, 2), cell_data(1));
+    store.set(Coordinate(600, 3), cell_data(std::string("x")));
+
+    std::vector<Coordinate> visited;
+    store.for_each([&visited](const Coordinate& pos, const CellView&) {
+        visited.push_back(pos);
+    });
+
+    ASSERT_EQ(4u, visited.size());
+    ASSERT_EQ(Coordinate(1, 2), visited[0]);
+    ASSERT_EQ(Coordinate(1, 5), visited[1]);
+    ASSERT_EQ(Coordinate(600, 3), visited[2]);
+    ASSERT_EQ(Coordinate(1000, 1), visited[3]);
+
+    auto bounds = store.bounds();
+    ASSERT_TRUE(bounds.has_value());
+    ASSERT_EQ(Coordinate(1, 1), bounds->start);
+    ASSERT_EQ(Coordinate(1000, 5), bounds->end);
+
+    std::size_t in_range = 0;
+    store.for_each_in_range(range_address(Coordinate(1, 3), Coordinate(700, 5)),
+        [&in_range](const Coordinate&, const CellView&) { ++in_range; });
+    ASSERT_EQ(2u, in_range);
+}
+
+TEST_CASE(CellStore, InsertAndDeleteRowsColumns) {
+    StringPool pool;
+    CellStore store(pool);
+
+    store.set(Coordinate(1, 1), cell_data(1));
+    store.set(Coordinate(2, 2), cell_data(2));
+    store.set(Coordinate(3, 3), cell_data(3));
+
+    store.insert_rows(2, 300);
+    ASSERT_TRUE(store.contains(Coordinate(1, 1)));
+    ASSERT_TRUE(store.contains(Coordinate(302, 2)));
+    ASSERT_TRUE(store.contains(Coordinate(303, 3)));
+
+    store.delete_rows(2, 300);
+    ASSERT_EQ(2, std::get<int>(store.get(Coordinate(2, 2))->value));
+
+    store.insert_columns(2, 2);
+    ASSERT_TRUE(store.contains(Coordinate(2, 4)));
+    ASSERT_TRUE(store.contains(Coordinate(3, 5)));
+
+    store.delete_columns(4, 1);
+    ASSERT_EQ(2u, store.size());
+    ASSERT_EQ(3, std::get<int>(store.get(Coordinate(3, 4))->value));
+}
+
+TEST_CASE(CellStore, RejectsCellsBeyondExcelLimits) {
+    StringPool pool;
+    CellStore store(pool);
+
+    // XFD1048576 是最后一个合法单元格
+    store.set(Coordinate(1048576, 16384), cell_data(1));
+    ASSERT_THROWS(store.set(Coordinate(1048577, 1), cell_data(2)), InvalidCellAddressException);
+    ASSERT_THROWS(store.set(Coordinate(1, 16385), cell_data(3)), InvalidCellAddressException);
+    ASSERT_EQ(1u, store.size());
+
+    // 插入行列不能把已有单元格移出上限，失败时不做修改；插入点在所有单元格之后时不受影响
+    store.erase(Coordinate(1048576, 16384));
+    store.set(Coordinate(1048000, 16000), cell_data(4));
+    ASSERT_THROWS(store.insert_rows(1, 1000), InvalidCellAddressException);
+    ASSERT_THROWS(store.insert_columns(1, 1000), InvalidCellAddressException);
+    ASSERT_THROWS(store.insert_rows(1, std::numeric_limits<std::size_t>::max()), InvalidCellAddressException);
+    ASSERT_EQ(4, std::get<int>(store.get(Coordinate(1048000, 16000))->value));
+    store.insert_rows(1048001, 1000);
+    store.insert_columns(2, 384);
+    ASSERT_EQ(4, std::get<int>(store.get(Coordinate(1048000, 16384))->value));
+
+    // 工作表写入同样拒绝，不会保存出无法加载的单元格
+    auto workbook = excel::Workbook::create();
+    auto sheet = workbook.active_sheet();
+    ASSERT_THROWS(sheet.cell(2000000, 1).value(42), InvalidCellAddressException);
+    ASSERT_THROWS(sheet.cell(1, 20000).value(42), InvalidCellAddressException);
+}
+
+TEST_CASE(CellStore, WorkbookRoundTrip) {
+    const std::string file_path = "test_cell_store_roundtrip.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (int row = 1; row <= 600; ++row) {
+            sheet.cell(row, 1).value(row);
+            sheet.cell(row, 2).value("Row " + std::to_string(row));
+        }
+        sheet.cell(2, 3).value(true);
+        workbook.save(file_path);
+    }
+
+    auto loaded = excel::Workbook::load(file_path);
+    auto sheet = loaded.active_sheet();
+    ASSERT_EQ(600, sheet.cell(600, 1).as<int>());
+    ASSERT_EQ(std::string("Row 257"), sheet.cell(257, 2).as<std::string>());
+    ASSERT_TRUE(sheet.cell(2, 3).as<bool>());
+    ASSERT_EQ(600u, sheet.max_row());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(CellStore, CompactCellsShareFormulaArena) {
+    static_assert(sizeof(CompactCell) == 16);
+
+    StringPool pool;
+    FormulaArena formulas;
+    CellStore store(pool, &formulas);
+
+    cell_data summed(10);
+    summed.formula = "SUM(A1:A2)";
+    summed.style_id = 4;
+    store.set(Coordinate(1, 1), summed);
+    store.set(Coordinate(2, 1), summed);
+    ASSERT_EQ(2u, formulas.size());
+
+    auto compact = store.cell(Coordinate(1, 1));
+    ASSERT_TRUE(compact->has_formula());
+    ASSERT_EQ(4u, compact->style_id);
+    auto view = store.resolve(*compact);
+    ASSERT_TRUE(view.kind == CellKind::Integer);
+    ASSERT_EQ(10.0, view.number);
+    ASSERT_EQ(std::string("SUM(A1:A2)"), std::string(*view.formula));
+
+    // 覆盖、删除行和清空都会归还公式表项，空闲表项会被复用
+    store.set(Coordinate(1, 1), cell_data(1.5));
+    ASSERT_EQ(1u, formulas.size());
+    store.set(Coordinate(3, 1), summed);
+    store.delete_rows(2, 1);
+    ASSERT_EQ(1u, formulas.size());
+    ASSERT_TRUE(store.cell(Coordinate(2, 1))->has_formula());
+    store.clear();
+    ASSERT_EQ(0u, formulas.size());
+
+    // 错误值以错误码保存，转换为 cell_data 时得到其文本
+    CellView error_view;
+    worksheet_impl::convert_cell_value("e", "#DIV/0!", nullptr, error_view);
+    ASSERT_TRUE(error_view.kind == CellKind::Error);
+    store.set(Coordinate(5, 5), error_view);
+    ASSERT_TRUE(store.cell(Coordinate(5, 5))->payload.error == CellError::Div0);
+    ASSERT_EQ(std::string("#DIV/0!"), std::get<std::string>(store.get(Coordinate(5, 5))->value));
+}
+
+TEST_CASE(CellStore, FormulaResultsRoundTrip) {
+    const std::string file_path = "test_cell_store_formula.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value("abc").formula("LOWER(\"ABC\")");
+        sheet.cell(2, 1).value(7).formula("3+4");
+        workbook.save(file_path);
+    }
+
+    auto loaded = excel::Workbook::load(file_path);
+    auto sheet = loaded.active_sheet();
+    ASSERT_EQ(std::string("abc"), sheet.cell(1, 1).as<std::string>());
+    ASSERT_EQ(std::string("LOWER(\"ABC\")"), *sheet.cell(1, 1).formula());
+    ASSERT_EQ(7, sheet.cell(2, 1).as<int>());
+    ASSERT_EQ(std::string("3+4"), *sheet.cell(2, 1).formula());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(CellStore, SharedStringCellsKeepIndex) {
+    excel::SharedStrings shared_strings;
+    shared_strings.load_from_xml(
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<si><t>Pending</t></si><si><t>Completed</t></si></sst>");
+    StringPool pool;
+    CellStore store(pool, nullptr, &shared_strings);
+
+    // 共享字符串单元格只保存索引，不驻留到字符串池
+    for (std::size_t row = 1; row <= 300; ++row) {
+        CellView view;
+        worksheet_impl::convert_cell_value("s", "1", &shared_strings, view);
+        store.set(Coordinate(row, 1), view);
+    }
+    ASSERT_EQ(0u, pool.size());
+    auto compact = store.cell(Coordinate(300, 1));
+    ASSERT_TRUE(compact->kind == CellKind::SharedString);
+    ASSERT_EQ(1u, compact->payload.id);
+
+    // 解析时才取出文本，视图中是普通字符串并带有索引
+    auto view = store.resolve(*compact);
+    ASSERT_TRUE(view.kind == CellKind::String);
+    ASSERT_EQ(std::string("Completed"), std::string(view.text));
+    ASSERT_EQ(1u, *view.shared_index);
+    ASSERT_EQ(std::string("Completed"), std::get<std::string>(store.get(Coordinate(1, 1))->value));
+
+    // 带公式的缓存结果仍驻留到字符串池
+    CellView with_formula;
+    with_formula.formula = "A1";
+    worksheet_impl::convert_cell_value("s", "0", &shared_strings, with_formula);
+    store.set(Coordinate(1, 2), with_formula);
+    ASSERT_TRUE(store.cell(Coordinate(1, 2))->has_formula());
+    ASSERT_EQ(std::string("Pending"), std::string(store.view(Coordinate(1, 2))->text));
+}
@@ -82,9 +82,18 @@ TEST_CASE(CoordinateUtils, CoordinateToString) {
     ASSERT_EQ("AA100", CoordinateUtils::coordinate_to_string(coord3));
 }
 
+TEST_CASE(CoordinateUtils, FormatCoordinate) {
+    CoordinateUtils::CoordinateBuffer buffer;
+    ASSERT_EQ(std::string("A1"), std::string(CoordinateUtils::format_coordinate(1, 1, buffer)));
+    ASSERT_EQ(std::string("AZ52"), std::string(CoordinateUtils::format_coordinate(52, 52, buffer)));
+    ASSERT_EQ(std::string("XFD1048576"), std::string(CoordinateUtils::format_coordinate(1048576, 16384, buffer)));
+}
+
 TEST_CASE(CoordinateUtils, InvalidStringThrowsException) {
     ASSERT_THROWS(CoordinateUtils::string_to_coordinate(""), InvalidCellAddressException);
     ASSERT_THROWS(CoordinateUtils::string_to_coordinate("A"), InvalidCellAddressException);
+    ASSERT_THROWS(CoordinateUtils::string_to_coordinate("A1048577"), InvalidCellAddressException);
+    ASSERT_THROWS(CoordinateUtils::string_to_coordinate("XFE1"), InvalidCellAddressException);
     ASSERT_THROWS(CoordinateUtils::string_to_coordinate("1"), InvalidCellAddressException);
     ASSERT_THROWS(CoordinateUtils::string_to_coordinate("A0"), InvalidCellAddressException);
 }
@@ -0,0 +1,170 @@
+/**
+ * @file test_io_backend.cpp
+ * @brief 异步文件 I/O 后端测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/core/io.hpp"
+#include "tinakit/core/io_backend.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+namespace {
+
+std::vector<std::byte> make_pattern(std::size_t size) {
+    std::vector<std::byte> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<std::byte>((i * 131) >> 3);
+    }
+    return data;
+}
+
+async::Task<std::int64_t> read_through(IoBackend& backend, NativeFile file, std::span<std::byte> buffer,
+                                       std::uint64_t offset) {
+    IoRequest request;
+    request.file = file;
+    request.data = buffer.data();
+    request.size = buffer.size();
+    request.offset = offset;
+    co_return co_await submit_io(backend, request);
+}
+
+} // namespace
+
+TEST_CASE(IoBackend, WholeFileRoundTrip) {
+    const std::string file_path = "test_io_backend_whole.bin";
+    // 超过一个请求块，多个请求同时在途
+    const auto data = make_pattern(9 * 1024 * 1024 + 7);
+    async::sync_wait(write_file_binary(file_path, data));
+    ASSERT_EQ(std::uintmax_t{data.size()}, std::filesystem::file_size(file_path));
+    ASSERT_TRUE(data == async::sync_wait(read_file_binary(file_path)));
+
+    async::sync_wait(write_file_binary(file_path, {}));
+    ASSERT_TRUE(async::sync_wait(read_file_binary(file_path)).empty());
+    ASSERT_THROWS(async::sync_wait(read_file_binary("test_io_backend_missing.bin")), IOException);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(IoBackend, EachBackendReadsAtOffset) {
+    const std::string file_path = "test_io_backend_offset.bin";
+    const auto data = make_pattern(10000);
+    async::sync_wait(write_file_binary(file_path, data));
+
+    std::vector<std::unique_ptr<IoBackend>> backends;
+    backends.push_back(IoBackend::create(IoBackendKind::ThreadPool));
+    try {
+        backends.push_back(IoBackend::create(IoBackendKind::IoUring));
+    } catch (const IOException&) {
+        // 未编译 io_uring 支持或内核不允许时只测试线程后端
+    }
+
+#ifdef _WIN32
+    const NativeFile file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+    const NativeFile file = ::open(file_path.c_str(), O_RDONLY);
+#endif
+    for (auto& backend : backends) {
+        std::vector<std::byte> buffer(100);
+        ASSERT_EQ(std::int64_t{100}, async::sync_wait(read_through(*backend, file, buffer, 5000)));
+        ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + 5000));
+        // 文件末尾返回实际读取的字节数
+        ASSERT_EQ(std::int64_t{40}, async::sync_wait(read_through(*backend, file, buffer, 9960)));
+    }
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    ::close(file);
+#endif
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(IoBackend, OutputFileBackfillsWrittenRegions) {
+    const std::string file_path = "test_io_backend_output.bin";
+    auto expected = make_pattern(3 * 1024 * 1024);
+    {
+        OutputFile file(file_path);
+        file.write(expected);
+        // 回填已在后台写出的区域和仍在缓冲区中的区域
+        const std::vector<std::byte> patch(16, std::byte{0xAB});
+        for (std::uint64_t offset : {std::uint64_t{10}, std::uint64_t{3 * 1024 * 1024 - 100}}) {
+            file.seek(offset);
+            file.write(patch);
+            std::copy(patch.begin(), patch.end(), expected.begin() + static_cast<std::ptrdiff_t>(offset));
+        }
+        file.seek(file.size());
+        file.write(patch);
+        expected.insert(expected.end(), patch.begin(), patch.end());
+        file.commit();
+    }
+    ASSERT_TRUE(expected == async::sync_wait(read_file_binary(file_path)));
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(IoBackend, WorkbookAsyncRoundTrip) {
+    const std::string file_path = "test_io_backend_workbook.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (std::size_t row = 1; row <= 200; ++row) {
+            sheet.cell(row, 1).value(static_cast<int>(row));
+        }
+        async::sync_wait(workbook.save_async(file_path));
+    }
+
+    auto workbook = async::sync_wait(excel::Workbook::load_async(file_path));
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(200u, sheet.max_row());
+    ASSERT_EQ(150, sheet.cell(150, 1).as<int>());
+    ASSERT_THROWS(async::sync_wait(excel::Workbook::load_async("test_io_backend_missing.xlsx")), IOException);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(IoBackend, ConcurrentSaveAsyncDoesNotDeadlock) {
+    // 含流式工作表的工作簿在内存中组装后通过 I/O 后端写出；同时进行的保存数多于
+    // I/O 执行器的线程数时，阻塞的保存不能占满完成回调所需的线程
+    constexpr int SAVES = 12;
+    std::vector<std::thread> savers;
+    for (int i = 0; i < SAVES; ++i) {
+        savers.emplace_back([i] {
+            auto workbook = excel::Workbook::create();
+            auto writer = workbook.create_streaming_worksheet("Report");
+            for (int row = 1; row <= 200; ++row) {
+                writer.append_row({row, i});
+            }
+            writer.close();
+            async::sync_wait(workbook.save_async("test_io_backend_concurrent_" + std::to_string(i) + ".xlsx"));
+        });
+    }
+    for (auto& saver : savers) {
+        saver.join();
+    }
+
+    for (int i = 0; i < SAVES; ++i) {
+        const std::string file_path = "test_io_backend_concurrent_" + std::to_string(i) + ".xlsx";
+        auto workbook = excel::Workbook::load(file_path);
+        ASSERT_EQ(i, workbook.get_worksheet("Report").cell(200, 2).as<int>());
+        std::filesystem::remove(file_path);
+    }
+}
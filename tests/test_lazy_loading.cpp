@@ -0,0 +1,160 @@
+/**
+ * @file test_lazy_loading.cpp
+ * @brief 窗口化惰性加载测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/worksheet_impl.hpp"
+#include "tinakit/internal/sheet_row_index.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::internal;
+using namespace tinakit::test;
+
+namespace {
+
+void create_large_workbook(const std::string& file_path, int rows) {
+    auto workbook = excel::Workbook::create();
+    auto sheet = workbook.active_sheet();
+    for (int row = 1; row <= rows; ++row) {
+        sheet.cell(row, 1).value(row);
+        sheet.cell(row, 2).value("Item " + std::to_string(row));
+    }
+    auto second = workbook.create_worksheet("Summary");
+    second.cell(1, 1).value("Total");
+    second.cell(1, 2).value(rows);
+    workbook.save(file_path);
+}
+
+} // namespace
+
+TEST_CASE(LazyLoading, RowIndexSpansAlignWithBlocks) {
+    const std::string xml =
+        "<?xml version=\"1.0\"?>"
+        "<x:worksheet xmlns:x=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<x:sheetData>"
+        "<x:row r=\"1\"><x:c r=\"A1\"><x:v>1</x:v></x:c></x:row>"
+        "<x:row r=\"255\"/>"
+        "<x:row r=\"256\"><x:c r=\"A256\"><x:v>2</x:v></x:c></x:row>"
+        "<x:row><x:c r=\"A257\"><x:v>3</x:v></x:c></x:row>"
+        "<x:row r=\"1000\" spans=\"1:1\"/>"
+        "</x:sheetData>"
+        "</x:worksheet>";
+
+    auto index = SheetRowIndex::build(xml, CellStore::BLOCK_SHIFT);
+    ASSERT_TRUE(index.has_value());
+    ASSERT_EQ(3u, index->spans().size());
+    ASSERT_EQ(0u, index->spans()[0].block);
+    ASSERT_EQ(255u, index->spans()[0].last_row);
+    ASSERT_EQ(1u, index->spans()[1].block);
+    ASSERT_EQ(257u, index->spans()[1].last_row);
+    ASSERT_EQ(3u, index->spans()[2].block);
+    ASSERT_EQ(std::string("x:worksheet"), std::string(index->root_name(xml)));
+
+    // 片段不应包含 sheetData 的结束标签
+    const auto& last = index->spans()[2];
+    ASSERT_EQ(std::string::npos, xml.substr(last.begin, last.end - last.begin).find("sheetData"));
+}
+
+TEST_CASE(LazyLoading, RowIndexRejectsUnorderedRows) {
+    const std::string xml =
+        "<worksheet><sheetData>"
+        "<row r=\"10\"/><row r=\"2\"/>"
+        "</sheetData></worksheet>";
+    ASSERT_FALSE(SheetRowIndex::build(xml, CellStore::BLOCK_SHIFT).has_value());
+
+    // 超出 Excel 行数上限的行号（包括会溢出的）视为格式错误
+    const std::string too_large =
+        "<worksheet><sheetData><row r=\"1048577\"/></sheetData></worksheet>";
+    ASSERT_FALSE(SheetRowIndex::build(too_large, CellStore::BLOCK_SHIFT).has_value());
+    const std::string overflow =
+        "<worksheet><sheetData><row r=\"99999999999999999999999\"/></sheetData></worksheet>";
+    ASSERT_FALSE(SheetRowIndex::build(overflow, CellStore::BLOCK_SHIFT).has_value());
+
+    const std::string empty = "<worksheet><sheetData/></worksheet>";
+    auto index = SheetRowIndex::build(empty, CellStore::BLOCK_SHIFT);
+    ASSERT_TRUE(index.has_value());
+    ASSERT_TRUE(index->spans().empty());
+}
+
+TEST_CASE(LazyLoading, ReadingOneCellLoadsOnlyItsBlock) {
+    const std::string file_path = "test_lazy_loading_partial.xlsx";
+    create_large_workbook(file_path, 2000);
+
+    auto impl = std::make_shared<workbook_impl>(file_path);
+    ASSERT_TRUE(impl->worksheet_load_state("Sheet1") == LoadState::NotLoaded);
+
+    auto first = impl->get_cell_data("Sheet1", Coordinate(1, 2));
+    ASSERT_EQ(std::string("Item 1"), std::get<std::string>(first.value));
+    ASSERT_TRUE(impl->worksheet_load_state("Sheet1") == LoadState::PartialLoaded);
+
+    auto far = impl->get_cell_data("Sheet1", Coordinate(1800, 1));
+    ASSERT_EQ(1800, std::get<int>(far.value));
+    ASSERT_TRUE(impl->worksheet_load_state("Sheet1") == LoadState::PartialLoaded);
+
+    // 结构性操作需要完整数据
+    impl->ensure_worksheet_loaded("Sheet1");
+    ASSERT_TRUE(impl->worksheet_load_state("Sheet1") == LoadState::FullyLoaded);
+    ASSERT_EQ(2000u, impl->get_worksheet_impl_public("Sheet1").max_row());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(LazyLoading, SaveAfterPartialLoadKeepsAllData) {
+    const std::string file_path = "test_lazy_loading_save.xlsx";
+    const std::string output_path = "test_lazy_loading_save_out.xlsx";
+    create_large_workbook(file_path, 1000);
+
+    {
+        auto workbook = excel::Workbook::load(file_path);
+        auto sheet = workbook.get_worksheet("Sheet1");
+        sheet.cell(3, 3).value("edited");
+        workbook.save(output_path);
+    }
+
+    auto reloaded = excel::Workbook::load(output_path);
+    auto sheet = reloaded.get_worksheet("Sheet1");
+    ASSERT_EQ(std::string("edited"), sheet.cell(3, 3).as<std::string>());
+    ASSERT_EQ(999, sheet.cell(999, 1).as<int>());
+    ASSERT_EQ(std::string("Item 700"), sheet.cell(700, 2).as<std::string>());
+
+    // 未访问过的工作表也要完整保留
+    auto summary = reloaded.get_worksheet("Summary");
+    ASSERT_EQ(std::string("Total"), summary.cell(1, 1).as<std::string>());
+    ASSERT_EQ(1000, summary.cell(1, 2).as<int>());
+
+    std::filesystem::remove(file_path);
+    std::filesystem::remove(output_path);
+}
+
+TEST_CASE(LazyLoading, SaveCopiesUnchangedSheetParts) {
+    const std::string file_path = "test_lazy_loading_copy.xlsx";
+    const std::string output_path = "test_lazy_loading_copy_out.xlsx";
+    create_large_workbook(file_path, 1000);
+
+    auto impl = std::make_shared<workbook_impl>(file_path);
+    impl->set_cell_value("Summary", Coordinate(2, 1), std::string("edited"));
+    impl->save(std::filesystem::path(output_path));
+
+    // 未修改的工作表既不加载也不重新生成，部件内容与原文件一致
+    ASSERT_TRUE(impl->worksheet_load_state("Sheet1") == LoadState::NotLoaded);
+    auto original = async::sync_wait(OpenXmlArchiver::open_from_file(file_path));
+    auto saved = async::sync_wait(OpenXmlArchiver::open_from_file(output_path));
+    ASSERT_TRUE(async::sync_wait(original.read_file("xl/worksheets/sheet1.xml")) ==
+                async::sync_wait(saved.read_file("xl/worksheets/sheet1.xml")));
+    ASSERT_FALSE(async::sync_wait(original.read_file("xl/worksheets/sheet2.xml")) ==
+                 async::sync_wait(saved.read_file("xl/worksheets/sheet2.xml")));
+
+    auto reloaded = excel::Workbook::load(output_path);
+    ASSERT_EQ(std::string("Item 700"), reloaded.get_worksheet("Sheet1").cell(700, 2).as<std::string>());
+    ASSERT_EQ(std::string("edited"), reloaded.get_worksheet("Summary").cell(2, 1).as<std::string>());
+
+    std::filesystem::remove(file_path);
+    std::filesystem::remove(output_path);
+}
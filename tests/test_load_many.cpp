@@ -0,0 +1,103 @@
+/**
+ * @file test_load_many.cpp
+ * @brief 批量并发加载工作簿测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include <algorithm>
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::excel;
+using namespace tinakit::test;
+
+namespace {
+
+std::vector<std::filesystem::path> make_workbooks(const std::string& prefix, std::size_t count) {
+    std::vector<std::filesystem::path> paths;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto workbook = Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (std::size_t row = 1; row <= 200; ++row) {
+            sheet.cell(row, 1).value(static_cast<int>(i * 1000 + row));
+        }
+        paths.emplace_back(prefix + std::to_string(i) + ".xlsx");
+        workbook.save(paths.back());
+    }
+    return paths;
+}
+
+void remove_files(const std::vector<std::filesystem::path>& paths) {
+    for (const auto& path : paths) {
+        std::filesystem::remove(path);
+    }
+}
+
+} // namespace
+
+TEST_CASE(LoadMany, ReturnsEveryFileAndRecordsErrors) {
+    auto paths = make_workbooks("test_load_many_", 6);
+    paths.insert(paths.begin() + 2, "test_load_many_missing.xlsx");
+
+    LoadManyOptions options;
+    options.config.thread_pool_size = 3;
+    options.max_open_archives = 2;
+    auto results = Workbook::load_many(paths, options);
+    ASSERT_EQ(paths.size(), results.size());
+
+    std::vector<bool> seen(paths.size(), false);
+    std::size_t failures = 0;
+    while (auto result = results.next()) {
+        ASSERT_FALSE(seen[result->index]);
+        seen[result->index] = true;
+        ASSERT_TRUE(result->path == paths[result->index]);
+        if (result->index == 2) {
+            ASSERT_FALSE(result->ok());
+            ASSERT_THROWS(result->value(), std::exception);
+            ++failures;
+            continue;
+        }
+        const int file = static_cast<int>(result->index < 2 ? result->index : result->index - 1);
+        auto sheet = result->value().active_sheet();
+        ASSERT_EQ(200u, sheet.max_row());
+        ASSERT_EQ(file * 1000 + 150, sheet.cell(150, 1).as<int>());
+    }
+    ASSERT_EQ(1u, failures);
+    ASSERT_TRUE(std::find(seen.begin(), seen.end(), false) == seen.end());
+    ASSERT_FALSE(results.next().has_value());
+
+    paths.erase(paths.begin() + 2);
+    remove_files(paths);
+}
+
+TEST_CASE(LoadMany, PreservesOrderWhenCallerKeepsWorkbooks) {
+    const auto paths = make_workbooks("test_load_many_order_", 5);
+
+    // 预算小于任何一个文件：调用方保留所有工作簿时，流仍然逐个放行而不会停滞
+    LoadManyOptions options;
+    options.config.thread_pool_size = 4;
+    options.config.max_memory_usage = 1;
+    options.preserve_order = true;
+    std::vector<Workbook> kept;
+    {
+        auto results = Workbook::load_many(paths, options);
+        while (auto result = results.next()) {
+            ASSERT_EQ(kept.size(), result->index);
+            kept.push_back(result->value());
+        }
+    }
+    ASSERT_EQ(paths.size(), kept.size());
+    ASSERT_EQ(4001, kept[4].active_sheet().cell(1, 1).as<int>());
+
+    // 提前销毁结果流时跳过未开始的文件
+    {
+        auto results = Workbook::load_many(paths, options);
+        ASSERT_TRUE(results.next().has_value());
+    }
+
+    kept.clear();
+    remove_files(paths);
+}
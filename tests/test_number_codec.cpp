@@ -0,0 +1,95 @@
+/**
+ * @file test_number_codec.cpp
+ * @brief 数字编解码测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/number_codec.hpp"
+#include <filesystem>
+#include <limits>
+
+using namespace tinakit;
+using namespace tinakit::excel;
+using namespace tinakit::internal::utils;
+using namespace tinakit::test;
+
+TEST_CASE(NumberCodec, FormatAndParse) {
+    NumberCodec::NumberBuffer buffer;
+    ASSERT_EQ(std::string("1"), std::string(NumberCodec::format_number(1.0, buffer)));
+    ASSERT_EQ(std::string("0.1"), std::string(NumberCodec::format_number(0.1, buffer)));
+    ASSERT_EQ(std::string("1e+21"), std::string(NumberCodec::format_number(1e21, buffer)));
+    ASSERT_EQ(std::string("-42"), std::string(NumberCodec::format_integer(-42, buffer)));
+
+    ASSERT_EQ(123, NumberCodec::parse_integer("123").value());
+    ASSERT_FALSE(NumberCodec::parse_integer("1e5").has_value());
+    ASSERT_FALSE(NumberCodec::parse_integer("3000000000").has_value());
+    ASSERT_FALSE(NumberCodec::parse_integer("").has_value());
+    ASSERT_EQ(100000.0, NumberCodec::parse_number("1e5").value());
+    ASSERT_EQ(3000000000.0, NumberCodec::parse_number("3000000000").value());
+    ASSERT_FALSE(NumberCodec::parse_number("12abc").has_value());
+    for (const char* text : {"inf", "-inf", "infinity", "nan", "NaN", "1e999"}) {
+        ASSERT_FALSE(NumberCodec::parse_number(text).has_value());
+    }
+
+    // 最短表示能精确还原原值
+    for (double value : {0.1 + 0.2, 1.0 / 3.0, 123456789.123456789, -2.5e-300}) {
+        ASSERT_EQ(value, NumberCodec::parse_number(NumberCodec::format_number(value, buffer)).value());
+    }
+}
+
+TEST_CASE(NumberCodec, NumbersSurviveSaveAndLoad) {
+    const std::string path = "test_number_codec_roundtrip.xlsx";
+    {
+        auto workbook = Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value(1.0 / 3.0);
+        sheet.cell(2, 1).value(1e-7);
+        sheet.cell(3, 1).value(std::string("1e5"));
+        sheet.cell(1, 30).value(7);
+        workbook.save(path);
+    }
+
+    auto workbook = Workbook::load(path);
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(1.0 / 3.0, sheet.cell(1, 1).as<double>());
+    ASSERT_EQ(1e-7, sheet.cell(2, 1).as<double>());
+    ASSERT_EQ(100000, sheet.cell(3, 1).as<int>());
+    ASSERT_EQ(7, sheet.cell("AD1").as<int>());
+    ASSERT_EQ(std::string("0.3333333333333333"), sheet.cell(1, 1).as<std::string>());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(NumberCodec, NonFiniteNumbersBecomeNumErrors) {
+    const std::string path = "test_number_codec_non_finite.xlsx";
+    {
+        auto workbook = Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value(std::numeric_limits<double>::quiet_NaN());
+        sheet.cell(2, 1).value(std::numeric_limits<double>::infinity());
+        sheet.cell(3, 1).value(-std::numeric_limits<double>::infinity());
+        sheet.cell(4, 1).value(std::string("inf"));
+
+        // 流式写入器同样写为错误值
+        auto writer = workbook.create_streaming_worksheet("Stream");
+        writer.append_row({std::numeric_limits<double>::quiet_NaN(), 1.5});
+        writer.close();
+        workbook.save(path);
+    }
+
+    auto workbook = Workbook::load(path);
+    auto sheet = workbook.active_sheet();
+    for (std::size_t row = 1; row <= 3; ++row) {
+        ASSERT_EQ(std::string("#NUM!"), sheet.cell(row, 1).as<std::string>());
+    }
+    // 文本 "inf" 仍是字符串，不会被当作数字
+    ASSERT_EQ(std::string("inf"), sheet.cell(4, 1).as<std::string>());
+    auto stream = workbook.get_worksheet("Stream");
+    ASSERT_EQ(std::string("#NUM!"), stream.cell(1, 1).as<std::string>());
+    ASSERT_EQ(1.5, stream.cell(1, 2).as<double>());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_parallel_deflate.cpp
+ * @brief 并行压缩保存测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+namespace {
+
+std::vector<std::byte> make_content(std::size_t size, unsigned seed) {
+    // 可压缩但不完全重复的内容
+    std::vector<std::byte> content(size);
+    unsigned state = seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        state = state * 1103515245u + 12345u;
+        content[i] = static_cast<std::byte>('a' + (state >> 16) % 8);
+    }
+    return content;
+}
+
+} // namespace
+
+TEST_CASE(ParallelDeflate, BlocksRoundTripThroughArchive) {
+    const auto pending = make_content(50000, 1);
+    const auto streamed = make_content(70001, 2);
+
+    auto archiver = OpenXmlArchiver::create_in_memory_writer();
+    archiver.set_deflate_threads(4, 4096);
+    async::sync_wait(archiver.add_file("pending.xml", pending));
+    async::sync_wait(archiver.add_file("empty.xml", {}));
+    {
+        EntryOutputStream out(archiver, "streamed.xml", 1000);
+        out.write(reinterpret_cast<const char*>(streamed.data()), 30000);
+        out.write(reinterpret_cast<const char*>(streamed.data()) + 30000, static_cast<std::streamsize>(streamed.size() - 30000));
+        out.close();
+    }
+    auto buffer = async::sync_wait(archiver.save_to_memory());
+
+    // 读取时会校验 CRC 和大小
+    auto reader = OpenXmlArchiver::open_from_memory(std::move(buffer));
+    ASSERT_TRUE(pending == async::sync_wait(reader.read_file("pending.xml")));
+    ASSERT_TRUE(streamed == async::sync_wait(reader.read_file("streamed.xml")));
+    auto empty = async::sync_wait(reader.open_entry_stream("empty.xml"));
+    ASSERT_TRUE(empty->get() == std::char_traits<char>::eof());
+}
+
+TEST_CASE(ParallelDeflate, WorkbookSaveWithConfig) {
+    const std::string file_path = "test_parallel_deflate.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (std::size_t row = 1; row <= 3000; ++row) {
+            sheet.cell(row, 1).value(static_cast<int>(row));
+            sheet.cell(row, 2).value("Name " + std::to_string(row % 50));
+        }
+        Config config;
+        config.thread_pool_size = 4;
+        workbook.save(file_path, config);
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(3000u, sheet.max_row());
+    ASSERT_EQ(1234, sheet.cell(1234, 1).as<int>());
+    ASSERT_EQ(std::string("Name 34"), sheet.cell(1234, 2).as<std::string>());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(ParallelDeflate, WriteProfileSelectsCompressionPerEntry) {
+    ASSERT_TRUE(match_entry_pattern("xl/worksheets/*", "xl/worksheets/sheet1.xml"));
+    ASSERT_TRUE(match_entry_pattern("*.png", "xl/media/image1.png"));
+    ASSERT_TRUE(match_entry_pattern("xl/?edia/*", "xl/media/a"));
+    ASSERT_FALSE(match_entry_pattern("xl/media/*", "xl/worksheets/sheet1.xml"));
+
+    WriteProfile profile;
+    profile.add("media/*", CompressionProfile::Store).add("*", CompressionProfile::Fastest);
+    ASSERT_TRUE(profile.profile_for("media/a.png") == CompressionProfile::Store);
+    ASSERT_TRUE(profile.profile_for("sheet.xml") == CompressionProfile::Fastest);
+
+    const auto content = make_content(200000, 3);
+    auto save_with = [&](const WriteProfile& write_profile, std::size_t threads) {
+        auto archiver = OpenXmlArchiver::create_in_memory_writer();
+        archiver.set_deflate_threads(threads, 16384);
+        archiver.set_write_profile(write_profile);
+        async::sync_wait(archiver.add_file("media/a.png", content));
+        {
+            EntryOutputStream out(archiver, "sheet.xml");
+            out.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+        }
+        auto buffer = async::sync_wait(archiver.save_to_memory());
+        const std::size_t size = buffer.size();
+
+        auto reader = OpenXmlArchiver::open_from_memory(std::move(buffer));
+        ASSERT_TRUE(content == async::sync_wait(reader.read_file("media/a.png")));
+        ASSERT_TRUE(content == async::sync_wait(reader.read_file("sheet.xml")));
+        return size;
+    };
+
+    for (std::size_t threads : {1u, 3u}) {
+        const std::size_t smallest = save_with(WriteProfile::uniform(CompressionProfile::Smallest), threads);
+        const std::size_t mixed = save_with(profile, threads);
+        const std::size_t stored = save_with(WriteProfile::uniform(CompressionProfile::Store), threads);
+        // 存储的条目不会变小，媒体条目存储后归档整体变大
+        ASSERT_TRUE(stored > 2 * content.size());
+        ASSERT_TRUE(mixed > content.size());
+        ASSERT_TRUE(smallest < mixed);
+    }
+}
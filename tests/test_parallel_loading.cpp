@@ -0,0 +1,138 @@
+/**
+ * @file test_parallel_loading.cpp
+ * @brief 并发组合器和并行打开模式测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/worksheet_impl.hpp"
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+using namespace tinakit;
+using namespace tinakit::test;
+
+namespace {
+
+// 两个任务必须同时运行才能都看到计数达到 2
+async::Task<bool> rendezvous(async::Executor& executor, std::atomic<int>& arrived) {
+    co_await async::schedule_on(executor);
+    arrived.fetch_add(1);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (arrived.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    co_return arrived.load() >= 2;
+}
+
+async::Task<int> square(async::Executor& executor, int value) {
+    co_await async::schedule_on(executor);
+    if (value < 0) {
+        throw TinaKitException("negative", "square");
+    }
+    co_return value * value;
+}
+
+} // namespace
+
+TEST_CASE(ParallelLoading, WhenAllRunsTasksConcurrently) {
+    async::ThreadPoolExecutor pool(2);
+    std::atomic<int> arrived{0};
+    auto [first, second] = async::sync_wait(async::when_all(rendezvous(pool, arrived), rendezvous(pool, arrived)));
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    std::vector<async::Task<int>> tasks;
+    for (int i = 0; i < 20; ++i) {
+        tasks.push_back(square(pool, i));
+    }
+    auto results = async::sync_wait(async::when_all(std::move(tasks)));
+    ASSERT_EQ(20u, results.size());
+    ASSERT_EQ(361, results[19]);
+
+    std::vector<async::Task<int>> failing;
+    failing.push_back(square(pool, 2));
+    failing.push_back(square(pool, -1));
+    ASSERT_THROWS(async::sync_wait(async::when_all(std::move(failing))), TinaKitException);
+}
+
+TEST_CASE(ParallelLoading, ParallelOpenMatchesLazyLoad) {
+    const std::string file_path = "test_parallel_loading.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        for (int s = 1; s <= 6; ++s) {
+            auto sheet = s == 1 ? workbook.active_sheet() : workbook.create_worksheet("Data" + std::to_string(s));
+            for (int row = 1; row <= 300; ++row) {
+                sheet.cell(row, 1).value(row * s);
+                sheet.cell(row, 2).value("Label " + std::to_string(row % 7) + " & <" + std::to_string(s) + ">");
+                sheet.cell(row, 3).value(row * 0.5);
+            }
+            sheet.cell(301, 1).formula("SUM(A1:A300)");
+        }
+        workbook.save(file_path);
+    }
+
+    auto lazy = excel::Workbook::load(file_path);
+    Config config;
+    config.thread_pool_size = 4;
+    auto parallel = excel::Workbook::load(file_path, config);
+
+    ASSERT_EQ(lazy.worksheet_count(), parallel.worksheet_count());
+    for (std::size_t s = 0; s < lazy.worksheet_count(); ++s) {
+        auto expected = lazy.get_worksheet(s);
+        auto actual = parallel.get_worksheet(s);
+        ASSERT_EQ(expected.max_row(), actual.max_row());
+        for (std::size_t row = 1; row <= 300; row += 37) {
+            ASSERT_EQ(expected.cell(row, 1).as<int>(), actual.cell(row, 1).as<int>());
+            ASSERT_EQ(expected.cell(row, 2).as<std::string>(), actual.cell(row, 2).as<std::string>());
+            ASSERT_EQ(expected.cell(row, 3).as<double>(), actual.cell(row, 3).as<double>());
+        }
+        ASSERT_EQ(expected.cell(301, 1).formula().value_or(""), actual.cell(301, 1).formula().value_or(""));
+    }
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(ParallelLoading, IntraSheetChunksPreserveRowOrder) {
+    std::string xml = "<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>";
+    for (int row = 1; row <= 2000; ++row) {
+        const std::string r = std::to_string(row);
+        xml += "<row r=\"" + r + "\"><c r=\"A" + r + "\"><v>" + r + "</v></c>"
+               "<c r=\"B" + r + "\" t=\"inlineStr\"><is><t>a&amp;" + r + "</t></is></c>"
+               "<c r=\"C" + r + "\" t=\"s\"><v>" + std::to_string(row % 7) + "</v></c></row>";
+    }
+    xml += "</sheetData></worksheet>";
+
+    async::ThreadPoolExecutor pool(4);
+    internal::PreparedSheet prepared;
+    async::sync_wait(internal::worksheet_impl::prepare(pool, xml, prepared, 4, 1024));
+
+    ASSERT_TRUE(prepared.scanned);
+    ASSERT_EQ(4u, prepared.chunks.size());
+
+    // 分块依次拼接后仍保持原始的单元格顺序
+    std::size_t index = 0;
+    for (const auto& chunk : prepared.chunks) {
+        ASSERT_FALSE(chunk.cells.empty());
+        for (const auto& cell : chunk.cells) {
+            const std::size_t row = index / 3 + 1;
+            ASSERT_EQ(row, cell.pos.row);
+            ASSERT_EQ(index % 3 + 1, cell.pos.column);
+            if (cell.pos.column == 1) {
+                ASSERT_TRUE(cell.view.kind == internal::CellKind::Integer);
+                ASSERT_EQ(static_cast<double>(row), cell.view.number);
+            } else if (cell.pos.column == 2) {
+                ASSERT_EQ("a&" + std::to_string(row), std::string(cell.view.text));
+            } else {
+                // 共享字符串索引留待合并时解析
+                ASSERT_TRUE(cell.shared_string);
+                ASSERT_EQ(std::to_string(row % 7), std::string(cell.view.text));
+            }
+            ++index;
+        }
+    }
+    ASSERT_EQ(6000u, index);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file test_row_stream.cpp
+ * @brief 流式行读取器测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include "tinakit/internal/worksheet_impl.hpp"
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::internal;
+using namespace tinakit::test;
+
+TEST_CASE(RowStream, ReadsAllRowsWithoutLoadingSheet) {
+    const std::string file_path = "test_row_stream.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (int row = 1; row <= 1500; ++row) {
+            sheet.cell(row, 1).value(row);
+            sheet.cell(row, 2).value("Item " + std::to_string(row));
+        }
+        sheet.cell(10, 4).value(2.5);
+        sheet.cell(10, 5).value(true);
+        workbook.save(file_path);
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    auto rows = workbook.active_sheet().stream_rows(4096);
+
+    std::size_t count = 0;
+    std::size_t previous_row = 0;
+    while (rows.next()) {
+        ++count;
+        ASSERT_TRUE(rows.row_index() > previous_row);
+        previous_row = rows.row_index();
+
+        auto cells = rows.cells();
+        ASSERT_TRUE(cells.size() >= 2);
+        ASSERT_EQ(1u, cells[0].column);
+        ASSERT_EQ(static_cast<int>(rows.row_index()), std::get<int>(cells[0].value));
+        ASSERT_EQ("Item " + std::to_string(rows.row_index()), std::get<std::string>(cells[1].value));
+
+        if (rows.row_index() == 10) {
+            ASSERT_EQ(4u, cells.size());
+            ASSERT_EQ(4u, cells[2].column);
+            ASSERT_EQ(2.5, std::get<double>(cells[2].value));
+            ASSERT_TRUE(std::get<bool>(cells[3].value));
+        }
+    }
+    ASSERT_EQ(1500u, count);
+    ASSERT_EQ(1500u, rows.rows_read());
+    ASSERT_FALSE(rows.next());
+
+    // 流式读取不应加载工作表
+    ASSERT_TRUE(workbook.impl()->worksheet_load_state("Sheet1") == LoadState::NotLoaded);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(RowStream, CoexistsWithLazyLoadingAndNewSheets) {
+    const std::string file_path = "test_row_stream_mixed.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        workbook.active_sheet().cell(1, 1).value("a");
+        workbook.active_sheet().cell(2, 1).value("b");
+        auto second = workbook.create_worksheet("Second");
+        second.cell(1, 1).value(7);
+        workbook.save(file_path);
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    auto rows = workbook.get_worksheet("Sheet1").stream_rows();
+    ASSERT_TRUE(rows.next());
+
+    // 流打开期间按需加载其他工作表不会打乱流的读取位置
+    ASSERT_EQ(7, workbook.get_worksheet("Second").cell(1, 1).as<int>());
+    ASSERT_TRUE(rows.next());
+    ASSERT_EQ(std::string("b"), std::get<std::string>(rows.cells()[0].value));
+    ASSERT_FALSE(rows.next());
+
+    auto fresh = workbook.create_worksheet("Fresh");
+    fresh.cell(1, 1).value(1);
+    ASSERT_FALSE(fresh.stream_rows().next());
+    ASSERT_THROWS(excel::RowStream(workbook.impl(), "Missing"), WorksheetNotFoundException);
+
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_row_writer.cpp
+ * @brief 流式行写入器测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include <filesystem>
+#include <vector>
+
+using namespace tinakit;
+using namespace tinakit::test;
+
+TEST_CASE(RowWriter, StreamedSheetRoundTrip) {
+    const std::string file_path = "test_row_writer.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto writer = workbook.create_streaming_worksheet("Report");
+        writer.append_row({std::string("ID"), std::string("Name"), std::string("Amount"), std::string("Active")});
+        for (int i = 1; i <= 3000; ++i) {
+            writer.append_row({i, "Customer <" + std::to_string(i) + ">", i * 0.1, i % 2 == 0});
+        }
+        writer.append_row({1, std::monostate{}, 3});
+        ASSERT_EQ(3002u, writer.rows_written());
+        writer.close();
+        ASSERT_FALSE(writer.is_open());
+
+        // 普通工作表仍可以和流式工作表共存
+        auto notes = workbook.create_worksheet("Notes");
+        notes.cell(1, 1).value("generated");
+        workbook.save(file_path);
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    auto report = workbook.get_worksheet("Report");
+    ASSERT_EQ(std::string("Name"), report.cell(1, 2).as<std::string>());
+    ASSERT_EQ(1500, report.cell(1501, 1).as<int>());
+    ASSERT_EQ(std::string("Customer <1500>"), report.cell(1501, 2).as<std::string>());
+    ASSERT_EQ(150.0, report.cell(1501, 3).as<double>());
+    ASSERT_TRUE(report.cell(1501, 4).as<bool>());
+    ASSERT_TRUE(report.cell(3002, 2).empty());
+    ASSERT_EQ(3, report.cell(3002, 3).as<int>());
+    ASSERT_EQ(std::string("generated"), workbook.get_worksheet("Notes").cell(1, 1).as<std::string>());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(RowWriter, WritesThroughToOutputFile) {
+    const std::string file_path = "test_row_writer_direct.xlsx";
+    {
+        // 指定保存路径的新工作簿边写边落盘，归档不在内存中组装
+        auto workbook = excel::Workbook::create(file_path);
+        auto writer = workbook.create_streaming_worksheet("Report");
+        ASSERT_TRUE(workbook.impl()->get_archiver()->writes_through());
+        for (int i = 1; i <= 1000; ++i) {
+            writer.append_row({i, "Row " + std::to_string(i)});
+        }
+        writer.close();
+        workbook.create_worksheet("Notes").cell(1, 1).value("generated");
+
+        // 条目已经写入目标文件旁的临时文件，不能另存到其他路径
+        ASSERT_THROWS(workbook.save("test_row_writer_other.xlsx"), TinaKitException);
+        ASSERT_FALSE(std::filesystem::exists("test_row_writer_other.xlsx"));
+        workbook.save();
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    ASSERT_EQ(std::string("Row 1000"), workbook.get_worksheet("Report").cell(1000, 2).as<std::string>());
+    ASSERT_EQ(std::string("generated"), workbook.get_worksheet("Notes").cell(1, 1).as<std::string>());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(RowWriter, RejectsRowsBeyondExcelLimits) {
+    auto workbook = excel::Workbook::create();
+    auto writer = workbook.create_streaming_worksheet("Limits");
+
+    // 超过 16384 列的行整行拒绝，不影响后续写入
+    std::vector<excel::Cell::CellValue> wide(16385, 1);
+    ASSERT_THROWS(writer.append_row(wide), InvalidCellAddressException);
+    wide.pop_back();
+    writer.append_row(wide);
+    ASSERT_EQ(1u, writer.rows_written());
+
+    // 写满 1048576 行后不能再追加
+    const std::vector<excel::Cell::CellValue> empty;
+    while (writer.rows_written() < 1048576) {
+        writer.append_row(empty);
+    }
+    ASSERT_THROWS(writer.append_row({1}), InvalidCellAddressException);
+    ASSERT_EQ(1048576u, writer.rows_written());
+    writer.close();
+}
+
+TEST_CASE(RowWriter, OpenWriterBlocksSaveAndSecondWriter) {
+    const std::string file_path = "test_row_writer_open.xlsx";
+    auto workbook = excel::Workbook::create();
+    auto writer = workbook.create_streaming_worksheet("First");
+    writer.append_row({1, 2, 3});
+
+    ASSERT_THROWS(workbook.save(file_path), TinaKitException);
+    ASSERT_THROWS(workbook.create_streaming_worksheet("Second"), TinaKitException);
+    ASSERT_FALSE(workbook.impl()->has_worksheet("Second"));
+
+    writer.close();
+    ASSERT_THROWS(writer.append_row({4}), TinaKitException);
+    ASSERT_NO_THROW(workbook.save(file_path));
+
+    auto reloaded = excel::Workbook::load(file_path);
+    ASSERT_EQ(3, reloaded.get_worksheet("First").cell(1, 3).as<int>());
+
+    std::filesystem::remove(file_path);
+}
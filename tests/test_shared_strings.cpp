@@ -0,0 +1,249 @@
+/**
+ * @file test_shared_strings.cpp
+ * @brief 共享字符串表测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/excel/shared_strings.hpp"
+#include "tinakit/core/openxml_archiver.hpp"
+#include "tinakit/internal/sheet_data_scanner.hpp"
+#include "tinakit/internal/workbook_impl.hpp"
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::internal;
+using namespace tinakit::test;
+
+TEST_CASE(SharedStrings, LoadsLazilyInOnePass) {
+    const std::string xml =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+        "<!-- generated -->"
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" count=\"6\" uniqueCount=\"5\">\n"
+        "  <si><t>plain</t></si>\n"
+        "  <si><r><rPr><b/></rPr><t>rich</t></r><r><t xml:space=\"preserve\"> &amp; text</t></r>"
+        "<rPh sb=\"0\" eb=\"1\"><t>ignored</t></rPh></si>\n"
+        "  <si/>\n"
+        "  <si><t>&#x4E2D;&#25991;</t></si>\n"
+        "  <si><t>plain</t></si>\n"
+        "</sst>";
+
+    std::vector<std::string_view> items;
+    ASSERT_TRUE(scan_shared_string_items(xml, items));
+    ASSERT_EQ(5u, items.size());
+    ASSERT_TRUE(items[2].empty());
+
+    excel::SharedStrings strings;
+    strings.load_from_xml(xml);
+    ASSERT_EQ(5u, strings.count());
+    ASSERT_EQ(std::string("rich & text"), strings.get_string(1));
+    ASSERT_EQ(std::string(""), strings.get_string(2));
+    ASSERT_EQ(std::string("\xE4\xB8\xAD\xE6\x96\x87"), strings.get_string(3));
+
+    // 反向映射在编辑时才建立，重复字符串对应第一次出现的索引
+    ASSERT_EQ(0u, strings.get_index("plain").value());
+    ASSERT_EQ(0u, strings.add_string("plain"));
+    ASSERT_EQ(5u, strings.add_string("new"));
+    ASSERT_EQ(std::string("plain"), strings.get_string(4));
+}
+
+TEST_CASE(SharedStrings, UnsupportedSyntaxFallsBackToParser) {
+    // <si> 内的 CDATA 不属于扫描器支持的语法
+    const std::string xml =
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<si><t><![CDATA[a<b]]></t></si><si><t>c</t></si></sst>";
+
+    std::vector<std::string_view> items;
+    ASSERT_FALSE(scan_shared_string_items(xml, items));
+
+    excel::SharedStrings strings;
+    strings.load_from_xml(xml);
+    ASSERT_EQ(2u, strings.count());
+    ASSERT_EQ(std::string("a<b"), strings.get_string(0));
+    ASSERT_EQ(std::string("c"), strings.get_string(1));
+
+    // 扫描通过但无法快速解码的条目在首次访问时由通用解析器解码，不会返回原始标记
+    const std::string nested =
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<si><t>a<b/>b</t></si><si><t>c</t></si><si><t>&nbsp;</t></si></sst>";
+    ASSERT_TRUE(scan_shared_string_items(nested, items));
+    excel::SharedStrings lazy;
+    lazy.load_from_xml(nested);
+    ASSERT_EQ(std::string("ab"), lazy.get_string(0));
+    ASSERT_THROWS(lazy.get_string(2), ParseException);
+    ASSERT_EQ(std::string("c"), lazy.get_string(1));
+}
+
+TEST_CASE(SharedStrings, KeepsWhitespaceOnBothPaths) {
+    const std::string items =
+        "<si><t xml:space=\"preserve\">  padded\t</t></si>"
+        "<si><t>\n</t></si>"
+        "<si>\n  <r><t xml:space=\"preserve\">a </t></r>\n  <r><t>b</t></r>\n"
+        "  <rPh sb=\"0\" eb=\"1\"><t>ignored</t></rPh>\n</si>";
+    const std::string open = "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">";
+
+    // 快速路径和通用解析器（CDATA 触发回退）都保留 <t> 文本的首尾空白，忽略元素之间的空白
+    excel::SharedStrings fast;
+    fast.load_from_xml(open + items + "</sst>");
+    excel::SharedStrings parsed;
+    parsed.load_from_xml(open + items + "<si><t><![CDATA[ x ]]></t></si></sst>");
+    for (const auto* strings : {&fast, &parsed}) {
+        ASSERT_EQ(std::string("  padded\t"), strings->get_string(0));
+        ASSERT_EQ(std::string("\n"), strings->get_string(1));
+        ASSERT_EQ(std::string("a b"), strings->get_string(2));
+    }
+    ASSERT_EQ(std::string(" x "), parsed.get_string(3));
+}
+
+TEST_CASE(SharedStrings, LoadingSheetKeepsStringsUndecoded) {
+    const std::string file_path = "test_shared_strings_lazy.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value("Alpha");
+        sheet.cell(2, 1).value("Alpha");
+        sheet.cell(3, 1).value("Beta");
+        sheet.cell(4, 1).value("Beta");
+        sheet.cell(5, 1).value(5);
+        workbook.save(file_path);
+    }
+
+    // 加载单元格只记录共享字符串索引，文本在读取单元格时才解码
+    auto workbook = excel::Workbook::load(file_path);
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(5, sheet.cell(5, 1).as<int>());
+    const auto& strings = workbook.impl()->shared_strings();
+    ASSERT_EQ(2u, strings.count());
+    ASSERT_FALSE(strings.is_decoded(0));
+    ASSERT_FALSE(strings.is_decoded(1));
+
+    ASSERT_EQ(std::string("Beta"), sheet.cell(4, 1).as<std::string>());
+    ASSERT_FALSE(strings.is_decoded(0));
+    ASSERT_TRUE(strings.is_decoded(1));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(SharedStrings, CompactsAndKeepsRichText) {
+    const std::string xml =
+        "<sst xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+        "<si><t>Pending</t></si>"
+        "<si><r><rPr><b/></rPr><t>Bold</t></r><r><t xml:space=\"preserve\"> text</t></r></si>"
+        "<si><t>Pending</t></si>"
+        "<si><t>Unused</t></si></sst>";
+    excel::SharedStrings strings;
+    strings.load_from_xml(xml);
+
+    // 全部被引用时不压缩
+    ASSERT_FALSE(strings.compact({true, true, true, true}).has_value());
+
+    // 删除未引用的字符串，合并重复的纯文本；富文本原样保留
+    auto mapping = strings.compact({true, true, true, false});
+    ASSERT_TRUE(mapping.has_value());
+    ASSERT_EQ(0u, (*mapping)[0]);
+    ASSERT_EQ(1u, (*mapping)[1]);
+    ASSERT_EQ(0u, (*mapping)[2]);
+    ASSERT_EQ(excel::SharedStrings::INVALID_INDEX, (*mapping)[3]);
+    ASSERT_EQ(2u, strings.count());
+    ASSERT_EQ(std::string("Bold text"), strings.get_string(1));
+
+    const auto generated = strings.generate_xml(5);
+    ASSERT_TRUE(generated.find("count=\"5\" uniqueCount=\"2\"") != std::string::npos);
+    ASSERT_TRUE(generated.find("<si><r><rPr><b/></rPr><t>Bold</t></r>") != std::string::npos);
+
+    // 富文本不参与按文本查找
+    ASSERT_EQ(2u, strings.add_string("Bold text"));
+
+    // 保存时删除被覆盖的单元格留下的字符串，单元格索引随之重新编号
+    const std::string file_path = "test_shared_strings_compact.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value("Obsolete status");
+        sheet.cell(1, 2).value("Obsolete status");
+        sheet.cell(2, 1).value("Completed status");
+        sheet.cell(3, 1).value("Completed status");
+        workbook.save(file_path);
+    }
+    {
+        auto workbook = excel::Workbook::load(file_path);
+        ASSERT_EQ(2u, workbook.impl()->shared_strings().count());
+        workbook.active_sheet().cell(1, 1).value(1);
+        workbook.active_sheet().cell(1, 2).value(2);
+        workbook.save(file_path);
+    }
+    auto workbook = excel::Workbook::load(file_path);
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(1u, workbook.impl()->shared_strings().count());
+    ASSERT_EQ(std::string("Completed status"), sheet.cell(3, 1).as<std::string>());
+    ASSERT_EQ(1, sheet.cell(1, 1).as<int>());
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(SharedStrings, SharesOnlyRepeatedStrings) {
+    const std::string file_path = "test_shared_strings_policy.xlsx";
+    auto workbook = excel::Workbook::create();
+    auto sheet = workbook.active_sheet();
+    for (std::size_t row = 1; row <= 3; ++row) {
+        sheet.cell(row, 1).value("Completed");
+    }
+    sheet.cell(4, 1).value("Single note");
+    sheet.cell(5, 1).value("Single note").formula("\"Single note\"");
+
+    // 默认只共享出现两次及以上的字符串，公式的缓存结果不计数
+    auto shared_count = [&](std::size_t min_repeats) {
+        Config config;
+        config.shared_string_policy.min_repeats = min_repeats;
+        // 未修改的工作表会原样复制，先修改一个单元格
+        sheet.cell(6, 1).value(static_cast<int>(min_repeats));
+        workbook.save(file_path, config);
+        auto loaded = excel::Workbook::load(file_path);
+        auto loaded_sheet = loaded.active_sheet();
+        ASSERT_EQ(std::string("Completed"), loaded_sheet.cell(3, 1).as<std::string>());
+        ASSERT_EQ(std::string("Single note"), loaded_sheet.cell(4, 1).as<std::string>());
+        return loaded.impl()->shared_strings().count();
+    };
+    ASSERT_EQ(1u, shared_count(2));
+    ASSERT_EQ(2u, shared_count(1));
+    ASSERT_EQ(0u, shared_count(0));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST_CASE(SharedStrings, InlineStringsPreserveWhitespace) {
+    const std::string file_path = "test_shared_strings_inline.xlsx";
+    auto sheet_xml = [&file_path](const std::string& part) {
+        auto archiver = async::sync_wait(core::OpenXmlArchiver::open_from_file(file_path));
+        const auto bytes = async::sync_wait(archiver.read_file(part));
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+
+    // 只出现一次的字符串写为内联字符串，首尾空白与共享字符串一样标记 xml:space="preserve"
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        sheet.cell(1, 1).value(" padded ");
+        sheet.cell(2, 1).value("plain");
+        workbook.save(file_path);
+    }
+    auto xml = sheet_xml("xl/worksheets/sheet1.xml");
+    ASSERT_TRUE(xml.find("<t xml:space=\"preserve\"> padded </t>") != std::string::npos);
+    ASSERT_TRUE(xml.find("<t>plain</t>") != std::string::npos);
+    ASSERT_EQ(std::string(" padded "), excel::Workbook::load(file_path).active_sheet().cell(1, 1).as<std::string>());
+
+    {
+        auto workbook = excel::Workbook::create();
+        auto writer = workbook.create_streaming_worksheet("Report");
+        writer.append_row({std::string("\tindented"), std::string("plain")});
+        writer.close();
+        workbook.save(file_path);
+    }
+    xml = sheet_xml("xl/worksheets/sheet1.xml");
+    ASSERT_TRUE(xml.find("<t xml:space=\"preserve\">\tindented</t>") != std::string::npos);
+    ASSERT_TRUE(xml.find("<t>plain</t>") != std::string::npos);
+
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_sheet_data_scanner.cpp
+ * @brief sheetData 快速扫描器测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/tinakit.hpp"
+#include "tinakit/internal/sheet_data_scanner.hpp"
+#include <filesystem>
+
+using namespace tinakit;
+using namespace tinakit::internal;
+using namespace tinakit::test;
+
+TEST_CASE(SheetDataScanner, ScansCellsAndDecodesText) {
+    const std::string xml =
+        "<x:row r=\"3\" spans=\"1:3\">"
+        "<x:c r=\"A3\" s=\"2\"><x:v>42</x:v></x:c>"
+        "<x:c t=\"str\"><x:f>A3&amp;\"&gt;\"</x:f><x:v>a &lt;b&gt; &#x4E2D;&#25991;</x:v></x:c>"
+        "<x:c r=\"D3\" t=\"inlineStr\"><x:is><x:r><x:rPr><x:b/></x:rPr><x:t>Hello</x:t></x:r>"
+        "<x:r><x:t xml:space=\"preserve\"> World</x:t></x:r><x:rPh sb=\"0\" eb=\"1\"><x:t>ignored</x:t></x:rPh></x:is></x:c>"
+        "</x:row>"
+        "<x:row><x:c r=\"A4\" s=\"1\"/></x:row>"
+        "</x:sheetData><x:mergeCells/>";
+
+    SheetDataScanner scanner(xml);
+    ScannedCell cell;
+
+    ASSERT_TRUE(scanner.next(cell));
+    ASSERT_EQ(3u, cell.row);
+    ASSERT_EQ(1u, cell.column);
+    ASSERT_EQ(2u, cell.style_id);
+    ASSERT_EQ(std::string("42"), std::string(cell.text));
+    ASSERT_FALSE(cell.has_formula);
+
+    // 没有 r 属性的单元格紧跟上一列
+    ASSERT_TRUE(scanner.next(cell));
+    ASSERT_EQ(2u, cell.column);
+    ASSERT_EQ(std::string("str"), std::string(cell.type));
+    ASSERT_TRUE(cell.has_formula);
+    ASSERT_EQ(std::string("A3&\">\""), std::string(cell.formula));
+    ASSERT_EQ(std::string("a <b> \xE4\xB8\xAD\xE6\x96\x87"), std::string(cell.text));
+
+    ASSERT_TRUE(scanner.next(cell));
+    ASSERT_EQ(4u, cell.column);
+    ASSERT_EQ(std::string("Hello World"), std::string(cell.text));
+
+    // 没有 r 属性的行沿用上一行加一
+    ASSERT_TRUE(scanner.next(cell));
+    ASSERT_EQ(4u, cell.row);
+    ASSERT_EQ(1u, cell.style_id);
+    ASSERT_TRUE(cell.text.empty());
+
+    ASSERT_FALSE(scanner.next(cell));
+    ASSERT_FALSE(scanner.failed());
+}
+
+TEST_CASE(SheetDataScanner, IncrementalFeedMatchesWholeInput) {
+    const std::string xml =
+        "<row r=\"1\"><c r=\"A1\" s=\"3\"><v>1.5</v></c>"
+        "<c r=\"B1\" t=\"s\"><v>12</v></c>"
+        "<c r=\"C1\" t=\"inlineStr\"><is><t>a &amp; b</t></is></c></row>"
+        "<row r=\"2\"><c r=\"AB2\"><f>SUM(A1:A9)</f><v>7</v></c></row>"
+        "</sheetData><mergeCells count=\"0\"/>";
+
+    auto collect = [](SheetDataScanner& scanner, std::vector<std::string>& out) {
+        ScannedCell cell;
+        while (scanner.next(cell)) {
+            out.push_back(std::to_string(cell.row) + ":" + std::to_string(cell.column) + ":" +
+                          std::to_string(cell.style_id) + ":" + std::string(cell.type) + ":" +
+                          std::string(cell.formula) + ":" + std::string(cell.text));
+        }
+    };
+
+    std::vector<std::string> expected;
+    SheetDataScanner whole(xml);
+    collect(whole, expected);
+    ASSERT_EQ(4u, expected.size());
+
+    // 任意切分位置都必须得到相同的结果
+    for (std::size_t chunk_size = 1; chunk_size <= 17; ++chunk_size) {
+        SheetDataScanner scanner;
+        std::vector<std::string> cells;
+        std::size_t offset = 0;
+        while (true) {
+            collect(scanner, cells);
+            if (!scanner.needs_input()) {
+                break;
+            }
+            if (offset < xml.size()) {
+                scanner.feed(std::string_view(xml).substr(offset, chunk_size));
+                offset += chunk_size;
+            } else {
+                scanner.finish_input();
+            }
+        }
+        ASSERT_FALSE(scanner.failed());
+        ASSERT_TRUE(scanner.ended());
+        ASSERT_TRUE(expected == cells);
+        std::string rest(scanner.remaining());
+        rest.append(std::string_view(xml).substr(std::min(offset, xml.size())));
+        ASSERT_EQ(std::string("</sheetData><mergeCells count=\"0\"/>"), rest);
+    }
+
+    // 输入在 sheetData 结束前中断时不算正常结束
+    SheetDataScanner truncated;
+    truncated.feed(std::string_view(xml).substr(0, 40));
+    truncated.finish_input();
+    std::vector<std::string> partial;
+    collect(truncated, partial);
+    ASSERT_FALSE(truncated.ended());
+}
+
+TEST_CASE(SheetDataScanner, UnsupportedSyntaxFails) {
+    ScannedCell cell;
+
+    SheetDataScanner cdata("<row r=\"1\"><c r=\"A1\" t=\"str\"><v><![CDATA[x]]></v></c></row>");
+    ASSERT_FALSE(cdata.next(cell));
+    ASSERT_TRUE(cdata.failed());
+
+    SheetDataScanner entity("<row r=\"1\"><c r=\"A1\" t=\"str\"><v>&nbsp;</v></c></row>");
+    ASSERT_FALSE(entity.next(cell));
+    ASSERT_TRUE(entity.failed());
+
+    SheetDataScanner truncated("<row r=\"1\"><c r=\"A1\"><v>1</v>");
+    ASSERT_FALSE(truncated.next(cell));
+    ASSERT_TRUE(truncated.failed());
+
+    // 超出 Excel 行数上限的行号交给通用解析器报错
+    SheetDataScanner huge_row("<row r=\"4000000000\"><c><v>1</v></c></row>");
+    ASSERT_FALSE(huge_row.next(cell));
+    ASSERT_TRUE(huge_row.failed());
+    SheetDataScanner wide_column("<row r=\"1\"><c r=\"XFE1\"><v>1</v></c></row>");
+    ASSERT_FALSE(wide_column.next(cell));
+    ASSERT_TRUE(wide_column.failed());
+    SheetDataScanner long_column("<row r=\"1\"><c r=\"ZZZZZZZZZZZZZZZZZZZZ1\"><v>1</v></c></row>");
+    ASSERT_FALSE(long_column.next(cell));
+    ASSERT_TRUE(long_column.failed());
+}
+
+TEST_CASE(SheetDataScanner, LoadedWorkbookRoundTrip) {
+    const std::string file_path = "test_sheet_data_scanner.xlsx";
+    {
+        auto workbook = excel::Workbook::create();
+        auto sheet = workbook.active_sheet();
+        for (std::size_t row = 1; row <= 600; ++row) {
+            sheet.cell(row, 1).value(static_cast<int>(row));
+            sheet.cell(row, 2).value("Item <" + std::to_string(row) + "> & more");
+            sheet.cell(row, 3).value(row * 0.5);
+            sheet.cell(row, 4).value(row % 3 == 0);
+        }
+        sheet.cell(601, 1).formula("SUM(A1:A600)");
+        workbook.save(file_path);
+    }
+
+    auto workbook = excel::Workbook::load(file_path);
+    auto sheet = workbook.active_sheet();
+    ASSERT_EQ(300, sheet.cell(300, 1).as<int>());
+    ASSERT_EQ(std::string("Item <300> & more"), sheet.cell(300, 2).as<std::string>());
+    ASSERT_EQ(150.0, sheet.cell(300, 3).as<double>());
+    ASSERT_TRUE(sheet.cell(300, 4).as<bool>());
+    ASSERT_EQ(std::string("Item <600> & more"), sheet.cell(600, 2).as<std::string>());
+    ASSERT_EQ(std::string("SUM(A1:A600)"), sheet.cell(601, 1).formula().value_or(""));
+    ASSERT_EQ(601u, sheet.max_row());
+
+    std::filesystem::remove(file_path);
+}
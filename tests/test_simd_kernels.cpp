@@ -0,0 +1,75 @@
+/**
+ * @file test_simd_kernels.cpp
+ * @brief XML 扫描 SIMD 内核测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include "tinakit/core/xml_parser.hpp"
+#include <random>
+
+using namespace tinakit;
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+namespace {
+
+const simd::Level kAllLevels[] = {simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2};
+
+} // namespace
+
+TEST_CASE(SimdKernels, FindAnyMatchesReferenceOnEveryLevel) {
+    // 覆盖向量块边界和尾部：各种长度、各种起始位置
+    std::mt19937 rng(42);
+    const std::string alphabet = "abc <>&\"xyz\xE4\xB8\xAD";
+    std::string text(300, ' ');
+    for (auto& c : text) {
+        c = alphabet[rng() % alphabet.size()];
+    }
+
+    const std::string_view needle_sets[] = {"<", "&\r", ">\"'", "<>&\"", "<>&\"x"};
+    for (auto level : kAllLevels) {
+        simd::set_level(level);
+        for (std::size_t length = 0; length <= 80; ++length) {
+            const std::string_view view(text.data(), length);
+            for (auto needles : needle_sets) {
+                for (std::size_t pos = 0; pos <= length; pos += 7) {
+                    ASSERT_EQ(view.find_first_of(needles, pos), simd::find_any(view, needles, pos));
+                }
+            }
+        }
+        ASSERT_EQ(text.find_first_of("<", 100), simd::find_any(text, "<", 100));
+    }
+    simd::set_level(simd::detected_level());
+    ASSERT_TRUE(simd::detected_level() == simd::active_level());
+}
+
+TEST_CASE(SimdKernels, Utf8ValidationOnEveryLevel) {
+    const std::string ascii(100, 'a');
+    for (auto level : kAllLevels) {
+        simd::set_level(level);
+
+        ASSERT_TRUE(simd::validate_utf8(""));
+        ASSERT_TRUE(simd::validate_utf8(ascii + "\xE4\xB8\xAD\xE6\x96\x87" + ascii + "\xF0\x9F\x98\x80"));
+        ASSERT_TRUE(simd::validate_utf8("\xC2\xA9\xED\x9F\xBF\xF4\x8F\xBF\xBF"));
+
+        // 非法字节的偏移位于 ASCII 块之后
+        ASSERT_EQ(ascii.size(), simd::find_invalid_utf8(ascii + "\xFF" + ascii));
+        ASSERT_EQ(ascii.size(), simd::find_invalid_utf8(ascii + "\xC0\xAF"));          // 过长编码
+        ASSERT_EQ(ascii.size(), simd::find_invalid_utf8(ascii + "\xED\xA0\x80"));      // 代理项
+        ASSERT_EQ(ascii.size(), simd::find_invalid_utf8(ascii + "\xF4\x90\x80\x80"));  // 超出 U+10FFFF
+        ASSERT_EQ(ascii.size() + 3, simd::find_invalid_utf8(ascii + "\xE4\xB8\xAD\xE4\xB8")); // 截断
+    }
+    simd::set_level(simd::detected_level());
+}
+
+TEST_CASE(SimdKernels, BufferParserRejectsInvalidUtf8) {
+    const std::string valid = "<root><item>\xE4\xB8\xAD</item></root>";
+    XmlParser parser(std::string_view(valid), "valid.xml");
+    ASSERT_EQ(std::string("\xE4\xB8\xAD"), parser.get_element_text("item"));
+
+    const std::string invalid = "<root><item>\xFF</item></root>";
+    ASSERT_THROWS(XmlParser(std::string_view(invalid), "invalid.xml"), ParseException);
+}
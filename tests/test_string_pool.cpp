@@ -0,0 +1,52 @@
+/**
+ * @file test_string_pool.cpp
+ * @brief 字符串池测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+TEST_CASE(StringPool, SharedAcrossThreads) {
+    StringPool pool;
+    const std::string long_text(300, 'x');
+    const auto first = pool.intern(long_text);
+    const auto first_view = pool.get_string(first);
+
+    // 多个线程同时驻留部分重叠的字符串，相同内容必须得到相同的 ID
+    constexpr int THREADS = 4;
+    constexpr int STRINGS = 2000;
+    std::vector<std::vector<StringPool::StringId>> ids(THREADS);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([&pool, &ids, t] {
+            for (int i = 0; i < STRINGS; ++i) {
+                ids[t].push_back(pool.intern("value " + std::to_string(i % (STRINGS / 2) + t * 100)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    ASSERT_EQ(std::size_t(STRINGS / 2 + (THREADS - 1) * 100 + 1), pool.size());
+    for (int t = 0; t < THREADS; ++t) {
+        for (int i = 0; i < STRINGS; ++i) {
+            const std::string expected = "value " + std::to_string(i % (STRINGS / 2) + t * 100);
+            ASSERT_EQ(expected, std::string(pool.get_string(ids[t][i])));
+            ASSERT_EQ(ids[t][i], pool.intern(expected));
+        }
+    }
+
+    // 已驻留的字符串不会移动
+    ASSERT_TRUE(pool.get_string(first).data() == first_view.data());
+    ASSERT_TRUE(pool.get_string(StringPool::INVALID_ID).empty());
+    ASSERT_EQ(StringPool::INVALID_ID, pool.intern(""));
+}
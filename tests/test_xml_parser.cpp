@@ -0,0 +1,73 @@
+/**
+ * @file test_xml_parser.cpp
+ * @brief XML 解析器和解析分配区测试
+ * @author TinaKit Team
+ * @date 2025-6-21
+ */
+
+#include "test_framework.hpp"
+#include "tinakit/core/performance_optimizations.hpp"
+#include "tinakit/core/xml_parser.hpp"
+#include <vector>
+
+using namespace tinakit::core;
+using namespace tinakit::test;
+
+TEST_CASE(XmlParser, ParseArenaCopiesAndReleases) {
+    ParseArena arena;
+    const std::string large(ParseArena::INLINE_SIZE * 2, 'x');
+    auto first = arena.copy("abc");
+    auto second = arena.copy(large);
+    ASSERT_EQ(std::string("abc"), std::string(first));
+    ASSERT_EQ(large, std::string(second));
+    ASSERT_TRUE(arena.copy("").empty());
+
+    // 释放后从内部缓冲区重新开始分配
+    arena.release();
+    auto again = arena.copy("abc");
+    ASSERT_TRUE(again.data() == first.data());
+}
+
+TEST_CASE(XmlParser, ViewsAndNamespacedHandlers) {
+    const std::string xml =
+        "<root xmlns=\"urn:test\">"
+        "<c r=\"A1\" t=\"s\"><v>1</v></c>"
+        "<c r=\"B1\"><f>SUM(A1)</f><v>2</v></c>"
+        "<other>x<![CDATA[y]]>z</other>"
+        "</root>";
+    XmlParser parser(std::string_view(xml), "test.xml");
+
+    std::vector<std::string> seen;
+    std::map<std::pair<std::string, std::string>, std::function<void(XmlParser::iterator&)>> handlers = {
+        {{"urn:test", "c"}, [&](XmlParser::iterator& it) {
+            auto ref = it.attribute_view("r");
+            auto type = it.attribute_view("t");
+            ASSERT_TRUE(ref.has_value());
+            std::string record(*ref);
+            record += type ? std::string(*type) : std::string("-");
+            ++it;
+            while (!(it.is_end_element() && it.name() == "c")) {
+                if (it.is_start_element()) {
+                    // 属性视图在读取子元素后仍然有效
+                    record += ":" + std::string(it.text_view()) + "@" + std::string(*ref);
+                    continue;
+                }
+                ++it;
+            }
+            seen.push_back(record);
+        }},
+        {{"urn:test", "other"}, [&](XmlParser::iterator& it) {
+            ASSERT_FALSE(it.attribute_view("missing").has_value());
+            seen.push_back(std::string(it.text_view()));
+        }},
+        {{"", "c"}, [&](XmlParser::iterator&) {
+            seen.push_back("wrong namespace");
+        }}
+    };
+    parser.parse_multiple_elements_ns(handlers);
+
+    ASSERT_EQ(3u, seen.size());
+    ASSERT_EQ(std::string("A1s:1@A1"), seen[0]);
+    ASSERT_EQ(std::string("B1-:SUM(A1)@B1:2@B1"), seen[1]);
+    ASSERT_EQ(std::string("xyz"), seen[2]);
+}